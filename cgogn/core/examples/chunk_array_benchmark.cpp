@@ -0,0 +1,116 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cgogn/core/types/container/attribute_container.h>
+#include <cgogn/core/types/container/chunk_array.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+using namespace cgogn;
+
+using Vec3 = std::array<float64, 3>;
+
+template <typename T>
+using ChunkArray256 = ChunkArrayT<T, 256u>;
+template <typename T>
+using ChunkArray4096 = ChunkArrayT<T, 4096u>;
+template <typename T>
+using ChunkArray65536 = ChunkArrayT<T, 65536u>;
+
+const uint32 NB_ELEMENTS = 4000000u;
+const uint32 NB_ITERATIONS = 10u;
+
+template <template <typename> class AttributeT>
+void benchmark(const std::string& name)
+{
+	AttributeContainerT<AttributeT> container;
+	auto position = container.template add_attribute<Vec3>("position");
+
+	container.new_indices(NB_ELEMENTS);
+	// release one element out of 8 to get a sparse container
+	for (uint32 i = 0u; i < NB_ELEMENTS; i += 8u)
+		container.release_index(i);
+
+	for (auto it = position->begin(), end = position->end(); it != end; ++it)
+	{
+		const float64 v = float64(it.index());
+		*it = { v, v * 0.5, v * 0.25 };
+	}
+
+	// traversal through the attribute iterator
+	float64 sum = 0.0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (uint32 k = 0u; k < NB_ITERATIONS; ++k)
+	{
+		for (const Vec3& p : *position)
+			sum += p[0] + p[1] + p[2];
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<float64> iterator_time = end - start;
+
+	// traversal through the used indices
+	start = std::chrono::high_resolution_clock::now();
+	for (uint32 k = 0u; k < NB_ITERATIONS; ++k)
+	{
+		container.foreach_live_index([&] (uint32 i) -> bool
+		{
+			const Vec3& p = (*position)[i];
+			sum += p[0] + p[1] + p[2];
+			return true;
+		});
+	}
+	end = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<float64> index_time = end - start;
+
+	const float64 nb_accesses = float64(NB_ITERATIONS) * container.nb_elements();
+	std::cout << std::setw(18) << name
+			  << " | iterator: " << std::setw(8) << std::setprecision(4) << nb_accesses / iterator_time.count() * 1e-6 << " M/s"
+			  << " | index: " << std::setw(8) << std::setprecision(4) << nb_accesses / index_time.count() * 1e-6 << " M/s"
+			  << " | attribute: " << std::setw(8) << position->memory_footprint() / 1024u << " KB"
+			  << " | container: " << std::setw(8) << container.memory_footprint() / 1024u << " KB"
+			  << " (" << sum << ")" << std::endl;
+}
+
+int main()
+{
+	std::cout << NB_ELEMENTS << " elements, " << NB_ITERATIONS << " traversals" << std::endl;
+
+	benchmark<ChunkArray256>("ChunkArray<256>");
+	benchmark<ChunkArray>("ChunkArray<1024>");
+	benchmark<ChunkArray4096>("ChunkArray<4096>");
+	benchmark<ChunkArray65536>("ChunkArray<65536>");
+
+	for (uint32 chunk_size : { 1024u, 16384u, 262144u })
+	{
+		set_dynamic_chunk_size(chunk_size);
+		benchmark<DynamicChunkArray>("Dynamic<" + std::to_string(chunk_size) + ">");
+	}
+
+	set_huge_page_chunks(true);
+	benchmark<DynamicChunkArray>("Dynamic<262144> HP");
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/thread.h>
+
+#include <queue>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+using namespace cgogn;
+
+const uint32 NB_TASKS = 200000u;
+const uint32 NB_ELEMENTS = 10000000u;
+
+// the previous thread pool: a single task queue guarded by a mutex
+class LockedQueuePool
+{
+	std::vector<std::thread> workers_;
+	std::queue<std::packaged_task<void()>> tasks_;
+	std::mutex queue_mutex_;
+	std::condition_variable condition_task_;
+	bool stop_;
+
+public:
+
+	LockedQueuePool(uint32 nb_workers) : stop_(false)
+	{
+		for (uint32 i = 0u; i < nb_workers; ++i)
+		{
+			workers_.emplace_back([this] ()
+			{
+				for (;;)
+				{
+					std::unique_lock<std::mutex> lock(queue_mutex_);
+					condition_task_.wait(lock, [this] () { return stop_ || !tasks_.empty(); });
+					if (stop_ && tasks_.empty())
+						return;
+					std::packaged_task<void()> task = std::move(tasks_.front());
+					tasks_.pop();
+					lock.unlock();
+					task();
+				}
+			});
+		}
+	}
+
+	~LockedQueuePool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex_);
+			stop_ = true;
+		}
+		condition_task_.notify_all();
+		for (std::thread& worker : workers_)
+			worker.join();
+	}
+
+	template <typename FUNC>
+	std::future<void> enqueue(const FUNC& f)
+	{
+		std::packaged_task<void()> task(f);
+		std::future<void> res = task.get_future();
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex_);
+			tasks_.push(std::move(task));
+		}
+		condition_task_.notify_one();
+		return res;
+	}
+};
+
+template <typename FUNC>
+float64 time(const FUNC& f)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	f();
+	auto end = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<float64> d = end - start;
+	return d.count();
+}
+
+void print(const std::string& name, uint32 nb_tasks, float64 t)
+{
+	std::cout << std::setw(32) << name
+			  << " | " << std::setw(8) << std::setprecision(4) << t * 1e3 << " ms"
+			  << " | " << std::setw(8) << std::setprecision(4) << float64(nb_tasks) / t * 1e-6 << " M tasks/s" << std::endl;
+}
+
+int main()
+{
+	thread_start();
+	ThreadPool* pool = thread_pool();
+	const uint32 nb_workers = pool->nb_workers();
+	if (nb_workers == 0u)
+	{
+		std::cout << "The thread pool has no worker" << std::endl;
+		return 0;
+	}
+	std::cout << nb_workers << " workers, " << NB_TASKS << " tasks" << std::endl;
+
+	std::vector<uint32> values(NB_ELEMENTS);
+	for (uint32 i = 0u; i < NB_ELEMENTS; ++i)
+		values[i] = i % 7u;
+	const uint32 grain_size = NB_ELEMENTS / NB_TASKS;
+
+	// a small amount of work per task
+	std::atomic<uint64> total(0u);
+	auto task_work = [&] (uint32 first, uint32 last)
+	{
+		uint64 sum = 0u;
+		for (uint32 i = first; i < last; ++i)
+			sum += values[i];
+		total.fetch_add(sum, std::memory_order_relaxed);
+	};
+
+	{
+		LockedQueuePool locked_pool(nb_workers);
+		std::vector<std::future<void>> futures;
+		futures.reserve(NB_TASKS);
+		float64 t = time([&] ()
+		{
+			for (uint32 k = 0u; k < NB_TASKS; ++k)
+				futures.push_back(locked_pool.enqueue([&, k] () { task_work(k * grain_size, (k + 1u) * grain_size); }));
+			for (auto& fu : futures)
+				fu.wait();
+		});
+		print("locked queue enqueue", NB_TASKS, t);
+	}
+
+	{
+		std::vector<std::future<void>> futures;
+		futures.reserve(NB_TASKS);
+		float64 t = time([&] ()
+		{
+			for (uint32 k = 0u; k < NB_TASKS; ++k)
+				futures.push_back(pool->enqueue([&, k] () { task_work(k * grain_size, (k + 1u) * grain_size); }));
+			for (auto& fu : futures)
+				fu.wait();
+		});
+		print("work stealing enqueue", NB_TASKS, t);
+	}
+
+	{
+		float64 t = time([&] () { pool->parallel_for(0u, NB_ELEMENTS, task_work, grain_size); });
+		// the recursive splitting creates about one task per subrange
+		print("work stealing parallel_for", NB_TASKS, t);
+	}
+
+	{
+		uint64 sum = 0u;
+		float64 t = time([&] ()
+		{
+			sum = pool->parallel_reduce(0u, NB_ELEMENTS, uint64(0u),
+				[&] (uint32 first, uint32 last) -> uint64
+				{
+					uint64 s = 0u;
+					for (uint32 i = first; i < last; ++i)
+						s += values[i];
+					return s;
+				},
+				[] (uint64 a, uint64 b) -> uint64 { return a + b; },
+				grain_size
+			);
+		});
+		print("work stealing parallel_reduce", NB_TASKS, t);
+		std::cout << "(" << sum << " " << total << ")" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cgogn/core/functions/adjacency.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/traversals/global.h>
+
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/thread.h>
+
+#include <memory>
+
+namespace cgogn
+{
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// void build_adjacency_csr(MESH& m, bool with_edges = false);
+
+/*****************************************************************************/
+
+///////////
+// CMap2 //
+///////////
+
+void build_adjacency_csr(CMap2& m, bool with_edges)
+{
+	using Vertex = CMap2::Vertex;
+	using Edge = CMap2::Edge;
+
+	if (!m.is_indexed<Vertex>())
+		index_cells<Vertex>(m);
+	if (with_edges && !m.is_indexed<Edge>())
+		index_cells<Edge>(m);
+
+	auto adjacency = std::make_shared<VertexAdjacency>();
+	adjacency->vertices_version = m.cells_version(Vertex::ORBIT);
+	adjacency->edges_version = m.cells_version(Edge::ORBIT);
+
+	// each vertex is traversed from its representative dart
+	const CMap2::Attribute<Dart>& representatives = m.cells_representatives<Vertex>();
+	const CMap2::AttributeContainer& container = m.attribute_containers_[Vertex::ORBIT];
+	const uint32 end = container.maximum_index();
+	const uint32 grain = std::max(PARALLEL_BUFFER_SIZE, end / 256u);
+	ThreadPool* pool = thread_pool();
+
+	std::vector<uint32>& offsets = adjacency->offsets;
+	offsets.assign(end + 1u, 0u);
+	pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 v = first; v < last; ++v)
+		{
+			if (!container.is_used(v) || representatives[v].is_nil())
+				continue;
+			uint32 degree = 0u;
+			m.foreach_dart_of_orbit(Vertex(representatives[v]), [&] (Dart) -> bool { ++degree; return true; });
+			offsets[v + 1u] = degree;
+		}
+	}, grain);
+	for (uint32 v = 0u; v < end; ++v)
+		offsets[v + 1u] += offsets[v];
+
+	const uint32 nb_neighbors = offsets[end];
+	adjacency->neighbors.resize(nb_neighbors);
+	adjacency->neighbor_darts.resize(nb_neighbors);
+	if (with_edges)
+		adjacency->edges.resize(nb_neighbors);
+	pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 v = first; v < last; ++v)
+		{
+			if (!container.is_used(v) || representatives[v].is_nil())
+				continue;
+			uint32 k = offsets[v];
+			m.foreach_dart_of_orbit(Vertex(representatives[v]), [&] (Dart d) -> bool
+			{
+				const Dart d2 = m.phi2(d);
+				adjacency->neighbors[k] = m.index_of(Vertex(d2));
+				adjacency->neighbor_darts[k] = d2;
+				if (with_edges)
+					adjacency->edges[k] = m.index_of(Edge(d));
+				++k;
+				return true;
+			});
+		}
+	}, grain);
+
+	m.vertex_adjacency_ = adjacency;
+}
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// void clear_adjacency_csr(MESH& m);
+
+/*****************************************************************************/
+
+///////////
+// CMap2 //
+///////////
+
+void clear_adjacency_csr(CMap2& m)
+{
+	m.vertex_adjacency_.reset();
+}
+
+} // namespace cgogn
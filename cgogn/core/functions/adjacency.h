@@ -0,0 +1,69 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_CORE_FUNCTIONS_ADJACENCY_H_
+#define CGOGN_CORE_FUNCTIONS_ADJACENCY_H_
+
+#include <cgogn/core/cgogn_core_export.h>
+
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/types/cmap/vertex_adjacency.h>
+
+namespace cgogn
+{
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// void build_adjacency_csr(MESH& m, bool with_edges = false);
+
+/*****************************************************************************/
+
+// The vertices (and the edges if requested) are indexed if they are not.
+// The traversals of the adjacent vertices use the snapshot while the connectivity of the map is unchanged.
+
+///////////
+// CMap2 //
+///////////
+
+void
+CGOGN_CORE_EXPORT build_adjacency_csr(CMap2& m, bool with_edges = false);
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// void clear_adjacency_csr(MESH& m);
+
+/*****************************************************************************/
+
+///////////
+// CMap2 //
+///////////
+
+void
+CGOGN_CORE_EXPORT clear_adjacency_csr(CMap2& m);
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_FUNCTIONS_ADJACENCY_H_
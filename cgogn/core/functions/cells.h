@@ -25,6 +25,10 @@
 #define CGOGN_CORE_FUNCTIONS_CELLS_H_
 
 #include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/types/cmap/dart_marker.h>
+
+#include <cgogn/core/utils/thread_pool.h>
+#include <cgogn/core/utils/thread.h>
 
 namespace cgogn
 {
@@ -79,7 +83,12 @@ inline
 uint32 new_index(const MESH& m)
 {
 	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
-	return m.attribute_containers_[CELL::ORBIT].new_index();
+	const uint32 index = m.attribute_containers_[CELL::ORBIT].new_index();
+	if (m.template is_indexed<CELL>())
+		m.init_cells_representatives(CELL::ORBIT, index, index + 1u);
+	m.cells_indices_changed(CELL::ORBIT);
+	m.journal_created_cell(CELL::ORBIT, index);
+	return index;
 }
 
 //////////////
@@ -97,6 +106,47 @@ uint32 new_index(const MESH& m)
 
 /*****************************************************************************/
 
+// template <typename CELL, typename MESH>
+// uint32 new_indices(MESH& m, uint32 n);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+// allocates n contiguous indices and returns the first one
+template <typename CELL, typename MESH,
+		  typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type* = nullptr>
+inline
+uint32 new_indices(const MESH& m, uint32 n)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	const uint32 first = m.attribute_containers_[CELL::ORBIT].new_indices(n);
+	if (m.template is_indexed<CELL>())
+		m.init_cells_representatives(CELL::ORBIT, first, first + n);
+	m.cells_indices_changed(CELL::ORBIT);
+	if (m.is_journaling())
+		for (uint32 i = first, end = first + n; i < end; ++i)
+			m.journal_created_cell(CELL::ORBIT, i);
+	return first;
+}
+
+//////////////
+// MESHVIEW //
+//////////////
+
+template <typename CELL, typename MESH,
+		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
+inline
+uint32 new_indices(const MESH& m, uint32 n)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return new_indices<CELL>(m.mesh(), n);
+}
+
+/*****************************************************************************/
+
 // template <typename CELL, typename MESH>
 // void set_index(MESH& m, CELL c, uint32 index);
 
@@ -134,6 +184,77 @@ void set_index(MESH& m, CELL c, uint32 index)
 
 /*****************************************************************************/
 
+// template <typename CELL, typename MESH>
+// void journal_cell(const MESH& m, CELL c);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+// records the darts of c in the journal of m (e.g. after a change of the geometry of c)
+template <typename CELL, typename MESH,
+		  typename = typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type>
+inline
+void journal_cell(const MESH& m, CELL c)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	if (!m.is_journaling())
+		return;
+	m.foreach_dart_of_orbit(c, [&] (Dart d) -> bool
+	{
+		m.journal_dart(d);
+		return true;
+	});
+}
+
+/*****************************************************************************/
+
+// template <typename CELL, typename MESH, typename FUNC>
+// void foreach_cell_in_dart_range(const MESH& m, uint32 first, uint32 last, AtomicDartMarker& dm, const FUNC& f);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+/**
+ * @brief calls f on the cells whose smallest non boundary dart is in [first, last[, by increasing dart index
+ * The darts of the traversed orbits that are greater than the current dart cannot be the smallest one:
+ * they are marked in dm and skipped, here and in the concurrent calls on other ranges sharing dm.
+ * Each cell is thus owned by a single range, without any central scan of the darts.
+ */
+template <typename CELL, typename MESH, typename FUNC,
+		  typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type* = nullptr>
+void foreach_cell_in_dart_range(const MESH& m, uint32 first, uint32 last, AtomicDartMarker& dm, const FUNC& f)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	for (uint32 i = first; i < last; ++i)
+	{
+		Dart d(i);
+		if (!m.topology_.is_used(i) || m.is_boundary(d) || dm.is_marked(d))
+			continue;
+		bool smallest = true;
+		m.foreach_dart_of_orbit(CELL(d), [&] (Dart od) -> bool
+		{
+			if (od.index > d.index)
+				dm.mark(od);
+			else if (od.index < d.index && !m.is_boundary(od))
+				smallest = false;
+			return true;
+		});
+		if (smallest && !f(CELL(d)))
+			break;
+	}
+}
+
+/*****************************************************************************/
+
 // template <typename CELL, typename MESH>
 // void index_cells(MESH& m);
 
@@ -152,13 +273,59 @@ void index_cells(MESH& m)
 	
 	if (!m.template is_indexed<CELL>())
 		m.template init_cells_indexing<CELL>();
-	
-	foreach_cell(m, [&] (CELL c) -> bool
+
+	ThreadPool* pool = thread_pool();
+	if (pool->nb_workers() == 0u)
 	{
-		if (index_of(m, c) == INVALID_INDEX)
-			set_index(m, c, new_index<CELL>(m));
-		return true;
-	}, true);
+		foreach_cell(m, [&] (CELL c) -> bool
+		{
+			if (index_of(m, c) == INVALID_INDEX)
+				set_index(m, c, new_index<CELL>(m));
+			return true;
+		}, true);
+		return;
+	}
+
+	// The unindexed cells of each range of darts are gathered in parallel.
+	// They get their indices in the order of their smallest dart, as in a sequential traversal.
+	const uint32 end = m.topology_.maximum_index();
+	const uint32 range_size = std::max(PARALLEL_BUFFER_SIZE, end / 256u);
+	const uint32 nb_ranges = (end + range_size - 1u) / range_size;
+	std::vector<std::vector<Dart>> cells_per_range(nb_ranges);
+
+	AtomicDartMarker dm(m);
+	pool->parallel_for(0u, nb_ranges, [&] (uint32 first_range, uint32 last_range)
+	{
+		for (uint32 r = first_range; r < last_range; ++r)
+		{
+			foreach_cell_in_dart_range<CELL>(m, r * range_size, std::min(end, (r + 1u) * range_size), dm, [&] (CELL c) -> bool
+			{
+				if (index_of(m, c) == INVALID_INDEX)
+					cells_per_range[r].push_back(c.dart);
+				return true;
+			});
+		}
+	}, 1u);
+
+	uint32 nb_cells = 0u;
+	std::vector<uint32> first_index(nb_ranges);
+	for (uint32 r = 0u; r < nb_ranges; ++r)
+	{
+		first_index[r] = nb_cells;
+		nb_cells += uint32(cells_per_range[r].size());
+	}
+	const uint32 first = new_indices<CELL>(m, nb_cells);
+
+	// each index is set by a single thread
+	pool->parallel_for(0u, nb_ranges, [&] (uint32 first_range, uint32 last_range)
+	{
+		for (uint32 r = first_range; r < last_range; ++r)
+		{
+			uint32 index = first + first_index[r];
+			for (Dart d : cells_per_range[r])
+				set_index(m, CELL(d), index++);
+		}
+	}, 1u);
 }
 
 //////////////
@@ -62,17 +62,36 @@ std::string cell_name(const MESH& m)
 
 /*****************************************************************************/
 
-/////////////
-// GENERIC //
-/////////////
+//////////////
+// CMapBase //
+//////////////
 
-template <typename CELL, typename MESH>
+template <typename CELL, typename MESH,
+		  typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type* = nullptr>
 uint32 nb_cells(const MESH& m)
 {
 	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
-	uint32 result = 0;
-	foreach_cell(m, [&] (CELL) -> bool { ++result; return true; });
-	return result;
+	if (m.template is_indexed<CELL>())
+		return m.template nb_indexed_cells<CELL>();
+	return parallel_reduce_cells<CELL>(m, 0u,
+		[] (CELL) -> uint32 { return 1u; },
+		[] (uint32 a, uint32 b) -> uint32 { return a + b; }
+	);
+}
+
+//////////////
+// MESHVIEW //
+//////////////
+
+template <typename CELL, typename MESH,
+		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
+uint32 nb_cells(const MESH& m)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return parallel_reduce_cells<CELL>(m, 0u,
+		[] (CELL) -> uint32 { return 1u; },
+		[] (uint32 a, uint32 b) -> uint32 { return a + b; }
+	);
 }
 
 /*****************************************************************************/
@@ -132,6 +151,11 @@ uint32 codegree(const MESH& m, typename mesh_traits<MESH>::Edge e)
 template <typename MESH>
 uint32 codegree(const MESH& m, typename mesh_traits<MESH>::Face f)
 {
+	if constexpr (std::is_base_of<CMapBase, MESH>::value)
+	{
+		if (m.is_pure_simplicial() && !m.is_boundary(f.dart))
+			return 3u;
+	}
 	uint32 result = 0;
 	foreach_incident_edge(m, f, [&] (typename mesh_traits<MESH>::Edge) -> bool { ++result; return true; });
 	return result;
@@ -140,6 +164,11 @@ uint32 codegree(const MESH& m, typename mesh_traits<MESH>::Face f)
 template <typename MESH>
 uint32 codegree(const MESH& m, typename mesh_traits<MESH>::Volume v)
 {
+	if constexpr (std::is_same<MESH, CMap3>::value)
+	{
+		if (m.is_pure_simplicial() && !m.is_boundary(v.dart))
+			return 4u;
+	}
 	uint32 result = 0;
 	foreach_incident_face(m, v, [&] (typename mesh_traits<MESH>::Face) -> bool { ++result; return true; });
 	return result;
@@ -147,6 +176,57 @@ uint32 codegree(const MESH& m, typename mesh_traits<MESH>::Volume v)
 
 /*****************************************************************************/
 
+// template <typename MESH>
+// bool check_pure_simplicial(MESH& m);
+
+/*****************************************************************************/
+
+// checks the degree of the non boundary cells and updates the pure simplicial flag of the map accordingly
+
+///////////
+// CMap2 //
+///////////
+
+inline bool check_pure_simplicial(CMap2& m)
+{
+	m.set_pure_simplicial(false);
+	const bool simplicial = parallel_reduce_cells<CMap2::Face>(m, true,
+		[&] (CMap2::Face f) -> bool { return codegree(m, f) == 3u; },
+		[] (bool a, bool b) -> bool { return a && b; }
+	);
+	m.set_pure_simplicial(simplicial);
+	return simplicial;
+}
+
+///////////
+// CMap3 //
+///////////
+
+inline bool check_pure_simplicial(CMap3& m)
+{
+	m.set_pure_simplicial(false);
+	const bool simplicial = parallel_reduce_cells<CMap3::Volume>(m, true,
+		[&] (CMap3::Volume v) -> bool
+		{
+			bool tetrahedron = codegree(m, v) == 4u;
+			if (tetrahedron)
+			{
+				foreach_incident_face(m, v, [&] (CMap3::Face f) -> bool
+				{
+					tetrahedron = codegree(m, f) == 3u;
+					return tetrahedron;
+				});
+			}
+			return tetrahedron;
+		},
+		[] (bool a, bool b) -> bool { return a && b; }
+	);
+	m.set_pure_simplicial(simplicial);
+	return simplicial;
+}
+
+/*****************************************************************************/
+
 // template <typename MESH, typename CELL>
 // bool is_incident_to_boundary(const MESH& m, CELL c);
 
@@ -45,12 +45,24 @@ namespace cgogn
 CMap1::Face
 add_face(CMap1& m, uint32 size, bool set_indices)
 {
-	Dart d = m.add_dart();
-	for (uint32 i = 1u; i < size; ++i)
+	// the phi1 sewing resets the pure simplicial flag, that a new triangle keeps
+	const bool pure_simplicial = m.is_pure_simplicial() && size == 3u;
+	// the darts are allocated at once when the map has no released dart to reuse (e.g. when it is built),
+	// one by one otherwise so that the edits that add and remove faces do not grow the topology
+	Dart d;
+	if (m.nb_darts() == m.topology_.maximum_index())
 	{
-		Dart e = m.add_dart();
-		m.phi1_sew(d, e);
+		d = m.add_darts(size);
+		for (uint32 i = 1u; i < size; ++i)
+			m.phi1_sew(d, Dart(d.index + i));
 	}
+	else
+	{
+		d = m.add_dart();
+		for (uint32 i = 1u; i < size; ++i)
+			m.phi1_sew(d, m.add_dart());
+	}
+	m.set_pure_simplicial(pure_simplicial);
 	CMap1::Face f(d);
 
 	if (set_indices)
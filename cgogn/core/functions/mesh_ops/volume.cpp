@@ -31,6 +31,37 @@
 namespace cgogn
 {
 
+// gives new indices to the cells of a volume built with no indices
+static void set_volume_indices(CMap2& m, CMap2::Volume vol)
+{
+	if (m.is_indexed<CMap2::Vertex>())
+	{
+		foreach_incident_vertex(m, vol, [&] (CMap2::Vertex v) -> bool
+		{
+			set_index(m, v, new_index<CMap2::Vertex>(m));
+			return true;
+		});
+	}
+	if (m.is_indexed<CMap2::Edge>())
+	{
+		foreach_incident_edge(m, vol, [&] (CMap2::Edge e) -> bool
+		{
+			set_index(m, e, new_index<CMap2::Edge>(m));
+			return true;
+		});
+	}
+	if (m.is_indexed<CMap2::Face>())
+	{
+		foreach_incident_face(m, vol, [&] (CMap2::Face f) -> bool
+		{
+			set_index(m, f, new_index<CMap2::Face>(m));
+			return true;
+		});
+	}
+	if (m.is_indexed<CMap2::Volume>())
+		set_index(m, vol, new_index<CMap2::Volume>(m));
+}
+
 /*****************************************************************************/
 
 // template <typename MESH>
@@ -60,34 +91,42 @@ add_pyramid(CMap2& m, uint32 size, bool set_indices)
 	CMap2::Volume vol(base.dart);
 
 	if (set_indices)
+		set_volume_indices(m, vol);
+
+	return vol;
+}
+
+/*****************************************************************************/
+
+// template <typename MESH>
+// typename mesh_traits<MESH>::Volume
+// add_prism(MESH& m, uint32 size, bool set_indices = true);
+
+/*****************************************************************************/
+
+///////////
+// CMap2 //
+///////////
+
+CMap2::Volume
+add_prism(CMap2& m, uint32 size, bool set_indices)
+{
+	CMap1::Face first = add_face(static_cast<CMap1&>(m), 4u, false); // First quad
+	Dart current = first.dart;
+	for (uint32 i = 1u; i < size; ++i) // Next quads
 	{
-		if (m.is_indexed<CMap2::Vertex>())
-		{
-			foreach_incident_vertex(m, vol, [&] (CMap2::Vertex v) -> bool
-			{
-				set_index(m, v, new_index<CMap2::Vertex>(m));
-				return true;
-			});
-		}
-		if (m.is_indexed<CMap2::Edge>())
-		{
-			foreach_incident_edge(m, vol, [&] (CMap2::Edge e) -> bool
-			{
-				set_index(m, e, new_index<CMap2::Edge>(m));
-				return true;
-			});
-		}
-		if (m.is_indexed<CMap2::Face>())
-		{
-			foreach_incident_face(m, vol, [&] (CMap2::Face f) -> bool
-			{
-				set_index(m, f, new_index<CMap2::Face>(m));
-				return true;
-			});
-		}
-		if (m.is_indexed<CMap2::Volume>())
-			set_index(m, vol, new_index<CMap2::Volume>(m));
+		CMap1::Face next = add_face(static_cast<CMap1&>(m), 4u, false);
+		m.phi2_sew(m.phi1(current), m.phi_1(next.dart));
+		current = next.dart;
 	}
+	m.phi2_sew(m.phi1(current), m.phi_1(first.dart)); // Finish the ring
+	m.close_hole(m.phi1(m.phi1(first.dart)), false); // Add the top face
+	CMap2::Face base = m.close_hole(first.dart, false); // Add the base face
+
+	CMap2::Volume vol(base.dart);
+
+	if (set_indices)
+		set_volume_indices(m, vol);
 
 	return vol;
 }
@@ -29,7 +29,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Edge> incident_edges(MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Edge, N> incident_edges(MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -37,10 +37,9 @@ namespace cgogn
 // CMap1 //
 ///////////
 
-std::vector<CMap1::Vertex> incident_edges(const CMap1& m, CMap1::Face f)
+SmallVector<CMap1::Edge, 8u> incident_edges(const CMap1& m, CMap1::Face f)
 {
-	std::vector<CMap1::Edge> edges;
-	edges.reserve(8u);
+	SmallVector<CMap1::Edge, 8u> edges;
 	m.foreach_dart_of_orbit(f, [&] (Dart d) -> bool { edges.push_back(CMap1::Edge(d)); return true; });
 	return edges;
 }
@@ -49,26 +48,23 @@ std::vector<CMap1::Vertex> incident_edges(const CMap1& m, CMap1::Face f)
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Edge> incident_edges(const CMap2& m, CMap2::Vertex v)
+SmallVector<CMap2::Edge, 8u> incident_edges(const CMap2& m, CMap2::Vertex v)
 {
-	std::vector<CMap2::Edge> edges;
-	edges.reserve(8u);
+	SmallVector<CMap2::Edge, 8u> edges;
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool { edges.push_back(CMap2::Edge(d)); return true; });
 	return edges;
 }
 
-std::vector<CMap2::Edge> incident_edges(const CMap2& m, CMap2::Face f)
+SmallVector<CMap2::Edge, 16u> incident_edges(const CMap2& m, CMap2::Face f)
 {
-	std::vector<CMap2::Edge> edges;
-	edges.reserve(16u);
+	SmallVector<CMap2::Edge, 16u> edges;
 	m.foreach_dart_of_orbit(f, [&] (Dart d) -> bool { edges.push_back(CMap2::Edge(d)); return true; });
 	return edges;
 }
 
-std::vector<CMap2::Edge> incident_edges(const CMap2& m, CMap2::Volume v)
+SmallVector<CMap2::Edge, 32u> incident_edges(const CMap2& m, CMap2::Volume v)
 {
-	std::vector<CMap2::Edge> edges;
-	edges.reserve(32u);
+	SmallVector<CMap2::Edge, 32u> edges;
 	foreach_incident_edge(m, v, [&] (CMap2::Edge e) -> bool { edges.push_back(e); return true; });
 	return edges;
 }
@@ -77,26 +73,23 @@ std::vector<CMap2::Edge> incident_edges(const CMap2& m, CMap2::Volume v)
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Edge> incident_edges(const CMap3& m, CMap3::Vertex v)
+SmallVector<CMap3::Edge, 16u> incident_edges(const CMap3& m, CMap3::Vertex v)
 {
-	std::vector<CMap3::Edge> edges;
-	edges.reserve(16u);
+	SmallVector<CMap3::Edge, 16u> edges;
 	foreach_incident_edge(m, v, [&] (CMap3::Edge e) -> bool { edges.push_back(e); return true; });
 	return edges;
 }
 
-std::vector<CMap3::Edge> incident_edges(const CMap3& m, CMap3::Face f)
+SmallVector<CMap3::Edge, 16u> incident_edges(const CMap3& m, CMap3::Face f)
 {
-	std::vector<CMap3::Edge> edges;
-	edges.reserve(16u);
+	SmallVector<CMap3::Edge, 16u> edges;
 	static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Face(f.dart), [&] (Dart d) -> bool { edges.push_back(CMap3::Edge(d)); return true; });
 	return edges;
 }
 
-std::vector<CMap3::Edge> incident_edges(const CMap3& m, CMap3::Volume v)
+SmallVector<CMap3::Edge, 32u> incident_edges(const CMap3& m, CMap3::Volume v)
 {
-	std::vector<CMap3::Edge> edges;
-	edges.reserve(32u);
+	SmallVector<CMap3::Edge, 32u> edges;
 	foreach_incident_edge(m, v, [&] (CMap3::Edge e) -> bool { edges.push_back(e); return true; });
 	return edges;
 }
@@ -28,6 +28,7 @@
 
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/small_vector.h>
 
 namespace cgogn
 {
@@ -35,7 +36,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Edge> incident_edges(MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Edge, N> incident_edges(MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -43,33 +44,33 @@ namespace cgogn
 // CMap1 //
 ///////////
 
-std::vector<CMap1::Vertex>
+SmallVector<CMap1::Edge, 8u>
 CGOGN_CORE_EXPORT incident_edges(const CMap1& m, CMap1::Face f);
 
 ///////////
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Edge>
+SmallVector<CMap2::Edge, 8u>
 CGOGN_CORE_EXPORT incident_edges(const CMap2& m, CMap2::Vertex v);
 
-std::vector<CMap2::Edge>
+SmallVector<CMap2::Edge, 16u>
 CGOGN_CORE_EXPORT incident_edges(const CMap2& m, CMap2::Face f);
 
-std::vector<CMap2::Edge>
+SmallVector<CMap2::Edge, 32u>
 CGOGN_CORE_EXPORT incident_edges(const CMap2& m, CMap2::Volume v);
 
 ///////////
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Edge>
+SmallVector<CMap3::Edge, 16u>
 CGOGN_CORE_EXPORT incident_edges(const CMap3& m, CMap3::Vertex v);
 
-std::vector<CMap3::Edge>
+SmallVector<CMap3::Edge, 16u>
 CGOGN_CORE_EXPORT incident_edges(const CMap3& m, CMap3::Face f);
 
-std::vector<CMap3::Edge>
+SmallVector<CMap3::Edge, 32u>
 CGOGN_CORE_EXPORT incident_edges(const CMap3& m, CMap3::Volume v);
 
 //////////////
@@ -78,7 +79,7 @@ CGOGN_CORE_EXPORT incident_edges(const CMap3& m, CMap3::Volume v);
 
 template <typename CELL, typename MESH,
 		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
-std::vector<typename mesh_traits<MESH>::Vertex>
+auto
 incident_edges(const MESH& m, CELL c)
 {
 	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
@@ -129,6 +130,15 @@ void foreach_incident_edge(const CMap2& m, CMap2::Volume v, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap2::Edge>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (m.is_labeled(PHI1_PHI2))
+	{
+		// each edge is reported through the smallest of its two darts
+		m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
+		{
+			return d.index <= m.phi2(d).index ? func(CMap2::Edge(d)) : true;
+		});
+		return;
+	}
 	DartMarkerStore marker(m);
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 	{
@@ -175,6 +185,15 @@ void foreach_incident_edge(const CMap3& m, CMap3::Volume v, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap3::Edge>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (m.is_labeled(PHI1_PHI2))
+	{
+		// each edge of the volume is reported through the smallest of its two darts in the volume
+		m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
+		{
+			return d.index <= m.phi2(d).index ? func(CMap3::Edge(d)) : true;
+		});
+		return;
+	}
 	DartMarkerStore marker(m);
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 	{
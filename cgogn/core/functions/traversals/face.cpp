@@ -29,7 +29,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Face> incident_faces(MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Face, N> incident_faces(MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -37,26 +37,23 @@ namespace cgogn
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Face> incident_faces(const CMap2& m, CMap2::Vertex v)
+SmallVector<CMap2::Face, 8u> incident_faces(const CMap2& m, CMap2::Vertex v)
 {
-	std::vector<CMap2::Face> faces;
-	faces.reserve(8u);
+	SmallVector<CMap2::Face, 8u> faces;
 	foreach_incident_face(m, v, [&] (CMap2::Face f) -> bool { faces.push_back(f); return true; });
 	return faces;
 }
 
-std::vector<CMap2::Face> incident_faces(const CMap2& m, CMap2::Edge e)
+SmallVector<CMap2::Face, 2u> incident_faces(const CMap2& m, CMap2::Edge e)
 {
-	std::vector<CMap2::Face> faces;
-	faces.reserve(8u);
+	SmallVector<CMap2::Face, 2u> faces;
 	foreach_incident_face(m, e, [&] (CMap2::Face f) -> bool { faces.push_back(f); return true; });
 	return faces;
 }
 
-std::vector<CMap2::Face> incident_faces(const CMap2& m, CMap2::Volume v)
+SmallVector<CMap2::Face, 32u> incident_faces(const CMap2& m, CMap2::Volume v)
 {
-	std::vector<CMap2::Face> faces;
-	faces.reserve(32u);
+	SmallVector<CMap2::Face, 32u> faces;
 	foreach_incident_face(m, v, [&] (CMap2::Face f) -> bool { faces.push_back(f); return true; });
 	return faces;
 }
@@ -65,27 +62,24 @@ std::vector<CMap2::Face> incident_faces(const CMap2& m, CMap2::Volume v)
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Face> incident_faces(const CMap3& m, CMap3::Vertex v)
+SmallVector<CMap3::Face, 16u> incident_faces(const CMap3& m, CMap3::Vertex v)
 {
-	std::vector<CMap3::Face> faces;
-	faces.reserve(16u);
+	SmallVector<CMap3::Face, 16u> faces;
 	foreach_incident_face(m, v, [&] (CMap3::Face f) -> bool { faces.push_back(f); return true; });
 	return faces;
 }
 
-std::vector<CMap3::Face> incident_faces(const CMap3& m, CMap3::Edge e)
+SmallVector<CMap3::Face, 16u> incident_faces(const CMap3& m, CMap3::Edge e)
 {
-	std::vector<CMap3::Face> faces;
-	faces.reserve(16u);
+	SmallVector<CMap3::Face, 16u> faces;
 	foreach_incident_face(m, e, [&] (CMap3::Face f) -> bool { faces.push_back(f); return true; });
 	
 	return faces;
 }
 
-std::vector<CMap3::Face> incident_faces(const CMap3& m, CMap3::Volume v)
+SmallVector<CMap3::Face, 32u> incident_faces(const CMap3& m, CMap3::Volume v)
 {
-	std::vector<CMap3::Face> faces;
-	faces.reserve(32u);
+	SmallVector<CMap3::Face, 32u> faces;
 	foreach_incident_face(m, v, [&] (CMap3::Face f) -> bool { faces.push_back(f); return true; });
 	return faces;
 }
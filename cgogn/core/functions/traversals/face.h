@@ -28,6 +28,7 @@
 
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/small_vector.h>
 
 namespace cgogn
 {
@@ -35,7 +36,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename MESH, typename CELL>
-// std::vector<typename mesh_traits<MESH>::Face> incident_faces(MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Face, N> incident_faces(MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -43,26 +44,26 @@ namespace cgogn
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Face>
+SmallVector<CMap2::Face, 8u>
 CGOGN_CORE_EXPORT incident_faces(const CMap2& m, CMap2::Vertex v);
 
-std::vector<CMap2::Face>
+SmallVector<CMap2::Face, 2u>
 CGOGN_CORE_EXPORT incident_faces(const CMap2& m, CMap2::Edge e);
 
-std::vector<CMap2::Face>
+SmallVector<CMap2::Face, 32u>
 CGOGN_CORE_EXPORT incident_faces(const CMap2& m, CMap2::Volume v);
 
 ///////////
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Face>
+SmallVector<CMap3::Face, 16u>
 CGOGN_CORE_EXPORT incident_faces(const CMap3& m, CMap3::Vertex v);
 
-std::vector<CMap3::Face>
+SmallVector<CMap3::Face, 16u>
 CGOGN_CORE_EXPORT incident_faces(const CMap3& m, CMap3::Edge e);
 
-std::vector<CMap3::Face>
+SmallVector<CMap3::Face, 32u>
 CGOGN_CORE_EXPORT incident_faces(const CMap3& m, CMap3::Volume v);
 
 //////////////
@@ -71,7 +72,7 @@ CGOGN_CORE_EXPORT incident_faces(const CMap3& m, CMap3::Volume v);
 
 template <typename CELL, typename MESH,
 		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
-std::vector<typename mesh_traits<MESH>::Vertex>
+auto
 incident_faces(const MESH& m, CELL c)
 {
 	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
@@ -120,6 +121,14 @@ void foreach_incident_face(const CMap2& m, CMap2::Volume v, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap2::Face>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (m.is_labeled(PHI1_PHI2))
+	{
+		// each face of the volume is reported through the smallest of its darts
+		m.foreach_sub_orbit_of_labeled_orbit(PHI1_PHI2, v.dart,
+			[&] (Dart d, const auto& f) { m.foreach_dart_of_PHI1(d, f); },
+			[&] (Dart d) -> bool { return m.is_boundary(d) || func(CMap2::Face(d)); });
+		return;
+	}
 	DartMarkerStore marker(m);
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 	{
@@ -171,6 +180,14 @@ void foreach_incident_face(const CMap3& m, CMap3::Volume v, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap3::Face>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (m.is_labeled(PHI1_PHI2))
+	{
+		// each face of the volume is reported through the smallest of its darts in the volume
+		m.foreach_sub_orbit_of_labeled_orbit(PHI1_PHI2, v.dart,
+			[&] (Dart d, const auto& f) { m.foreach_dart_of_PHI1(d, f); },
+			[&] (Dart d) -> bool { return func(CMap3::Face(d)); });
+		return;
+	}
 	DartMarkerStore marker(m);
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 	{
@@ -27,7 +27,6 @@
 #include <cgogn/core/utils/type_traits.h>
 #include <cgogn/core/utils/thread_pool.h>
 #include <cgogn/core/utils/thread.h>
-#include <cgogn/core/utils/buffers.h>
 
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/types/cell_marker.h>
@@ -60,18 +59,26 @@ foreach_cell(const MESH& m, const FUNC& f, bool force_dart_marking = false)
 
 	if (!force_dart_marking && m.template is_indexed<CELL>())
 	{
-		CellMarker<MESH, CELL> cm(m);
-		m.foreach_dart([&] (Dart d) -> bool
+		// the indexed cells are traversed through their representative darts (in the order of their indices)
+		const typename MESH::template Attribute<Dart>& representatives = m.template cells_representatives<CELL>();
+		m.attribute_containers_[CELL::ORBIT].foreach_live_index([&] (uint32 i) -> bool
 		{
-			const CELL c(d);
-			if (!m.is_boundary(d) && !cm.is_marked(c))
-			{
-				cm.mark(c);
-				return f(c);
-			}
-			return true;
+			const Dart d = representatives[i];
+			if (d.is_nil())
+				return true;
+			return f(CELL(d));
 		});
 	}
+	else if (m.is_labeled(CELL::ORBIT))
+	{
+		// the labeled cells are traversed through their smallest non boundary dart (in the order of their labels)
+		for (uint32 l = 0u, nb = m.nb_labels(CELL::ORBIT); l < nb; ++l)
+		{
+			const Dart d = m.labeled_orbit_representative(CELL::ORBIT, l);
+			if (!d.is_nil() && !f(CELL(d)))
+				break;
+		}
+	}
 	else
 	{
 		DartMarker dm(m);
@@ -155,118 +162,53 @@ parallel_foreach_cell(const MESH& m, const FUNC& f, bool force_dart_marking = fa
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
 	ThreadPool* pool = thread_pool();
-	uint32 nb_workers = pool->nb_workers();
-	if (nb_workers == 0)
+	if (pool->nb_workers() == 0)
 		return foreach_cell(m, f, force_dart_marking);
-	
-	using VecCell = std::vector<uint32>;
-	using Future = std::future<void>;
-
-	std::array<std::vector<VecCell*>, 2> cells_buffers;
-	std::array<std::vector<Future>, 2> futures;
-	cells_buffers[0].reserve(nb_workers);
-	cells_buffers[1].reserve(nb_workers);
-	futures[0].reserve(nb_workers);
-	futures[1].reserve(nb_workers);
-
-	Buffers<uint32>* buffers = uint32_buffers();
-	
-	Dart it = m.begin();
-	Dart last = m.end();
-
-	uint32 i = 0u; // buffer id (0/1)
-	uint32 j = 0u; // thread id (0..nb_workers)
-	
+
 	if (!force_dart_marking && m.template is_indexed<CELL>())
 	{
-		CellMarker<MESH, CELL> cm(m);
-		while (it.index < last.index)
+		// the indices of the cells are partitioned in ranges that are scanned by the workers
+		const typename MESH::template Attribute<Dart>& representatives = m.template cells_representatives<CELL>();
+		const typename MESH::AttributeContainer& container = m.attribute_containers_[CELL::ORBIT];
+		const uint32 end = container.maximum_index();
+		pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
 		{
-			// fill buffer
-			cells_buffers[i].push_back(buffers->buffer());
-			VecCell& cells = *cells_buffers[i].back();
-			cells.reserve(PARALLEL_BUFFER_SIZE);
-			for (uint32 k = 0u; k < PARALLEL_BUFFER_SIZE && it.index < last.index; )
+			for (uint32 i = first; i < last; ++i)
 			{
-				CELL c(it);
-				if (!m.is_boundary(it) && !cm.is_marked(c))
-				{
-					cm.mark(c);
-					cells.push_back(c.dart.index);
-					++k;
-				}
-				it = m.next(it);
+				if (container.is_used(i) && !representatives[i].is_nil())
+					f(CELL(representatives[i]));
 			}
-			// launch thread
-			futures[i].push_back(pool->enqueue([&cells, &f] ()
+		}, std::max(PARALLEL_BUFFER_SIZE, end / 256u));
+	}
+	else if (m.is_labeled(CELL::ORBIT))
+	{
+		// the labels of the cells are partitioned in ranges that are scanned by the workers
+		const uint32 end = m.nb_labels(CELL::ORBIT);
+		pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
+		{
+			for (uint32 l = first; l < last; ++l)
 			{
-				for (uint32 index : cells)
-					f(CELL(Dart(index)));
-			}));
-			// next thread
-			if (++j == nb_workers)
-			{	// again from 0 & change buffer
-				j = 0u;
-				i = (i + 1u) % 2u;
-				for (auto& fu : futures[i])
-					fu.wait();
-				for (auto& b : cells_buffers[i])
-					buffers->release_buffer(b);
-				futures[i].clear();
-				cells_buffers[i].clear();
+				const Dart d = m.labeled_orbit_representative(CELL::ORBIT, l);
+				if (!d.is_nil())
+					f(CELL(d));
 			}
-		}
+		}, std::max(PARALLEL_BUFFER_SIZE, end / 256u));
 	}
 	else
 	{
-		DartMarker dm(m);
-		while (it.index < last.index)
+		// the darts are partitioned in ranges that are scanned by the workers:
+		// a cell is processed by the worker whose range contains its smallest non boundary dart
+		const uint32 end = m.topology_.maximum_index();
+		AtomicDartMarker dm(m);
+		pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
 		{
-			// fill buffer
-			cells_buffers[i].push_back(buffers->buffer());
-			VecCell& cells = *cells_buffers[i].back();
-			cells.reserve(PARALLEL_BUFFER_SIZE);
-			for (uint32 k = 0u; k < PARALLEL_BUFFER_SIZE && it.index < last.index; )
-			{
-				if (!m.is_boundary(it) && !dm.is_marked(it))
-				{
-					CELL c(it);
-					m.foreach_dart_of_orbit(c, [&] (Dart d) -> bool { dm.mark(d); return true; });
-					cells.push_back(c.dart.index);
-					++k;
-				}
-				it = m.next(it);
-			}
-			// launch thread
-			futures[i].push_back(pool->enqueue([&cells, &f] ()
+			foreach_cell_in_dart_range<CELL>(m, first, last, dm, [&] (CELL c) -> bool
 			{
-				for (uint32 index : cells)
-					f(CELL(Dart(index)));
-			}));
-			// next thread
-			if (++j == nb_workers)
-			{	// again from 0 & change buffer
-				j = 0u;
-				i = (i + 1u) % 2u;
-				for (auto& fu : futures[i])
-					fu.wait();
-				for (auto& b : cells_buffers[i])
-					buffers->release_buffer(b);
-				futures[i].clear();
-				cells_buffers[i].clear();
-			}
-		}
+				f(c);
+				return true;
+			});
+		}, std::max(PARALLEL_BUFFER_SIZE, end / 256u));
 	}
-
-	// clean all at the end
-	for (auto& fu : futures[0u])
-		fu.wait();
-	for (auto &b : cells_buffers[0u])
-		buffers->release_buffer(b);
-	for (auto& fu : futures[1u])
-		fu.wait();
-	for (auto &b : cells_buffers[1u])
-		buffers->release_buffer(b);
 }
 
 ///////////////
@@ -283,68 +225,15 @@ parallel_foreach_cell(const CellCache<MESH>& cc, const FUNC& f)
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
 
 	ThreadPool* pool = thread_pool();
-	uint32 nb_workers = pool->nb_workers();
-	if (nb_workers == 0)
+	if (pool->nb_workers() == 0)
 		return foreach_cell(cc, f);
-	
-	using VecCell = std::vector<uint32>;
-	using Future = std::future<void>;
-
-	std::array<std::vector<VecCell*>, 2> cells_buffers;
-	std::array<std::vector<Future>, 2> futures;
-	cells_buffers[0].reserve(nb_workers);
-	cells_buffers[1].reserve(nb_workers);
-	futures[0].reserve(nb_workers);
-	futures[1].reserve(nb_workers);
-
-	Buffers<uint32>* buffers = uint32_buffers();
-	
-	auto it = cc.template begin<CELL>();
-	auto last = cc.template end<CELL>();
-
-	uint32 i = 0u; // buffer id (0/1)
-	uint32 j = 0u; // thread id (0..nb_workers)
-	
-	while (it != last)
-	{
-		// fill buffer
-		cells_buffers[i].push_back(buffers->buffer());
-		VecCell& cells = *cells_buffers[i].back();
-		cells.reserve(PARALLEL_BUFFER_SIZE);
-		for (uint32 k = 0u; k < PARALLEL_BUFFER_SIZE && it != last; ++k)
-		{
-			cells.push_back((*it).dart.index);
-			it++;
-		}
-		// launch thread
-		futures[i].push_back(pool->enqueue([&cells, &f] ()
-		{
-			for (uint32 index : cells)
-				f(CELL(Dart(index)));
-		}));
-		// next thread
-		if (++j == nb_workers)
-		{	// again from 0 & change buffer
-			j = 0;
-			i = (i + 1u) % 2u;
-			for (auto& fu : futures[i])
-				fu.wait();
-			for (auto& b : cells_buffers[i])
-				buffers->release_buffer(b);
-			futures[i].clear();
-			cells_buffers[i].clear();
-		}
-	}
 
-	// clean all at the end
-	for (auto& fu : futures[0u])
-		fu.wait();
-	for (auto &b : cells_buffers[0u])
-		buffers->release_buffer(b);
-	for (auto& fu : futures[1u])
-		fu.wait();
-	for (auto &b : cells_buffers[1u])
-		buffers->release_buffer(b);
+	const std::vector<CELL>& cells = cc.template cell_vector<CELL>();
+	pool->parallel_for(0u, uint32(cells.size()), [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+			f(cells[i]);
+	}, PARALLEL_BUFFER_SIZE);
 }
 
 ////////////////
@@ -368,6 +257,168 @@ parallel_foreach_cell(const CellFilter<MESH>& cf, const FUNC& f)
 	});
 }
 
+/*****************************************************************************/
+
+// template <typename CELL, typename T, typename MESH, typename MAP, typename COMBINE>
+// T parallel_reduce_cells(const MESH& m, const T& identity, const MAP& map, const COMBINE& combine);
+
+/*****************************************************************************/
+
+// The cells are split in fixed groups (ranges of darts, of cache entries) whose values are
+// folded in order and combined along a tree that only depends on the mesh: the result does
+// not depend on the number of workers (floating point sums are reproducible).
+// map computes the value of a cell, combine(a, b) combines the values of consecutive groups of cells.
+
+//////////////
+// CMapBase //
+//////////////
+
+template <typename CELL, typename T, typename MESH, typename MAP, typename COMBINE,
+		  typename = typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type>
+T
+parallel_reduce_cells(const MESH& m, const T& identity, const MAP& map, const COMBINE& combine)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<MAP, CELL>::value, "Wrong function cell parameter type");
+
+	if (m.template is_indexed<CELL>())
+	{
+		// an indexed cell belongs to the range of its index
+		const typename MESH::template Attribute<Dart>& representatives = m.template cells_representatives<CELL>();
+		const typename MESH::AttributeContainer& container = m.attribute_containers_[CELL::ORBIT];
+		const uint32 end = container.maximum_index();
+		return thread_pool()->parallel_reduce(0u, end, identity, [&] (uint32 first, uint32 last) -> T
+		{
+			T result = identity;
+			for (uint32 i = first; i < last; ++i)
+			{
+				if (container.is_used(i) && !representatives[i].is_nil())
+					result = combine(std::move(result), map(CELL(representatives[i])));
+			}
+			return result;
+		}, combine, std::max(PARALLEL_BUFFER_SIZE, end / 256u));
+	}
+
+	if (m.is_labeled(CELL::ORBIT))
+	{
+		// a labeled cell belongs to the range of its label
+		const uint32 end = m.nb_labels(CELL::ORBIT);
+		return thread_pool()->parallel_reduce(0u, end, identity, [&] (uint32 first, uint32 last) -> T
+		{
+			T result = identity;
+			for (uint32 l = first; l < last; ++l)
+			{
+				const Dart d = m.labeled_orbit_representative(CELL::ORBIT, l);
+				if (!d.is_nil())
+					result = combine(std::move(result), map(CELL(d)));
+			}
+			return result;
+		}, combine, std::max(PARALLEL_BUFFER_SIZE, end / 256u));
+	}
+
+	// a cell belongs to the range of its smallest non boundary dart
+	const uint32 end = m.topology_.maximum_index();
+	AtomicDartMarker dm(m);
+	return thread_pool()->parallel_reduce(0u, end, identity, [&] (uint32 first, uint32 last) -> T
+	{
+		T result = identity;
+		foreach_cell_in_dart_range<CELL>(m, first, last, dm, [&] (CELL c) -> bool
+		{
+			result = combine(std::move(result), map(c));
+			return true;
+		});
+		return result;
+	}, combine, std::max(PARALLEL_BUFFER_SIZE, end / 256u));
+}
+
+///////////////
+// CellCache //
+///////////////
+
+template <typename CELL, typename T, typename MESH, typename MAP, typename COMBINE>
+T
+parallel_reduce_cells(const CellCache<MESH>& cc, const T& identity, const MAP& map, const COMBINE& combine)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<MAP, CELL>::value, "Wrong function cell parameter type");
+
+	const std::vector<CELL>& cells = cc.template cell_vector<CELL>();
+	return thread_pool()->parallel_reduce(0u, uint32(cells.size()), identity, [&] (uint32 first, uint32 last) -> T
+	{
+		T result = identity;
+		for (uint32 i = first; i < last; ++i)
+			result = combine(std::move(result), map(cells[i]));
+		return result;
+	}, combine, PARALLEL_BUFFER_SIZE);
+}
+
+////////////////
+// CellFilter //
+////////////////
+
+template <typename CELL, typename T, typename MESH, typename MAP, typename COMBINE>
+T
+parallel_reduce_cells(const CellFilter<MESH>& cf, const T& identity, const MAP& map, const COMBINE& combine)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<MAP, CELL>::value, "Wrong function cell parameter type");
+
+	return parallel_reduce_cells<CELL>(cf.mesh(), identity, [&] (CELL c) -> T
+	{
+		if (cf.filter(c))
+			return map(c);
+		return identity;
+	}, combine);
+}
+
+/*****************************************************************************/
+
+// template <typename MESH, typename FUNC>
+// void foreach_journaled_cell(const MESH& m, const FUNC& f);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+/**
+ * @brief calls f once on each cell that contains a dart recorded in the journal of m
+ * (the cells created or modified since the checkpoint, see CMapBase::enable_journal).
+ * As in foreach_cell, only the cells that have a non boundary dart are traversed.
+ */
+template <typename MESH, typename FUNC,
+		  typename = typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type>
+void
+foreach_journaled_cell(const MESH& m, const FUNC& f)
+{
+	using CELL = func_parameter_type<FUNC>;
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	static_assert(is_func_parameter_same<FUNC, CELL>::value, "Wrong function cell parameter type");
+	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+
+	const CellsJournal* journal = m.journal();
+	cgogn_message_assert(journal, "The journal is not enabled");
+
+	DartMarkerStore dm(m);
+	for (Dart d : journal->darts)
+	{
+		// the recorded darts may have been removed since
+		if (!m.is_live_dart(d) || dm.is_marked(d))
+			continue;
+		Dart c;
+		m.foreach_dart_of_orbit(CELL(d), [&] (Dart e) -> bool
+		{
+			dm.mark(e);
+			if (c.is_nil() && !m.is_boundary(e))
+				c = e;
+			return true;
+		});
+		if (!c.is_nil() && !f(CELL(c)))
+			break;
+	}
+}
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_FUNCTIONS_TRAVERSALS_GLOBAL_H_
@@ -29,7 +29,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename CELL, typename MESH>
-// std::vector<typename mesh_traits<MESH>::Vertex> incident_vertices(const MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Vertex, N> incident_vertices(const MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -37,10 +37,9 @@ namespace cgogn
 // Graph //
 ///////////
 
-std::vector<Graph::Vertex> incident_vertices(const Graph& g, Graph::Edge e)
+SmallVector<Graph::Vertex, 2u> incident_vertices(const Graph& g, Graph::Edge e)
 {
-	std::vector<Graph::Vertex> vertices;
-	vertices.reserve(2u);
+	SmallVector<Graph::Vertex, 2u> vertices;
 	Dart d = e.dart;
 	Dart dd = g.alpha0(d);
 	vertices.push_back(Graph::Vertex(d));
@@ -55,10 +54,9 @@ std::vector<Graph::Vertex> incident_vertices(const Graph& g, Graph::Edge e)
 // CMap1 //
 ///////////
 
-std::vector<CMap1::Vertex> incident_vertices(const CMap1& m, CMap1::Face f)
+SmallVector<CMap1::Vertex, 8u> incident_vertices(const CMap1& m, CMap1::Face f)
 {
-	std::vector<CMap1::Vertex> vertices;
-	vertices.reserve(8u);
+	SmallVector<CMap1::Vertex, 8u> vertices;
 	m.foreach_dart_of_orbit(f, [&] (Dart d) -> bool { vertices.push_back(CMap1::Vertex(d)); return true; });
 	return vertices;
 }
@@ -67,26 +65,23 @@ std::vector<CMap1::Vertex> incident_vertices(const CMap1& m, CMap1::Face f)
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Vertex> incident_vertices(const CMap2& m, CMap2::Edge e)
+SmallVector<CMap2::Vertex, 2u> incident_vertices(const CMap2& m, CMap2::Edge e)
 {
-	std::vector<CMap2::Vertex> vertices;
-	vertices.reserve(2u);
+	SmallVector<CMap2::Vertex, 2u> vertices;
 	m.foreach_dart_of_orbit(e, [&] (Dart d) -> bool { vertices.push_back(CMap2::Vertex(d)); return true; });
 	return vertices;
 }
 
-std::vector<CMap2::Vertex> incident_vertices(const CMap2& m, CMap2::Face f)
+SmallVector<CMap2::Vertex, 16u> incident_vertices(const CMap2& m, CMap2::Face f)
 {
-	std::vector<CMap2::Vertex> vertices;
-	vertices.reserve(16u);
+	SmallVector<CMap2::Vertex, 16u> vertices;
 	m.foreach_dart_of_orbit(f, [&] (Dart d) -> bool { vertices.push_back(CMap2::Vertex(d)); return true; });
 	return vertices;
 }
 
-std::vector<CMap2::Vertex> incident_vertices(const CMap2& m, CMap2::Volume v)
+SmallVector<CMap2::Vertex, 32u> incident_vertices(const CMap2& m, CMap2::Volume v)
 {
-	std::vector<CMap2::Vertex> vertices;
-	vertices.reserve(32u);
+	SmallVector<CMap2::Vertex, 32u> vertices;
 	foreach_incident_vertex(m, v, [&] (CMap2::Vertex vert) -> bool { vertices.push_back(vert); return true; });
 	return vertices;
 }
@@ -95,26 +90,23 @@ std::vector<CMap2::Vertex> incident_vertices(const CMap2& m, CMap2::Volume v)
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Vertex> incident_vertices(const CMap3& m, CMap3::Edge e)
+SmallVector<CMap3::Vertex, 2u> incident_vertices(const CMap3& m, CMap3::Edge e)
 {
-	std::vector<CMap3::Vertex> vertices;
-	vertices.reserve(2u);
+	SmallVector<CMap3::Vertex, 2u> vertices;
 	static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Edge(e.dart), [&] (Dart d) -> bool { vertices.push_back(CMap3::Vertex(d)); return true; });
 	return vertices;
 }
 
-std::vector<CMap3::Vertex> incident_vertices(const CMap3& m, CMap3::Face f)
+SmallVector<CMap3::Vertex, 16u> incident_vertices(const CMap3& m, CMap3::Face f)
 {
-	std::vector<CMap3::Vertex> vertices;
-	vertices.reserve(16u);
+	SmallVector<CMap3::Vertex, 16u> vertices;
 	static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Face(f.dart), [&] (Dart d) -> bool { vertices.push_back(CMap3::Vertex(d)); return true; });
 	return vertices;
 }
 
-std::vector<CMap3::Vertex> incident_vertices(const CMap3& m, CMap3::Volume v)
+SmallVector<CMap3::Vertex, 32u> incident_vertices(const CMap3& m, CMap3::Volume v)
 {
-	std::vector<CMap3::Vertex> vertices;
-	vertices.reserve(32u);
+	SmallVector<CMap3::Vertex, 32u> vertices;
 	foreach_incident_vertex(m, v, [&] (CMap3::Vertex vert) -> bool { vertices.push_back(vert); return true; });
 	return vertices;
 }
@@ -28,6 +28,7 @@
 
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/small_vector.h>
 
 namespace cgogn
 {
@@ -35,7 +36,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename CELL, typename MESH>
-// std::vector<typename mesh_traits<MESH>::Vertex> incident_vertices(const MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Vertex, N> incident_vertices(const MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -43,40 +44,40 @@ namespace cgogn
 // Graph //
 ///////////
 
-std::vector<Graph::Vertex>
+SmallVector<Graph::Vertex, 2u>
 CGOGN_CORE_EXPORT incident_vertices(const Graph& g, Graph::Edge e);
 
 ///////////
 // CMap1 //
 ///////////
 
-std::vector<CMap1::Vertex>
+SmallVector<CMap1::Vertex, 8u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap1& m, CMap1::Face f);
 
 ///////////
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Vertex>
+SmallVector<CMap2::Vertex, 2u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap2& m, CMap2::Edge e);
 
-std::vector<CMap2::Vertex>
+SmallVector<CMap2::Vertex, 16u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap2& m, CMap2::Face f);
 
-std::vector<CMap2::Vertex>
+SmallVector<CMap2::Vertex, 32u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap2& m, CMap2::Volume v);
 
 ///////////
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Vertex>
+SmallVector<CMap3::Vertex, 2u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap3& m, CMap3::Edge e);
 
-std::vector<CMap3::Vertex>
+SmallVector<CMap3::Vertex, 16u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap3& m, CMap3::Face f);
 
-std::vector<CMap3::Vertex>
+SmallVector<CMap3::Vertex, 32u>
 CGOGN_CORE_EXPORT incident_vertices(const CMap3& m, CMap3::Volume v);
 
 //////////////
@@ -85,7 +86,7 @@ CGOGN_CORE_EXPORT incident_vertices(const CMap3& m, CMap3::Volume v);
 
 template <typename CELL, typename MESH,
 		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
-std::vector<typename mesh_traits<MESH>::Vertex>
+auto
 incident_vertices(const MESH& m, CELL c)
 {
 	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
@@ -145,7 +146,10 @@ void foreach_incident_vertex(const CMap2& m, CMap2::Face f, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap2::Vertex>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
-	m.foreach_dart_of_orbit(f, [&] (Dart d) -> bool { return func(CMap2::Vertex(d)); });
+	if (m.is_pure_simplicial() && !m.is_boundary(f.dart))
+		m.foreach_dart_of_triangle(f.dart, [&] (Dart d) -> bool { return func(CMap2::Vertex(d)); });
+	else
+		m.foreach_dart_of_orbit(f, [&] (Dart d) -> bool { return func(CMap2::Vertex(d)); });
 }
 
 template <typename FUNC>
@@ -153,6 +157,14 @@ void foreach_incident_vertex(const CMap2& m, CMap2::Volume v, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap2::Vertex>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (m.is_labeled(PHI1_PHI2))
+	{
+		// each vertex of the volume is reported through the smallest of its darts in the volume
+		m.foreach_sub_orbit_of_labeled_orbit(PHI1_PHI2, v.dart,
+			[&] (Dart d, const auto& f) { m.foreach_dart_of_PHI21(d, f); },
+			[&] (Dart d) -> bool { return func(CMap2::Vertex(d)); });
+		return;
+	}
 	DartMarkerStore marker(m);
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 	{
@@ -182,7 +194,10 @@ void foreach_incident_vertex(const CMap3& m, CMap3::Face f, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap3::Vertex>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
-	static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Face(f.dart), [&] (Dart d) -> bool { return func(CMap3::Vertex(d)); });
+	if (m.is_pure_simplicial() && !m.is_boundary(f.dart))
+		m.foreach_dart_of_triangle(f.dart, [&] (Dart d) -> bool { return func(CMap3::Vertex(d)); });
+	else
+		static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Face(f.dart), [&] (Dart d) -> bool { return func(CMap3::Vertex(d)); });
 }
 
 template <typename FUNC>
@@ -190,6 +205,24 @@ void foreach_incident_vertex(const CMap3& m, CMap3::Volume v, const FUNC& func)
 {
 	static_assert(is_func_parameter_same<FUNC, CMap3::Vertex>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (m.is_pure_simplicial() && !m.is_boundary(v.dart))
+	{
+		// the 3 vertices of the face of v.dart and the opposite one
+		const Dart d = v.dart;
+		const Dart d1 = m.phi1(d);
+		const Dart d_1 = m.phi_1(d);
+		if (func(CMap3::Vertex(d)) && func(CMap3::Vertex(d1)) && func(CMap3::Vertex(d_1)))
+			func(CMap3::Vertex(m.phi_1(m.phi2(d))));
+		return;
+	}
+	if (m.is_labeled(PHI1_PHI2))
+	{
+		// each vertex of the volume is reported through the smallest of its darts in the volume
+		m.foreach_sub_orbit_of_labeled_orbit(PHI1_PHI2, v.dart,
+			[&] (Dart d, const auto& f) { m.foreach_dart_of_PHI21(d, f); },
+			[&] (Dart d) -> bool { return func(CMap3::Vertex(d)); });
+		return;
+	}
 	DartMarkerStore marker(m);
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool
 	{
@@ -245,6 +278,31 @@ foreach_adjacent_vertex_through_edge(const CMap2& m, CMap2::Vertex v, const FUNC
 {
 	static_assert(is_func_parameter_same<FUNC, CMap2::Vertex>::value, "Wrong function cell parameter type");
 	static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+	if (const VertexAdjacency* adjacency = m.vertex_adjacency())
+	{
+		// the row starts at the representative of the vertex: it is rotated to start at v.dart,
+		// whose neighbour is seen through phi2(v.dart), to keep the order of the darts of v
+		const uint32 index = m.index_of(v);
+		const uint32 first = adjacency->offsets[index];
+		const uint32 end = adjacency->offsets[index + 1u];
+		const Dart d2 = m.phi2(v.dart);
+		uint32 start = first;
+		while (start < end && adjacency->neighbor_darts[start] != d2)
+			++start;
+		if (start == end)
+			start = first;
+		for (uint32 i = start; i < end; ++i)
+		{
+			if (!func(CMap2::Vertex(adjacency->neighbor_darts[i])))
+				return;
+		}
+		for (uint32 i = first; i < start; ++i)
+		{
+			if (!func(CMap2::Vertex(adjacency->neighbor_darts[i])))
+				return;
+		}
+		return;
+	}
 	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool { return func(CMap2::Vertex(m.phi2(d))); });
 }
 
@@ -29,7 +29,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename CELL, typename MESH>
-// std::vector<typename mesh_traits<MESH>::Vertex> incident_volumes(const MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Volume, N> incident_volumes(const MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -37,17 +37,17 @@ namespace cgogn
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Volume> incident_volumes(const CMap2& m, CMap2::Vertex v)
+SmallVector<CMap2::Volume, 1u> incident_volumes(const CMap2& m, CMap2::Vertex v)
 {
 	return { CMap2::Volume(v.dart) };
 }
 
-std::vector<CMap2::Volume> incident_volumes(const CMap2& m, CMap2::Edge e)
+SmallVector<CMap2::Volume, 1u> incident_volumes(const CMap2& m, CMap2::Edge e)
 {
 	return { CMap2::Volume(e.dart) };
 }
 
-std::vector<CMap2::Volume> incident_volumes(const CMap2& m, CMap2::Face f)
+SmallVector<CMap2::Volume, 1u> incident_volumes(const CMap2& m, CMap2::Face f)
 {
 	return { CMap2::Volume(f.dart) };
 }
@@ -56,26 +56,23 @@ std::vector<CMap2::Volume> incident_volumes(const CMap2& m, CMap2::Face f)
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Volume> incident_volumes(const CMap3& m, CMap3::Vertex v)
+SmallVector<CMap3::Volume, 32u> incident_volumes(const CMap3& m, CMap3::Vertex v)
 {
-	std::vector<CMap3::Volume> volumes;
-	volumes.reserve(32u);
+	SmallVector<CMap3::Volume, 32u> volumes;
 	foreach_incident_volume(m, v, [&] (CMap3::Volume vol) -> bool { volumes.push_back(vol); return true; });
 	return volumes;
 }
 
-std::vector<CMap3::Volume> incident_volumes(const CMap3& m, CMap3::Edge e)
+SmallVector<CMap3::Volume, 16u> incident_volumes(const CMap3& m, CMap3::Edge e)
 {
-	std::vector<CMap3::Volume> volumes;
-	volumes.reserve(16u);
+	SmallVector<CMap3::Volume, 16u> volumes;
 	foreach_incident_volume(m, e, [&] (CMap3::Volume v) -> bool { volumes.push_back(v); return true; });
 	return volumes;
 }
 
-std::vector<CMap3::Volume> incident_volumes(const CMap3& m, CMap3::Face f)
+SmallVector<CMap3::Volume, 2u> incident_volumes(const CMap3& m, CMap3::Face f)
 {
-	std::vector<CMap3::Volume> volumes;
-	volumes.reserve(2u);
+	SmallVector<CMap3::Volume, 2u> volumes;
 	foreach_incident_volume(m, f, [&] (CMap3::Volume v) -> bool { volumes.push_back(v); return true; });
 	return volumes;
 }
@@ -28,6 +28,7 @@
 
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/utils/type_traits.h>
+#include <cgogn/core/utils/small_vector.h>
 
 namespace cgogn
 {
@@ -35,7 +36,7 @@ namespace cgogn
 /*****************************************************************************/
 
 // template <typename CELL, typename MESH>
-// std::vector<typename mesh_traits<MESH>::Volume> incident_volumes(const MESH& m, CELL c);
+// SmallVector<typename mesh_traits<MESH>::Volume, N> incident_volumes(const MESH& m, CELL c);
 
 /*****************************************************************************/
 
@@ -43,27 +44,27 @@ namespace cgogn
 // CMap2 //
 ///////////
 
-std::vector<CMap2::Volume>
+SmallVector<CMap2::Volume, 1u>
 CGOGN_CORE_EXPORT incident_volumes(const CMap2& m, CMap2::Vertex v);
 
-std::vector<CMap2::Volume>
+SmallVector<CMap2::Volume, 1u>
 CGOGN_CORE_EXPORT incident_volumes(const CMap2& m, CMap2::Edge e);
 
-std::vector<CMap2::Volume>
+SmallVector<CMap2::Volume, 1u>
 CGOGN_CORE_EXPORT incident_volumes(const CMap2& m, CMap2::Face f);
 
 ///////////
 // CMap3 //
 ///////////
 
-std::vector<CMap3::Volume>
+SmallVector<CMap3::Volume, 32u>
 CGOGN_CORE_EXPORT incident_volumes(const CMap3& m, CMap3::Vertex v);
 
-std::vector<CMap3::Volume>
-CGOGN_CORE_EXPORT incident_volumes(const CMap3& m, CMap3::Face f);
+SmallVector<CMap3::Volume, 16u>
+CGOGN_CORE_EXPORT incident_volumes(const CMap3& m, CMap3::Edge e);
 
-std::vector<CMap3::Volume>
-CGOGN_CORE_EXPORT incident_volumes(const CMap3& m, CMap3::Volume v);
+SmallVector<CMap3::Volume, 2u>
+CGOGN_CORE_EXPORT incident_volumes(const CMap3& m, CMap3::Face f);
 
 //////////////
 // MESHVIEW //
@@ -71,7 +72,7 @@ CGOGN_CORE_EXPORT incident_volumes(const CMap3& m, CMap3::Volume v);
 
 template <typename CELL, typename MESH,
 		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
-std::vector<typename mesh_traits<MESH>::Volume>
+auto
 incident_volumes(const MESH& m, CELL c)
 {
 	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
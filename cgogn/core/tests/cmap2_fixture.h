@@ -0,0 +1,91 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_TESTS_CMAP2_FIXTURE_H_
+#define CGOGN_CORE_TESTS_CMAP2_FIXTURE_H_
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/utils/tuples.h>
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace cgogn
+{
+
+// base of the test fixtures built on a CMap2 made of prisms
+class CMap2Fixture : public ::testing::Test
+{
+protected:
+
+	CMap2 map_;
+
+	// indexes the given cells with an attribute named after their type in lower case (e.g. "vertex")
+	template <typename... CELL>
+	void add_cells_attributes()
+	{
+		(add_cell_attribute<CELL>(), ...);
+	}
+
+	// adds nb prisms, the i-th one with size(i) lateral faces
+	template <typename FUNC>
+	void add_prisms(uint32 nb, const FUNC& size)
+	{
+		for (uint32 i = 0u; i < nb; ++i)
+			add_prism(map_, size(i));
+	}
+
+	void add_prisms(uint32 nb, uint32 size)
+	{
+		add_prisms(nb, [&] (uint32) { return size; });
+	}
+
+	// the n-th dart of the map traversal
+	Dart inner_dart(uint32 n = 0u)
+	{
+		Dart d = map_.begin();
+		for (uint32 i = 0u; i < n; ++i)
+			d = map_.next(d);
+		return d;
+	}
+
+private:
+
+	template <typename CELL>
+	void add_cell_attribute()
+	{
+		using Cells = typename mesh_traits<CMap2>::Cells;
+		std::string name = mesh_traits<CMap2>::cell_names[tuple_type_index<CELL, Cells>::value];
+		std::transform(name.begin(), name.end(), name.begin(), [] (char c) { return char(std::tolower(c)); });
+		add_attribute<uint32, CELL>(map_, name);
+	}
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TESTS_CMAP2_FIXTURE_H_
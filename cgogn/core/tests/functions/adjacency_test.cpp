@@ -0,0 +1,177 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/adjacency.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_ops/edge.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+
+#include <vector>
+
+namespace cgogn
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+
+class AdjacencyCSRTest : public CMap2Fixture
+{
+protected:
+
+	void SetUp() override
+	{
+		add_cells_attributes<Vertex, Edge>();
+		// vertices of different degrees, and an open face whose vertices have boundary darts
+		for (uint32 i = 0u; i < 40u; ++i)
+		{
+			CMap2::Volume v = add_prism(map_, 3u + i % 4u);
+			if (i % 2u == 0u)
+				cut_face(map_, Vertex(v.dart), Vertex(map_.phi1(map_.phi1(v.dart))));
+		}
+		add_face(map_, 5u);
+	}
+
+	// the darts of the adjacent vertices reported from each dart of the map, in their order
+	std::vector<std::vector<Dart>> adjacent_vertices()
+	{
+		std::vector<std::vector<Dart>> adjacent;
+		map_.foreach_dart([&] (Dart d) -> bool
+		{
+			std::vector<Dart>& a = adjacent.emplace_back();
+			foreach_adjacent_vertex_through_edge(map_, Vertex(d), [&] (Vertex v) -> bool
+			{
+				a.push_back(v.dart);
+				return true;
+			});
+			return true;
+		});
+		return adjacent;
+	}
+};
+
+TEST_F(AdjacencyCSRTest, same_traversals)
+{
+	const std::vector<std::vector<Dart>> expected = adjacent_vertices();
+
+	build_adjacency_csr(map_, true);
+	const VertexAdjacency* adjacency = map_.vertex_adjacency();
+	ASSERT_NE(adjacency, nullptr);
+	EXPECT_TRUE(adjacency->has_edges());
+	// the rows are rotated to start at the given dart of the vertex
+	EXPECT_EQ(adjacent_vertices(), expected);
+
+	uint32 nb_errors = 0u;
+	map_.foreach_dart([&] (Dart d) -> bool
+	{
+		const uint32 v = index_of(map_, Vertex(d));
+		uint32 nb_found = 0u;
+		for (uint32 i = adjacency->offsets[v], end = adjacency->offsets[v + 1u]; i < end; ++i)
+		{
+			if (adjacency->neighbor_darts[i] != map_.phi2(d))
+				continue;
+			++nb_found;
+			if (adjacency->neighbors[i] != index_of(map_, Vertex(map_.phi2(d))) ||
+				adjacency->edges[i] != index_of(map_, Edge(d)))
+				++nb_errors;
+		}
+		if (nb_found != 1u)
+			++nb_errors;
+		return true;
+	});
+	EXPECT_EQ(nb_errors, 0u);
+
+	uint32 n = 0u;
+	foreach_adjacent_vertex_through_edge(map_, Vertex(map_.phi1(map_.begin())), [&] (Vertex) -> bool
+	{
+		return ++n < 2u;
+	});
+	EXPECT_EQ(n, 2u);
+}
+
+TEST_F(AdjacencyCSRTest, outdated)
+{
+	build_adjacency_csr(map_);
+	ASSERT_NE(map_.vertex_adjacency(), nullptr);
+	EXPECT_FALSE(map_.vertex_adjacency()->has_edges());
+
+	// a change of the topology outdates the snapshot, the traversals then use the darts
+	Dart d = map_.begin();
+	while (map_.is_boundary(d) || map_.is_boundary(map_.phi2(d)))
+		d = map_.next(d);
+	cut_edge(map_, Edge(d));
+	EXPECT_EQ(map_.vertex_adjacency(), nullptr);
+	const std::vector<std::vector<Dart>> expected = adjacent_vertices();
+
+	build_adjacency_csr(map_);
+	ASSERT_NE(map_.vertex_adjacency(), nullptr);
+	EXPECT_EQ(adjacent_vertices(), expected);
+
+	clear_adjacency_csr(map_);
+	EXPECT_EQ(map_.vertex_adjacency(), nullptr);
+}
+
+TEST_F(AdjacencyCSRTest, kept_while_unchanged)
+{
+	build_adjacency_csr(map_);
+	const VertexAdjacency* adjacency = map_.vertex_adjacency();
+	ASSERT_NE(adjacency, nullptr);
+
+	// the snapshot is kept through the changes that do not concern the vertices
+	Dart boundary = map_.begin();
+	while (!map_.is_boundary(boundary))
+		boundary = map_.next(boundary);
+	map_.set_boundary(boundary, true);
+	map_.set_boundary(map_.phi2(boundary), false);
+	auto vertex_attribute = get_attribute<uint32, Vertex>(map_, "vertex");
+	(*vertex_attribute)[index_of(map_, Vertex(boundary))] = 1u;
+	vertex_attribute->set_modified();
+	new_index<Edge>(map_);
+	EXPECT_EQ(map_.vertex_adjacency(), adjacency);
+
+	// with the edges, it is outdated by a new edge index
+	build_adjacency_csr(map_, true);
+	adjacency = map_.vertex_adjacency();
+	ASSERT_NE(adjacency, nullptr);
+	new_index<Edge>(map_);
+	EXPECT_EQ(map_.vertex_adjacency(), nullptr);
+
+	// and by a new vertex index or a change of the index of a vertex
+	build_adjacency_csr(map_);
+	ASSERT_NE(map_.vertex_adjacency(), nullptr);
+	const uint32 index = new_index<Vertex>(map_);
+	EXPECT_EQ(map_.vertex_adjacency(), nullptr);
+	build_adjacency_csr(map_);
+	ASSERT_NE(map_.vertex_adjacency(), nullptr);
+	set_index(map_, Vertex(boundary), index);
+	EXPECT_EQ(map_.vertex_adjacency(), nullptr);
+}
+
+} // namespace cgogn
@@ -0,0 +1,97 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+
+namespace cgogn
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+using Face = CMap2::Face;
+using Volume = CMap2::Volume;
+
+// checks that the darts of the map form a closed surface
+static bool is_closed(const CMap2& m)
+{
+	bool closed = true;
+	m.foreach_dart([&] (Dart d) -> bool
+	{
+		closed = m.phi2(d) != d && m.phi2(m.phi2(d)) == d && !m.is_boundary(d);
+		return closed;
+	});
+	return closed;
+}
+
+TEST(MeshOpsVolumeTest, add_prism)
+{
+	for (uint32 size : { 3u, 4u, 5u })
+	{
+		CMap2 m;
+		add_attribute<uint32, Vertex>(m, "vertex");
+		add_attribute<uint32, Edge>(m, "edge");
+		add_attribute<uint32, Face>(m, "face");
+		add_attribute<uint32, Volume>(m, "volume");
+
+		Volume vol = add_prism(m, size);
+
+		EXPECT_EQ(m.nb_darts(), 6u * size);
+		EXPECT_TRUE(is_closed(m));
+		EXPECT_EQ(nb_cells<Vertex>(m), 2u * size);
+		EXPECT_EQ(nb_cells<Edge>(m), 3u * size);
+		EXPECT_EQ(nb_cells<Face>(m), size + 2u);
+		EXPECT_EQ(nb_cells<Volume>(m), 1u);
+		EXPECT_EQ(codegree(m, vol), size + 2u);
+		// the returned dart is on the base, whose vertices all have degree 3
+		EXPECT_EQ(codegree(m, Face(vol.dart)), size);
+		foreach_cell(m, [&] (Vertex v) -> bool
+		{
+			EXPECT_EQ(degree(m, v), 3u);
+			return true;
+		});
+	}
+}
+
+TEST(MeshOpsVolumeTest, add_prism_without_indices)
+{
+	CMap2 m;
+	add_attribute<uint32, Vertex>(m, "vertex");
+
+	add_prism(m, 4u, false);
+
+	EXPECT_EQ(m.nb_darts(), 24u);
+	EXPECT_TRUE(is_closed(m));
+	m.foreach_dart([&] (Dart d) -> bool
+	{
+		EXPECT_EQ(index_of(m, Vertex(d)), INVALID_INDEX);
+		return true;
+	});
+}
+
+} // namespace cgogn
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/global.h>
+
+#include <atomic>
+#include <vector>
+
+namespace cgogn
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+using Face = CMap2::Face;
+
+class ParallelTraversalTest : public CMap2Fixture
+{
+protected:
+
+	void SetUp() override
+	{
+		// closed volumes and faces with a boundary, on enough darts for several ranges
+		for (uint32 i = 0u; i < 500u; ++i)
+		{
+			add_prism(map_, 5u);
+			add_face(map_, 4u);
+		}
+	}
+
+	// checks that the given traversal calls its function exactly once on each cell
+	template <typename CELL, typename TRAVERSAL>
+	void check_each_cell_once(const TRAVERSAL& traversal)
+	{
+		// the cells are numbered by a sequential traversal
+		std::vector<uint32> cell_of_dart(map_.nb_darts(), INVALID_INDEX);
+		uint32 nb = 0u;
+		foreach_cell(map_, [&] (CELL c) -> bool
+		{
+			map_.foreach_dart_of_orbit(c, [&] (Dart d) -> bool { cell_of_dart[d.index] = nb; return true; });
+			++nb;
+			return true;
+		});
+		EXPECT_EQ(nb, nb_cells<CELL>(map_));
+
+		std::vector<std::atomic<uint32>> visits(nb);
+		for (auto& v : visits)
+			v = 0u;
+		traversal([&] (CELL c) -> bool
+		{
+			EXPECT_FALSE(map_.is_boundary(c.dart));
+			++visits[cell_of_dart[c.dart.index]];
+			return true;
+		});
+
+		uint32 nb_errors = 0u;
+		for (auto& v : visits)
+			if (v != 1u)
+				++nb_errors;
+		EXPECT_EQ(nb_errors, 0u);
+	}
+};
+
+TEST_F(ParallelTraversalTest, parallel_foreach_indexed_cell)
+{
+	// the indices are scanned in ranges
+	add_attribute<uint32, Vertex>(map_, "vertex");
+	add_attribute<uint32, Face>(map_, "face");
+	check_each_cell_once<Vertex>([&] (const auto& f) { parallel_foreach_cell(map_, f); });
+	check_each_cell_once<Face>([&] (const auto& f) { parallel_foreach_cell(map_, f); });
+}
+
+TEST_F(ParallelTraversalTest, parallel_foreach_cell_dart_ranges)
+{
+	// the cells are owned by the range of their smallest non boundary dart
+	check_each_cell_once<Edge>([&] (const auto& f) { parallel_foreach_cell(map_, f, true); });
+	check_each_cell_once<Face>([&] (const auto& f) { parallel_foreach_cell(map_, f, true); });
+}
+
+TEST_F(ParallelTraversalTest, parallel_reduce_cells)
+{
+	const uint32 nb_faces = parallel_reduce_cells<Face>(map_, 0u,
+		[] (Face) -> uint32 { return 1u; },
+		[] (uint32 a, uint32 b) -> uint32 { return a + b; }
+	);
+	EXPECT_EQ(nb_faces, 500u * 7u + 500u);
+	const uint32 nb_darts = parallel_reduce_cells<Face>(map_, 0u,
+		[&] (Face f) -> uint32 { return codegree(map_, f); },
+		[] (uint32 a, uint32 b) -> uint32 { return a + b; }
+	);
+	EXPECT_EQ(nb_darts, 500u * 30u + 500u * 4u);
+}
+
+} // namespace cgogn
@@ -0,0 +1,211 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_ops/edge.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cgogn
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+using Face = CMap2::Face;
+using Volume = CMap2::Volume;
+
+class CellsJournalTest : public CMap2Fixture
+{
+protected:
+
+	void SetUp() override
+	{
+		add_cells_attributes<Vertex, Edge, Face, Volume>();
+		add_prisms(20u, 4u);
+	}
+
+	// the sorted indices of the journaled cells (each cell has to be visited once)
+	template <typename CELL>
+	std::vector<uint32> journaled_cells()
+	{
+		std::vector<uint32> cells;
+		foreach_journaled_cell(map_, [&] (CELL c) -> bool
+		{
+			cells.push_back(index_of(map_, c));
+			return true;
+		});
+		std::sort(cells.begin(), cells.end());
+		EXPECT_EQ(std::adjacent_find(cells.begin(), cells.end()), cells.end());
+		return cells;
+	}
+
+	template <typename CELL>
+	std::vector<uint32> incident_cells(Vertex v)
+	{
+		std::vector<uint32> cells;
+		foreach_incident_face(map_, v, [&] (CELL c) -> bool
+		{
+			cells.push_back(index_of(map_, c));
+			return true;
+		});
+		std::sort(cells.begin(), cells.end());
+		return cells;
+	}
+
+	static bool includes(const std::vector<uint32>& a, const std::vector<uint32>& b)
+	{
+		return std::includes(a.begin(), a.end(), b.begin(), b.end());
+	}
+};
+
+TEST_F(CellsJournalTest, cut_edge)
+{
+	map_.enable_journal();
+	EXPECT_TRUE(journaled_cells<Face>().empty());
+
+	Vertex v = cut_edge(map_, Edge(inner_dart()));
+	const CellsJournal* journal = map_.journal();
+	ASSERT_TRUE(journal->complete);
+	// the two faces of the cut edge, the new vertex and the ends of the edge
+	EXPECT_EQ(journaled_cells<Face>(), incident_cells<Face>(v));
+	std::vector<uint32> vertices = { index_of(map_, v) };
+	foreach_adjacent_vertex_through_edge(map_, v, [&] (Vertex w) -> bool
+	{
+		vertices.push_back(index_of(map_, w));
+		return true;
+	});
+	std::sort(vertices.begin(), vertices.end());
+	EXPECT_EQ(journaled_cells<Vertex>(), vertices);
+	EXPECT_EQ(journal->created_cells[Vertex::ORBIT], std::vector<uint32>{ index_of(map_, v) });
+	EXPECT_EQ(journal->created_cells[Edge::ORBIT].size(), 1u);
+	EXPECT_TRUE(journal->created_cells[Face::ORBIT].empty());
+}
+
+TEST_F(CellsJournalTest, collapse_edge)
+{
+	// (an edge of a cube: its two faces become triangles)
+	Dart d = inner_dart();
+	std::vector<uint32> faces = { index_of(map_, Face(d)), index_of(map_, Face(map_.phi2(d))) };
+	std::sort(faces.begin(), faces.end());
+	map_.enable_journal();
+
+	Vertex v = collapse_edge(map_, Edge(d));
+	const CellsJournal* journal = map_.journal();
+	ASSERT_TRUE(journal->complete);
+	// the faces of the collapsed edge and the merged vertex
+	// (the other faces around the vertex keep their vertices)
+	EXPECT_TRUE(includes(journaled_cells<Face>(), faces));
+	EXPECT_TRUE(includes(journaled_cells<Vertex>(), { index_of(map_, v) }));
+	EXPECT_EQ(journal->removed_cells[Vertex::ORBIT].size(), 1u);
+	EXPECT_EQ(journal->removed_cells[Edge::ORBIT].size(), 1u);
+}
+
+TEST_F(CellsJournalTest, cut_face)
+{
+	Dart d = inner_dart();
+	map_.enable_journal();
+
+	Edge e = cut_face(map_, Vertex(d), Vertex(map_.phi1(map_.phi1(d))));
+	const CellsJournal* journal = map_.journal();
+	ASSERT_TRUE(journal->complete);
+	// the two faces of the new edge, and only them
+	std::vector<uint32> faces = { index_of(map_, Face(e.dart)), index_of(map_, Face(map_.phi2(e.dart))) };
+	std::sort(faces.begin(), faces.end());
+	EXPECT_EQ(journaled_cells<Face>(), faces);
+	EXPECT_EQ(journal->created_cells[Face::ORBIT].size(), 1u);
+	EXPECT_EQ(journal->created_cells[Edge::ORBIT], std::vector<uint32>{ index_of(map_, e) });
+	EXPECT_TRUE(journal->created_cells[Vertex::ORBIT].empty());
+	// the geometry changes are recorded explicitly
+	Vertex far(inner_dart(100u));
+	journal_cell(map_, far);
+	EXPECT_TRUE(includes(journaled_cells<Face>(), incident_cells<Face>(far)));
+}
+
+TEST_F(CellsJournalTest, checkpoints)
+{
+	map_.enable_journal();
+	const uint64 epoch = map_.journal()->epoch;
+	cut_edge(map_, Edge(inner_dart()));
+	EXPECT_FALSE(map_.journal()->darts.empty());
+
+	map_.checkpoint_journal();
+	EXPECT_NE(map_.journal()->epoch, epoch);
+	EXPECT_TRUE(map_.journal()->complete);
+	EXPECT_TRUE(map_.journal()->darts.empty());
+	EXPECT_TRUE(journaled_cells<Face>().empty());
+
+	// the changes that are not recorded dart by dart make the journal incomplete
+	map_.compact_cells<Vertex>();
+	EXPECT_FALSE(map_.journal()->complete);
+	EXPECT_TRUE(map_.journal()->darts.empty());
+	cut_edge(map_, Edge(inner_dart()));
+	EXPECT_TRUE(map_.journal()->darts.empty());
+
+	map_.disable_journal();
+	EXPECT_EQ(map_.journal(), nullptr);
+	cut_edge(map_, Edge(inner_dart()));
+	map_.enable_journal();
+	EXPECT_TRUE(map_.journal()->complete);
+	EXPECT_TRUE(map_.journal()->darts.empty());
+}
+
+TEST_F(CellsJournalTest, overflow)
+{
+	// the journal is made incomplete once it has more records than the map has darts
+	map_.enable_journal();
+	const uint64 epoch = map_.journal()->epoch;
+	uint32 nb_cuts = 0u;
+	while (map_.journal()->complete)
+	{
+		ASSERT_LE(map_.journal()->darts.size(), map_.topology_.maximum_index());
+		cut_edge(map_, Edge(inner_dart(nb_cuts++)));
+	}
+	EXPECT_GT(nb_cuts, 1u);
+	EXPECT_EQ(map_.journal()->epoch, epoch);
+	EXPECT_TRUE(map_.journal()->darts.empty());
+	for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		EXPECT_TRUE(map_.journal()->created_cells[orbit].empty());
+
+	// nothing more is recorded until the next checkpoint
+	cut_edge(map_, Edge(inner_dart()));
+	journal_cell(map_, Vertex(inner_dart()));
+	EXPECT_TRUE(map_.journal()->darts.empty());
+	map_.checkpoint_journal();
+	EXPECT_TRUE(map_.journal()->complete);
+	cut_edge(map_, Edge(inner_dart()));
+	EXPECT_FALSE(map_.journal()->darts.empty());
+}
+
+} // namespace cgogn
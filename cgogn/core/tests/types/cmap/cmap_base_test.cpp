@@ -0,0 +1,527 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap1.h>
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/types/cmap/cmap3.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/edge.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/edge.h>
+#include <cgogn/core/functions/traversals/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace cgogn
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+using Face = CMap2::Face;
+using Volume = CMap2::Volume;
+
+class CellsRepresentativesTest : public CMap2Fixture
+{
+protected:
+
+	void SetUp() override
+	{
+		add_cells_attributes<Vertex, Edge, Face, Volume>();
+		add_prisms(20u, 4u);
+	}
+
+	// the counts match a traversal that marks the darts and each representative is a non boundary dart of its cell
+	template <typename CELL>
+	void check_representatives()
+	{
+		uint32 nb = 0u;
+		foreach_cell(map_, [&] (CELL) -> bool { ++nb; return true; }, true);
+		EXPECT_EQ(nb_cells<CELL>(map_), nb);
+
+		const CMap2::Attribute<Dart>& representatives = map_.cells_representatives<CELL>();
+		uint32 nb_represented = 0u;
+		uint32 nb_errors = 0u;
+		map_.attribute_containers_[CELL::ORBIT].foreach_live_index([&] (uint32 i) -> bool
+		{
+			const Dart d = representatives[i];
+			if (d.is_nil())
+				return true;
+			++nb_represented;
+			if (!map_.is_live_dart(d) || map_.is_boundary(d) || index_of(map_, CELL(d)) != i)
+				++nb_errors;
+			return true;
+		});
+		EXPECT_EQ(nb_represented, nb);
+		EXPECT_EQ(nb_errors, 0u);
+	}
+
+	void check_all_representatives()
+	{
+		check_representatives<Vertex>();
+		check_representatives<Edge>();
+		check_representatives<Face>();
+		check_representatives<Volume>();
+	}
+};
+
+TEST_F(CellsRepresentativesTest, new_cells)
+{
+	check_all_representatives();
+
+	// the new cells are counted as their darts get their indices, without rescanning the map
+	// (add_face does not index the volume of the new face)
+	Face f = add_face(map_, 5u);
+	set_index(map_, Volume(f.dart), new_index<Volume>(map_));
+	add_prism(map_, 3u);
+	std::vector<Edge> edges;
+	// (the boundary faces have no index to copy on the cut of a boundary edge)
+	foreach_cell(map_, [&] (Edge e) -> bool {
+		if (!map_.is_boundary(e.dart) && !map_.is_boundary(map_.phi2(e.dart)))
+			edges.push_back(e);
+		return true;
+	});
+	for (Edge e : edges)
+		cut_edge(map_, e);
+	for (Orbit orbit : { Vertex::ORBIT, Edge::ORBIT, Face::ORBIT })
+		EXPECT_FALSE(map_.cells_representatives_outdated_[orbit].load());
+	EXPECT_EQ(nb_cells<Vertex>(map_), 20u * 8u + 5u + 6u + uint32(edges.size()));
+	check_all_representatives();
+}
+
+TEST_F(CellsRepresentativesTest, removed_darts)
+{
+	// cut the quads in triangles and collapse some edges
+	std::vector<Face> faces;
+	foreach_cell(map_, [&] (Face f) -> bool { faces.push_back(f); return true; });
+	for (Face f : faces)
+		cut_face(map_, Vertex(f.dart), Vertex(map_.phi1(map_.phi1(f.dart))));
+	check_all_representatives();
+
+	for (uint32 k = 0u; k < 30u; ++k)
+	{
+		Edge selected;
+		uint32 i = 0u;
+		foreach_cell(map_, [&] (Edge e) -> bool
+		{
+			if (++i > 7u * k && edge_can_collapse(map_, e))
+			{
+				selected = e;
+				return false;
+			}
+			return true;
+		}, true);
+		if (!selected.dart.is_nil())
+			collapse_edge(map_, selected);
+	}
+	check_all_representatives();
+}
+
+TEST_F(CellsRepresentativesTest, boundary_and_compaction)
+{
+	Face f = add_face(map_, 4u);
+	set_index(map_, Volume(f.dart), new_index<Volume>(map_));
+	// the boundary darts are not representatives
+	map_.close();
+	check_all_representatives();
+
+	std::vector<Edge> edges;
+	foreach_cell(map_, [&] (Edge e) -> bool { edges.push_back(e); return true; });
+	for (uint32 i = 0u; i < edges.size(); i += 3u)
+	{
+		if (map_.is_live_dart(edges[i].dart) && edge_can_collapse(map_, edges[i]))
+			collapse_edge(map_, edges[i]);
+	}
+	map_.compact_topology();
+	check_all_representatives();
+	map_.compact_cells<Vertex>();
+	map_.compact_cells<Face>();
+	check_all_representatives();
+}
+
+TEST_F(CellsRepresentativesTest, versions)
+{
+	Face f = add_face(map_, 4u);
+	set_index(map_, Volume(f.dart), new_index<Volume>(map_));
+	Dart boundary = map_.begin();
+	while (!map_.is_boundary(boundary))
+		boundary = map_.next(boundary);
+
+	const uint64 connectivity = map_.connectivity_version();
+	const uint64 vertices = map_.cells_version(Vertex::ORBIT);
+	const uint64 edges = map_.cells_version(Edge::ORBIT);
+	EXPECT_EQ(map_.cells_version(Vertex::ORBIT), vertices);
+
+	// setting unchanged boundary marks changes nothing
+	map_.set_boundary(boundary, true);
+	map_.set_boundary(map_.phi2(boundary), false);
+	EXPECT_EQ(map_.connectivity_version(), connectivity);
+	EXPECT_EQ(map_.cells_version(Vertex::ORBIT), vertices);
+	EXPECT_EQ(map_.cells_version(Edge::ORBIT), edges);
+
+	// the changes of the indices of an orbit only change the version of its cells
+	const uint32 index = new_index<Vertex>(map_);
+	const uint64 new_index_vertices = map_.cells_version(Vertex::ORBIT);
+	EXPECT_NE(new_index_vertices, vertices);
+	EXPECT_EQ(map_.cells_version(Edge::ORBIT), edges);
+	EXPECT_EQ(map_.connectivity_version(), connectivity);
+
+	set_index(map_, Vertex(map_.phi2(boundary)), index);
+	EXPECT_NE(map_.cells_version(Vertex::ORBIT), new_index_vertices);
+	EXPECT_EQ(map_.cells_version(Edge::ORBIT), edges);
+	EXPECT_EQ(map_.connectivity_version(), connectivity);
+
+	// a change of the topology changes the version of all the cells
+	const uint64 set_index_vertices = map_.cells_version(Vertex::ORBIT);
+	Dart d = map_.begin();
+	while (map_.is_boundary(d) || map_.is_boundary(map_.phi2(d)))
+		d = map_.next(d);
+	cut_edge(map_, Edge(d));
+	EXPECT_NE(map_.connectivity_version(), connectivity);
+	EXPECT_NE(map_.cells_version(Vertex::ORBIT), set_index_vertices);
+	EXPECT_NE(map_.cells_version(Edge::ORBIT), edges);
+	check_all_representatives();
+}
+
+TEST_F(CellsRepresentativesTest, attribute_versions)
+{
+	auto position = add_attribute<float64, Vertex>(map_, "position");
+	auto other = add_attribute<float64, Vertex>(map_, "other");
+	const uint64 version = position->version();
+	EXPECT_NE(other->version(), version);
+
+	// the writes are only signaled by set_modified
+	foreach_cell(map_, [&] (Vertex v) -> bool { value<float64>(map_, position, v) = 1.0; return true; });
+	EXPECT_EQ(position->version(), version);
+	position->set_modified();
+	const uint64 modified = position->version();
+	EXPECT_NE(modified, version);
+	EXPECT_NE(other->version(), modified);
+
+	// the creation or the move of the elements changes the version of all the attributes of the container
+	const uint64 other_version = other->version();
+	new_index<Vertex>(map_);
+	EXPECT_NE(position->version(), modified);
+	EXPECT_NE(other->version(), other_version);
+	const uint64 created = position->version();
+	map_.compact_cells<Vertex>();
+	EXPECT_NE(position->version(), created);
+
+	// the attributes of the other containers are unchanged
+	auto edge_attribute = add_attribute<float64, Edge>(map_, "edge_attribute");
+	const uint64 edge_version = edge_attribute->version();
+	new_index<Vertex>(map_);
+	EXPECT_EQ(edge_attribute->version(), edge_version);
+}
+
+TEST(CMapBaseTest, foreach_dart_removing_darts)
+{
+	// the darts removed by the traversal are not visited, in the same word of the occupancy bitmap or not
+	CMap2 m;
+	const Dart first = m.add_dart();
+	for (uint32 i = 1u; i < 200u; ++i)
+		m.add_dart();
+	std::vector<uint32> visited;
+	m.foreach_dart([&] (Dart d) -> bool
+	{
+		visited.push_back(d.index);
+		for (uint32 i : { d.index + 1u, d.index + 2u, d.index + 70u })
+		{
+			if (i < first.index + 200u && m.is_live_dart(Dart(i)))
+				m.remove_dart(Dart(i));
+		}
+		return true;
+	});
+	std::vector<uint32> expected;
+	for (uint32 i = first.index; i < first.index + 200u; ++i)
+	{
+		if (m.is_live_dart(Dart(i)))
+			expected.push_back(i);
+	}
+	EXPECT_EQ(visited, expected);
+	EXPECT_LT(visited.size(), 100u);
+}
+
+TEST(CMapBaseTest, add_darts)
+{
+	CMap2 m;
+	add_attribute<uint32, Vertex>(m, "vertex");
+	add_face(m, 3u);
+	const uint32 nb_vertices = nb_cells<Vertex>(m);
+
+	// the darts are fixed points of the relations and have no cells indices
+	const Dart first = m.add_darts(100u);
+	EXPECT_EQ(m.nb_darts(), 106u);
+	uint32 nb_errors = 0u;
+	for (uint32 i = first.index; i < first.index + 100u; ++i)
+	{
+		const Dart d(i);
+		nb_errors += !m.is_live_dart(d) || m.phi1(d) != d || m.phi_1(d) != d || m.phi2(d) != d ||
+					 index_of(m, Vertex(d)) != INVALID_INDEX;
+	}
+	EXPECT_EQ(nb_errors, 0u);
+
+	const uint32 first_vertex = new_indices<Vertex>(m, 10u);
+	EXPECT_EQ(first_vertex, nb_vertices);
+	EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].nb_elements(), nb_vertices + 10u);
+}
+
+TEST(CMapBaseTest, add_face_reuses_darts)
+{
+	// adding and removing faces of different sizes does not grow the topology
+	CMap1 m;
+	add_attribute<uint32, CMap1::Vertex>(m, "vertex");
+	std::vector<CMap1::Face> faces;
+	for (uint32 i = 0u; i < 10u; ++i)
+		faces.push_back(add_face(m, 3u + i % 4u));
+	const uint32 maximum_index = m.topology_.maximum_index();
+	for (uint32 i = 0u; i < 1000u; ++i)
+	{
+		remove_face(m, faces[i % 10u]);
+		faces[i % 10u] = add_face(m, 3u + (i * 7u) % 4u);
+	}
+	EXPECT_LE(m.topology_.maximum_index(), maximum_index + 6u);
+	EXPECT_LE(m.attribute_containers_[CMap1::Vertex::ORBIT].maximum_index(), maximum_index + 6u);
+
+	uint32 nb_errors = 0u;
+	for (CMap1::Face f : faces)
+	{
+		uint32 size = 0u;
+		m.foreach_dart_of_orbit(f, [&] (Dart) -> bool { ++size; return true; });
+		nb_errors += size < 3u || size > 6u;
+	}
+	EXPECT_EQ(nb_errors, 0u);
+}
+
+// adds 3 triangles sewn around a vertex and returns the darts of their free edges
+template <typename MESH>
+static std::array<Dart, 3> add_umbrella(MESH& m)
+{
+	std::array<Dart, 3> rim;
+	for (uint32 i = 0u; i < 3u; ++i)
+		rim[i] = add_face(static_cast<CMap1&>(m), 3u, false).dart;
+	for (uint32 i = 0u; i < 3u; ++i)
+		m.phi2_sew(m.phi_1(rim[i]), m.phi1(rim[(i + 1u) % 3u]));
+	return rim;
+}
+
+// sews two umbrellas of triangles into a closed triangular bipyramid
+template <typename MESH>
+static Dart add_bipyramid(MESH& m)
+{
+	std::array<Dart, 3> a = add_umbrella(m);
+	std::array<Dart, 3> b = add_umbrella(m);
+	for (uint32 i = 0u; i < 3u; ++i)
+		m.phi2_sew(a[i], b[(3u - i) % 3u]);
+	return a[0];
+}
+
+TEST(CMapBaseTest, pure_simplicial_phi2_sewing)
+{
+	// in a CMap2, the sewn triangles are still triangles
+	CMap2 m2;
+	m2.set_pure_simplicial(true);
+	add_bipyramid(m2);
+	EXPECT_TRUE(m2.is_pure_simplicial());
+
+	// in a CMap3, the volume made of 6 triangles is not a tetrahedron
+	CMap3 m3;
+	m3.set_pure_simplicial(true);
+	CMap3::Volume v(add_bipyramid(m3));
+	EXPECT_FALSE(m3.is_pure_simplicial());
+	EXPECT_EQ(codegree(m3, v), 6u);
+	EXPECT_FALSE(check_pure_simplicial(m3));
+
+	m3.set_pure_simplicial(true);
+	m3.phi2_unsew(v.dart);
+	EXPECT_FALSE(m3.is_pure_simplicial());
+}
+
+// the sorted ids of the vertices of each face, the list sorted
+static std::vector<std::vector<uint32>> faces_vertices(const CMap2& m, const CMap2::Attribute<uint32>* vertex_id)
+{
+	std::vector<std::vector<uint32>> faces;
+	foreach_cell(m, [&] (Face f) -> bool
+	{
+		std::vector<uint32> vertices;
+		foreach_incident_vertex(m, f, [&] (Vertex v) -> bool
+		{
+			vertices.push_back(value<uint32>(m, vertex_id, v));
+			return true;
+		});
+		std::sort(vertices.begin(), vertices.end());
+		faces.push_back(vertices);
+		return true;
+	});
+	std::sort(faces.begin(), faces.end());
+	return faces;
+}
+
+TEST(CMapBaseTest, compact_topology)
+{
+	CMap2 m;
+	auto vertex_id = add_attribute<uint32, Vertex>(m, "vertex_id");
+	add_attribute<uint32, Face>(m, "face");
+	std::vector<Volume> prisms;
+	for (uint32 i = 0u; i < 50u; ++i)
+		prisms.push_back(add_prism(m, 4u));
+	uint32 n = 0u;
+	foreach_cell(m, [&] (Vertex v) -> bool { value<uint32>(m, vertex_id, v) = n++; return true; });
+
+	// collapsing edges releases darts and vertices in the middle of their containers
+	for (uint32 i = 0u; i < 50u; i += 3u)
+		collapse_edge(m, Edge(prisms[i].dart));
+	const uint32 nb_darts = m.nb_darts();
+	const uint32 nb_vertices = nb_cells<Vertex>(m);
+	ASSERT_LT(nb_darts, m.topology_.maximum_index());
+	const std::vector<std::vector<uint32>> faces = faces_vertices(m, vertex_id.get());
+
+	m.compact_topology();
+	m.compact_cells<Vertex>();
+	EXPECT_EQ(m.topology_.maximum_index(), nb_darts);
+	EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].maximum_index(), nb_vertices);
+
+	// the relations and the cells indices are remapped
+	uint32 nb_errors = 0u;
+	m.foreach_dart([&] (Dart d) -> bool
+	{
+		nb_errors += m.phi1(m.phi_1(d)) != d || m.phi2(m.phi2(d)) != d ||
+					 index_of(m, Vertex(d)) != index_of(m, Vertex(m.phi1(m.phi2(d)))) ||
+					 index_of(m, Vertex(d)) >= nb_vertices;
+		return true;
+	});
+	EXPECT_EQ(nb_errors, 0u);
+	EXPECT_EQ(faces_vertices(m, vertex_id.get()), faces);
+}
+
+// the darts and the incident cells of a volume, each list sorted
+struct VolumeContent
+{
+	std::vector<uint32> darts, vertices, edges, faces;
+};
+
+static VolumeContent volume_content(const CMap2& m, Volume v)
+{
+	VolumeContent c;
+	m.foreach_dart_of_orbit(v, [&] (Dart d) -> bool { c.darts.push_back(d.index); return true; });
+	foreach_incident_vertex(m, v, [&] (Vertex x) -> bool { c.vertices.push_back(index_of(m, x)); return true; });
+	foreach_incident_edge(m, v, [&] (Edge x) -> bool { c.edges.push_back(index_of(m, x)); return true; });
+	foreach_incident_face(m, v, [&] (Face x) -> bool { c.faces.push_back(index_of(m, x)); return true; });
+	for (std::vector<uint32>* l : { &c.darts, &c.vertices, &c.edges, &c.faces })
+		std::sort(l->begin(), l->end());
+	return c;
+}
+
+TEST_F(CellsRepresentativesTest, label_orbits)
+{
+	// volumes of different sizes, some of them with cut faces, and an open face
+	for (uint32 i = 0u; i < 30u; ++i)
+	{
+		Volume v = i % 2u == 0u ? add_prism(map_, 3u + i % 5u) : add_pyramid(map_, 3u + i % 4u);
+		if (i % 3u == 0u)
+			cut_face(map_, Vertex(v.dart), Vertex(map_.phi1(map_.phi1(v.dart))));
+	}
+	Face f = add_face(map_, 6u);
+	set_index(map_, Volume(f.dart), new_index<Volume>(map_));
+
+	std::vector<Volume> volumes;
+	std::vector<VolumeContent> contents;
+	foreach_cell(map_, [&] (Volume v) -> bool
+	{
+		volumes.push_back(v);
+		contents.push_back(volume_content(map_, v));
+		return true;
+	});
+
+	map_.label_volumes();
+	ASSERT_TRUE(map_.is_labeled(PHI1_PHI2));
+	EXPECT_EQ(map_.nb_labels(PHI1_PHI2), uint32(volumes.size()));
+
+	// each dart is at its rank in the darts of its labeled volume
+	const std::vector<uint32>& offsets = map_.orbits_offsets_[PHI1_PHI2];
+	const std::vector<Dart>& darts = map_.orbits_darts_[PHI1_PHI2];
+	uint32 nb_misplaced = 0u;
+	map_.foreach_dart([&] (Dart d) -> bool
+	{
+		const uint32 l = (*map_.orbits_labels_[PHI1_PHI2])[d.index];
+		if (darts[offsets[l] + (*map_.orbits_positions_[PHI1_PHI2])[d.index]] != d)
+			++nb_misplaced;
+		return true;
+	});
+	EXPECT_EQ(nb_misplaced, 0u);
+
+	// the labeled traversals start at the given dart and report the same cells once each,
+	// the vertices and faces through their smallest dart (as in a CMap3), in increasing order
+	auto smallest_dart = [&] (auto c) -> Dart
+	{
+		Dart s = c.dart;
+		map_.foreach_dart_of_orbit(c, [&] (Dart d) -> bool { s = d.index < s.index ? d : s; return true; });
+		return s;
+	};
+	for (uint32 i = 0u; i < volumes.size(); ++i)
+	{
+		Dart first;
+		map_.foreach_dart_of_orbit(volumes[i], [&] (Dart d) -> bool { first = d; return false; });
+		EXPECT_EQ(first, volumes[i].dart);
+		const VolumeContent c = volume_content(map_, volumes[i]);
+		EXPECT_EQ(c.darts, contents[i].darts);
+		EXPECT_EQ(c.vertices, contents[i].vertices);
+		EXPECT_EQ(c.edges, contents[i].edges);
+		EXPECT_EQ(c.faces, contents[i].faces);
+		Dart previous;
+		foreach_incident_vertex(map_, volumes[i], [&] (Vertex v) -> bool
+		{
+			EXPECT_EQ(v.dart, smallest_dart(v));
+			EXPECT_TRUE(previous.is_nil() || previous.index < v.dart.index);
+			previous = v.dart;
+			return true;
+		});
+		previous = Dart();
+		foreach_incident_face(map_, volumes[i], [&] (Face x) -> bool
+		{
+			EXPECT_EQ(x.dart, smallest_dart(x));
+			EXPECT_TRUE(previous.is_nil() || previous.index < x.dart.index);
+			previous = x.dart;
+			return true;
+		});
+		uint32 n = 0u;
+		foreach_incident_vertex(map_, volumes[i], [&] (Vertex) -> bool { return ++n < 2u; });
+		EXPECT_EQ(n, 2u);
+	}
+
+	// any change of the topology outdates the labeling
+	cut_edge(map_, Edge(volumes.front().dart));
+	EXPECT_FALSE(map_.is_labeled(PHI1_PHI2));
+}
+
+} // namespace cgogn
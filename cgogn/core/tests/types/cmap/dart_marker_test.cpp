@@ -0,0 +1,151 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/types/cmap/dart_marker.h>
+#include <cgogn/core/types/cell_marker.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <atomic>
+
+namespace cgogn
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+
+class AtomicMarkerTest : public CMap2Fixture
+{
+protected:
+
+	void SetUp() override
+	{
+		// enough darts for several ranges of the parallel indexing
+		add_prisms(1000u, 5u);
+	}
+};
+
+TEST_F(AtomicMarkerTest, mark_unmark)
+{
+	AtomicDartMarker dm(map_);
+	const Dart d(7u);
+	EXPECT_FALSE(dm.is_marked(d));
+	dm.mark(d);
+	EXPECT_TRUE(dm.is_marked(d));
+	EXPECT_FALSE(dm.test_and_mark(d));
+	dm.unmark(d);
+	EXPECT_FALSE(dm.is_marked(d));
+	EXPECT_TRUE(dm.test_and_mark(d));
+	EXPECT_TRUE(dm.is_marked(d));
+	dm.unmark_all();
+	EXPECT_FALSE(dm.is_marked(d));
+}
+
+TEST_F(AtomicMarkerTest, concurrent_test_and_mark)
+{
+	// each dart (and each vertex) is claimed 4 times concurrently: only one claim succeeds
+	const uint32 nb_darts = map_.nb_darts();
+	add_attribute<uint32, Vertex>(map_, "vertex");
+	std::vector<Dart> darts;
+	map_.foreach_dart([&] (Dart d) -> bool { darts.push_back(d); return true; });
+	ASSERT_EQ(darts.size(), nb_darts);
+
+	AtomicDartMarker dm(map_);
+	AtomicCellMarker<CMap2, Vertex> cm(map_);
+	std::atomic<uint32> nb_claimed_darts(0u);
+	std::atomic<uint32> nb_claimed_vertices(0u);
+	thread_pool()->parallel_for(0u, 4u * nb_darts, [&] (uint32 begin, uint32 end)
+	{
+		for (uint32 i = begin; i < end; ++i)
+		{
+			const Dart d = darts[i % nb_darts];
+			if (dm.test_and_mark(d))
+				++nb_claimed_darts;
+			if (cm.test_and_mark(Vertex(d)))
+				++nb_claimed_vertices;
+		}
+	}, 64u);
+
+	EXPECT_EQ(nb_claimed_darts.load(), nb_darts);
+	EXPECT_EQ(nb_claimed_vertices.load(), nb_cells<Vertex>(map_));
+	for (Dart d : darts)
+		EXPECT_TRUE(dm.is_marked(d) && cm.is_marked(Vertex(d)));
+
+	cm.unmark_all();
+	uint32 nb_marked = 0u;
+	foreach_cell(map_, [&] (Vertex v) -> bool
+	{
+		if (cm.is_marked(v))
+			++nb_marked;
+		return true;
+	});
+	EXPECT_EQ(nb_marked, 0u);
+}
+
+TEST_F(AtomicMarkerTest, released_marks)
+{
+	{
+		AtomicDartMarker dm(map_);
+		map_.foreach_dart([&] (Dart d) -> bool { dm.mark(d); return true; });
+	}
+	// the mark attribute is given back unmarked
+	AtomicDartMarker dm(map_);
+	uint32 nb_marked = 0u;
+	map_.foreach_dart([&] (Dart d) -> bool
+	{
+		if (dm.is_marked(d))
+			++nb_marked;
+		return true;
+	});
+	EXPECT_EQ(nb_marked, 0u);
+}
+
+TEST_F(AtomicMarkerTest, parallel_index_cells)
+{
+	// the cells get the indices of a sequential traversal: in the order of their first dart
+	add_attribute<uint32, Edge>(map_, "edge");
+	std::vector<bool> visited(map_.nb_darts(), false);
+	uint32 nb_edges = 0u;
+	uint32 nb_errors = 0u;
+	map_.foreach_dart([&] (Dart d) -> bool
+	{
+		if (visited[d.index])
+			return true;
+		map_.foreach_dart_of_orbit(Edge(d), [&] (Dart e) -> bool { visited[e.index] = true; return true; });
+		if (index_of(map_, Edge(d)) != nb_edges++)
+			++nb_errors;
+		return true;
+	});
+	EXPECT_EQ(nb_errors, 0u);
+	EXPECT_EQ(nb_cells<Edge>(map_), nb_edges);
+}
+
+} // namespace cgogn
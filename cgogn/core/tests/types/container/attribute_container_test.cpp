@@ -0,0 +1,245 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/container/chunk_array.h>
+#include <cgogn/core/types/container/vector.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace cgogn
+{
+
+// values of the released indices are set to this value
+static const uint32 RELEASED = 1000000u;
+
+template <template <typename> class AttributeT>
+void test_compact()
+{
+	AttributeContainerT<AttributeT> container;
+	auto values = container.template add_attribute<uint32>("values");
+	for (uint32 i = 0u; i < 3000u; ++i)
+		(*values)[container.new_index()] = i;
+	// a mark attribute in use keeps its marks through the compaction
+	MarkAttribute* marks = container.get_mark_attribute();
+	for (uint32 i = 0u; i < 3000u; i += 3u)
+		marks->mark(i);
+
+	// holes at the start, in the middle and a free tail
+	for (uint32 i = 0u; i < 3000u; ++i)
+	{
+		if (i < 10u || (i > 1000u && i % 2u == 0u) || i >= 2500u)
+		{
+			(*values)[i] = RELEASED;
+			container.release_index(i);
+		}
+	}
+	const uint32 nb_elements = container.nb_elements();
+
+	std::vector<uint32> old_new = container.compact();
+	ASSERT_EQ(old_new.size(), 3000u);
+	EXPECT_EQ(container.nb_elements(), nb_elements);
+	EXPECT_EQ(container.maximum_index(), nb_elements);
+
+	uint32 nb_errors = 0u;
+	std::vector<bool> targets(nb_elements, false);
+	for (uint32 i = 0u; i < 3000u; ++i)
+	{
+		const bool released = i < 10u || (i > 1000u && i % 2u == 0u) || i >= 2500u;
+		if (released)
+		{
+			nb_errors += old_new[i] != INVALID_INDEX;
+			continue;
+		}
+		const uint32 j = old_new[i];
+		if (j >= nb_elements || targets[j])
+		{
+			++nb_errors;
+			continue;
+		}
+		targets[j] = true;
+		nb_errors += (*values)[j] != i || marks->is_marked(j) != (i % 3u == 0u) || !container.is_used(j);
+	}
+	EXPECT_EQ(nb_errors, 0u);
+
+	// the holes are not reused anymore: the next index is at the end
+	EXPECT_EQ(container.new_index(), nb_elements);
+	container.release_mark_attribute(marks);
+}
+
+TEST(AttributeContainerTest, compact_chunk_array)
+{
+	test_compact<ChunkArray>();
+}
+
+TEST(AttributeContainerTest, compact_vector)
+{
+	test_compact<Vector>();
+}
+
+TEST(AttributeContainerTest, new_indices)
+{
+	AttributeContainerT<ChunkArray> container;
+	auto values = container.add_attribute<uint32>("values");
+	for (uint32 i = 0u; i < 100u; ++i)
+		container.new_index();
+	container.release_index(10u);
+	container.release_index(50u);
+	MarkAttribute* marks = container.get_mark_attribute();
+	for (uint32 i = 0u; i < 100u; ++i)
+		marks->mark(i);
+
+	EXPECT_EQ(container.new_indices(0u), 100u);
+	EXPECT_EQ(container.maximum_index(), 100u);
+
+	// the range is contiguous at the end of the container, holes are not reused
+	const uint32 first = container.new_indices(3000u);
+	EXPECT_EQ(first, 100u);
+	EXPECT_EQ(container.maximum_index(), 3100u);
+	EXPECT_EQ(container.nb_elements(), 3098u);
+	uint32 nb_errors = 0u;
+	for (uint32 i = first; i < first + 3000u; ++i)
+	{
+		(*values)[i] = i; // the attributes are grown to the whole range
+		nb_errors += !container.is_used(i) || marks->is_marked(i);
+	}
+	EXPECT_EQ(nb_errors, 0u);
+	EXPECT_FALSE(container.is_used(10u));
+	EXPECT_EQ(container.new_index(), 50u);
+	container.release_mark_attribute(marks);
+}
+
+TEST(AttributeContainerTest, mark_attributes_pool)
+{
+	AttributeContainerT<ChunkArray> container;
+	container.new_indices(1000u);
+
+	MarkAttribute* m1 = container.get_mark_attribute();
+	MarkAttribute* m2 = container.get_mark_attribute();
+	EXPECT_NE(m1, m2);
+	m1->mark(5u);
+	m1->unmark_all();
+	// a mark attribute can be released by another thread and is then reused
+	std::thread([&] () { container.release_mark_attribute(m1); }).join();
+	MarkAttribute* m3 = container.get_mark_attribute();
+	EXPECT_EQ(m3, m1);
+	EXPECT_FALSE(m3->is_marked(5u));
+
+	// the new indices are unmarked in the mark attributes in use
+	m2->mark(999u);
+	const uint32 index = container.new_index();
+	EXPECT_FALSE(m2->is_marked(index));
+	EXPECT_TRUE(m2->is_marked(999u));
+	m2->unmark_all();
+	container.release_mark_attribute(m2);
+	container.release_mark_attribute(m3);
+
+	// concurrent acquisitions never give the same mark attribute to two tasks
+	std::atomic<uint32> nb_errors(0u);
+	thread_pool()->parallel_for(0u, 256u, [&] (uint32 begin, uint32 end)
+	{
+		for (uint32 i = begin; i < end; ++i)
+		{
+			MarkAttribute* m = container.get_mark_attribute();
+			if (!m->test_and_mark(0u))
+				++nb_errors;
+			for (uint32 j = 1u; j < 1000u; j += 37u)
+				m->mark(j);
+			m->unmark_all();
+			container.release_mark_attribute(m);
+		}
+	}, 1u);
+	EXPECT_EQ(nb_errors.load(), 0u);
+}
+
+TEST(AttributeContainerTest, bit_packed_marks)
+{
+	AttributeContainerT<ChunkArray> container;
+	const uint32 nb_words = 3u * MarkAttribute::CHUNK_SIZE;
+	container.new_indices(nb_words * MarkAttribute::NB_MARKS_PER_WORD);
+	MarkAttribute* marks = container.get_mark_attribute();
+
+	// the marks of the elements around the words boundaries are independent
+	for (uint32 i : { 0u, 55u, 56u, 111u, 112u })
+		marks->mark(i);
+	uint32 nb_errors = 0u;
+	for (uint32 i = 0u; i < 200u; ++i)
+		nb_errors += marks->is_marked(i) != (i == 0u || i == 55u || i == 56u || i == 111u || i == 112u);
+	EXPECT_EQ(nb_errors, 0u);
+	marks->unmark(56u);
+	marks->atomic_unmark(55u);
+	EXPECT_TRUE(marks->is_marked(0u) && !marks->is_marked(55u) && !marks->is_marked(56u) && marks->is_marked(111u));
+
+	// the marks of a former generation are never seen again, also when the generation wraps around
+	nb_errors = 0u;
+	for (uint32 g = 0u; g < 600u; ++g)
+	{
+		marks->unmark_all();
+		nb_errors += marks->is_marked(0u) || marks->is_marked(111u) || marks->is_marked(g);
+		marks->mark(g);
+		nb_errors += !marks->is_marked(g) || marks->is_marked(g + 1u);
+	}
+	EXPECT_EQ(nb_errors, 0u);
+
+	// less than 2 bits per element
+	EXPECT_LT(marks->memory_footprint(), container.maximum_index() / 4u);
+	marks->unmark_all();
+	container.release_mark_attribute(marks);
+}
+
+TEST(AttributeContainerTest, concurrent_marks)
+{
+	AttributeContainerT<ChunkArray> container;
+	const uint32 nb = 4096u * MarkAttribute::NB_MARKS_PER_WORD;
+	container.new_indices(nb);
+	MarkAttribute* marks = container.get_mark_attribute();
+
+	// the threads mark and unmark distinct elements of the same words (interleaved indices)
+	const uint32 nb_tasks = 8u;
+	for (uint32 round = 0u; round < 10u; ++round)
+	{
+		marks->unmark_all();
+		thread_pool()->parallel_for(0u, nb_tasks, [&] (uint32 begin, uint32 end)
+		{
+			for (uint32 t = begin; t < end; ++t)
+			{
+				for (uint32 i = t; i < nb; i += nb_tasks)
+					marks->mark(i);
+				for (uint32 i = t; i < nb; i += 2u * nb_tasks)
+					marks->unmark(i);
+			}
+		}, 1u);
+		uint32 nb_errors = 0u;
+		for (uint32 i = 0u; i < nb; ++i)
+			nb_errors += marks->is_marked(i) != ((i / nb_tasks) % 2u == 1u);
+		ASSERT_EQ(nb_errors, 0u) << "round " << round;
+	}
+	marks->unmark_all();
+	container.release_mark_attribute(marks);
+}
+
+} // namespace cgogn
@@ -0,0 +1,165 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/container/chunk_array.h>
+
+#include <cstdint>
+
+namespace cgogn
+{
+
+using Container = AttributeContainerT<ChunkArray>;
+
+static bool aligned(const void* p, std::size_t alignment)
+{
+	return reinterpret_cast<std::uintptr_t>(p) % alignment == 0u;
+}
+
+class ChunkArrayTest : public ::testing::Test
+{
+protected:
+
+	Container container_;
+
+	void TearDown() override
+	{
+		set_dynamic_chunk_size(1024u);
+		set_huge_page_chunks(false);
+	}
+};
+
+TEST_F(ChunkArrayTest, dynamic_chunk_size)
+{
+	set_dynamic_chunk_size(64u);
+	auto a = container_.add_attribute_of_type<DynamicChunkArray<uint32>>("a");
+	auto b = container_.add_attribute<uint32>("b");
+	// the chunk size is read when the attribute is created
+	set_dynamic_chunk_size(256u);
+	auto c = container_.add_attribute_of_type<DynamicChunkArray<uint32>>("c");
+	EXPECT_EQ(a->chunk_size(), 64u);
+	EXPECT_EQ(b->chunk_size(), 1024u);
+	EXPECT_EQ(c->chunk_size(), 256u);
+
+	for (uint32 i = 0u; i < 1000u; ++i)
+	{
+		const uint32 index = container_.new_index();
+		(*a)[index] = index;
+		(*c)[index] = index;
+	}
+	EXPECT_EQ(a->nb_chunks(), 1000u / 64u + 1u);
+	EXPECT_EQ(c->nb_chunks(), 1000u / 256u + 1u);
+	uint32 nb_errors = 0u;
+	for (uint32 i = 0u; i < 1000u; ++i)
+		nb_errors += (*a)[i] != i || (*c)[i] != i;
+	EXPECT_EQ(nb_errors, 0u);
+}
+
+TEST_F(ChunkArrayTest, aligned_chunks)
+{
+	set_dynamic_chunk_size(16u);
+	auto a = container_.add_attribute_of_type<DynamicChunkArray<char>>("a");
+	auto b = container_.add_attribute<char>("b");
+	for (uint32 i = 0u; i < 2000u; ++i)
+		container_.new_index();
+	for (const void* p : a->chunk_pointers())
+		EXPECT_TRUE(aligned(p, 64u));
+	for (const void* p : b->chunk_pointers())
+		EXPECT_TRUE(aligned(p, 64u));
+
+	// chunks of 2MB are aligned on huge pages
+	set_huge_page_chunks(true);
+	set_dynamic_chunk_size(1u << 18);
+	auto c = container_.add_attribute_of_type<DynamicChunkArray<uint64>>("c");
+	EXPECT_EQ(c->chunk_size() * sizeof(uint64), std::size_t(2u * 1024u * 1024u));
+	for (const void* p : c->chunk_pointers())
+		EXPECT_TRUE(aligned(p, 2u * 1024u * 1024u));
+}
+
+TEST_F(ChunkArrayTest, compact)
+{
+	set_dynamic_chunk_size(32u);
+	auto a = container_.add_attribute_of_type<DynamicChunkArray<uint32>>("a");
+	for (uint32 i = 0u; i < 200u; ++i)
+		(*a)[container_.new_index()] = i;
+	EXPECT_EQ(a->nb_chunks(), 7u);
+	// release the even indices
+	for (uint32 i = 0u; i < 200u; i += 2u)
+		container_.release_index(i);
+
+	std::vector<uint32> old_new = container_.compact();
+	EXPECT_EQ(container_.maximum_index(), 100u);
+	// the values are moved with their index and the chunks beyond the new maximum index are freed
+	EXPECT_EQ(a->nb_chunks(), 4u);
+	uint32 nb_errors = 0u;
+	for (uint32 i = 1u; i < 200u; i += 2u)
+		nb_errors += old_new[i] >= 100u || (*a)[old_new[i]] != i;
+	EXPECT_EQ(nb_errors, 0u);
+}
+
+TEST_F(ChunkArrayTest, swap_copy)
+{
+	set_dynamic_chunk_size(64u);
+	auto a = container_.add_attribute_of_type<DynamicChunkArray<uint32>>("a");
+	auto b = container_.add_attribute_of_type<DynamicChunkArray<uint32>>("b");
+	set_dynamic_chunk_size(128u);
+	auto c = container_.add_attribute_of_type<DynamicChunkArray<uint32>>("c");
+	for (uint32 i = 0u; i < 200u; ++i)
+	{
+		const uint32 index = container_.new_index();
+		(*a)[index] = index;
+		(*b)[index] = 2u * index;
+		(*c)[index] = 3u * index;
+	}
+
+	EXPECT_TRUE(a->swap(b.get()));
+	// the chunk sizes differ: nothing is done
+	EXPECT_FALSE(a->swap(c.get()));
+	EXPECT_FALSE(a->copy(c.get()));
+	uint32 nb_errors = 0u;
+	for (uint32 i = 0u; i < 200u; ++i)
+		nb_errors += (*a)[i] != 2u * i || (*b)[i] != i || (*c)[i] != 3u * i;
+	EXPECT_EQ(nb_errors, 0u);
+
+	EXPECT_TRUE(b->copy(a.get()));
+	nb_errors = 0u;
+	for (uint32 i = 0u; i < 200u; ++i)
+		nb_errors += (*b)[i] != 2u * i;
+	EXPECT_EQ(nb_errors, 0u);
+}
+
+TEST_F(ChunkArrayTest, memory_footprint)
+{
+	set_dynamic_chunk_size(128u);
+	auto a = container_.add_attribute_of_type<DynamicChunkArray<uint64>>("a");
+	const std::size_t attribute_size = a->memory_footprint();
+	const std::size_t container_size = container_.memory_footprint();
+	for (uint32 i = 0u; i < 1000u; ++i)
+		container_.new_index();
+	// the 8 chunks of 128 elements
+	EXPECT_EQ(a->memory_footprint() - attribute_size, 7u * 128u * sizeof(uint64));
+	EXPECT_GT(container_.memory_footprint(), container_size + 7u * 128u * sizeof(uint64));
+}
+
+} // namespace cgogn
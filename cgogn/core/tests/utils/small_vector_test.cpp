@@ -0,0 +1,159 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/utils/small_vector.h>
+
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+using Strings = SmallVector<std::string, 4u>;
+
+// the elements are stored in the SmallVector object itself
+static bool is_inline(const Strings& v)
+{
+	const char* p = reinterpret_cast<const char*>(v.data());
+	const char* o = reinterpret_cast<const char*>(&v);
+	return p >= o && p < o + sizeof(Strings);
+}
+
+static std::vector<std::string> elements(const Strings& v)
+{
+	return std::vector<std::string>(v.begin(), v.end());
+}
+
+static std::vector<std::string> numbers(uint32 first, uint32 end)
+{
+	std::vector<std::string> result;
+	for (uint32 i = first; i < end; ++i)
+		result.push_back(std::to_string(i));
+	return result;
+}
+
+static Strings small_vector(uint32 size)
+{
+	Strings v;
+	for (const std::string& s : numbers(0u, size))
+		v.push_back(s);
+	return v;
+}
+
+TEST(SmallVectorTest, grow)
+{
+	Strings v;
+	EXPECT_TRUE(v.empty());
+	for (uint32 i = 0u; i < 4u; ++i)
+		v.push_back(std::to_string(i));
+	EXPECT_TRUE(is_inline(v));
+	EXPECT_EQ(v.capacity(), 4u);
+
+	// the elements are moved to the heap past N
+	for (uint32 i = 4u; i < 50u; ++i)
+		v.emplace_back(std::to_string(i));
+	EXPECT_FALSE(is_inline(v));
+	EXPECT_EQ(v.size(), 50u);
+	EXPECT_GE(v.capacity(), 50u);
+	EXPECT_EQ(elements(v), numbers(0u, 50u));
+	EXPECT_EQ(v.front(), "0");
+	EXPECT_EQ(v.back(), "49");
+
+	for (uint32 i = 0u; i < 48u; ++i)
+		v.pop_back();
+	EXPECT_EQ(elements(v), numbers(0u, 2u));
+
+	Strings l = { "0", "1", "2", "3", "4", "5" };
+	EXPECT_EQ(elements(l), numbers(0u, 6u));
+}
+
+TEST(SmallVectorTest, copy)
+{
+	for (uint32 size : { 3u, 20u })
+	{
+		Strings v = small_vector(size);
+		Strings c(v);
+		EXPECT_EQ(elements(c), numbers(0u, size));
+		EXPECT_EQ(is_inline(c), size <= 4u);
+		// the copies are independent
+		c[0u] = "x";
+		c.push_back("y");
+		EXPECT_EQ(elements(v), numbers(0u, size));
+
+		Strings a = small_vector(10u);
+		a = v;
+		EXPECT_EQ(elements(a), numbers(0u, size));
+	}
+}
+
+TEST(SmallVectorTest, move)
+{
+	for (uint32 size : { 3u, 20u })
+	{
+		Strings v = small_vector(size);
+		const std::string* data = v.data();
+		Strings m(std::move(v));
+		EXPECT_EQ(elements(m), numbers(0u, size));
+		// the heap storage is taken over
+		if (size > 4u)
+			EXPECT_EQ(m.data(), data);
+
+		Strings a = small_vector(10u);
+		a = std::move(m);
+		EXPECT_EQ(elements(a), numbers(0u, size));
+		a.push_back("x");
+		EXPECT_EQ(a.size(), size + 1u);
+	}
+}
+
+TEST(SmallVectorTest, clear)
+{
+	for (uint32 size : { 3u, 20u })
+	{
+		Strings v = small_vector(size);
+		v.clear();
+		EXPECT_TRUE(v.empty());
+		EXPECT_EQ(v.begin(), v.end());
+		// the vector is reused, from below and above N
+		for (const std::string& s : numbers(100u, 102u))
+			v.push_back(s);
+		EXPECT_EQ(elements(v), numbers(100u, 102u));
+		for (const std::string& s : numbers(102u, 130u))
+			v.push_back(s);
+		EXPECT_EQ(elements(v), numbers(100u, 130u));
+		v.clear();
+		v.push_back("x");
+		EXPECT_EQ(v.size(), 1u);
+		EXPECT_EQ(v[0u], "x");
+	}
+
+	Strings r;
+	r.reserve(10u);
+	r.push_back("0");
+	EXPECT_GE(r.capacity(), 10u);
+	EXPECT_EQ(elements(r), numbers(0u, 1u));
+}
+
+} // namespace cgogn
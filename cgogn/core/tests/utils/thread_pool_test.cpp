@@ -0,0 +1,256 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cgogn
+{
+
+TEST(ThreadPoolTest, parallel_for)
+{
+	ThreadPool* pool = thread_pool();
+	for (uint32 grain : { 0u, 1u, 7u, 1000u, 200000u })
+	{
+		const uint32 n = 100003u;
+		std::vector<std::atomic<uint32>> hits(n);
+		for (auto& h : hits)
+			h = 0u;
+		pool->parallel_for(0u, n, [&] (uint32 begin, uint32 end)
+		{
+			EXPECT_LT(begin, end);
+			for (uint32 i = begin; i < end; ++i)
+				++hits[i];
+		}, grain);
+		uint32 nb_errors = 0u;
+		for (auto& h : hits)
+			if (h != 1u)
+				++nb_errors;
+		EXPECT_EQ(nb_errors, 0u);
+	}
+
+	uint32 nb_calls = 0u;
+	pool->parallel_for(5u, 5u, [&] (uint32, uint32) { ++nb_calls; });
+	EXPECT_EQ(nb_calls, 0u);
+}
+
+TEST(ThreadPoolTest, nested_parallel_for)
+{
+	ThreadPool* pool = thread_pool();
+	std::atomic<uint32> sum(0u);
+	pool->parallel_for(0u, 100u, [&] (uint32 begin, uint32 end)
+	{
+		for (uint32 i = begin; i < end; ++i)
+			pool->parallel_for(0u, 1000u, [&] (uint32 b, uint32 e) { sum += e - b; }, 7u);
+	}, 1u);
+	EXPECT_EQ(sum.load(), 100000u);
+}
+
+TEST(ThreadPoolTest, parallel_reduce_determinism)
+{
+	ThreadPool* pool = thread_pool();
+	std::vector<float64> values(1000003u);
+	for (uint32 i = 0u; i < values.size(); ++i)
+		values[i] = std::sin(float64(i)) / float64(i + 1u);
+	auto map = [&] (uint32 begin, uint32 end) -> float64
+	{
+		float64 s = 0.0;
+		for (uint32 i = begin; i < end; ++i)
+			s += values[i];
+		return s;
+	};
+	auto combine = [] (float64 a, float64 b) -> float64 { return a + b; };
+
+	// the reduction tree only depends on the range and the grain size
+	const uint32 nb_workers = pool->nb_workers();
+	for (uint32 grain : { 0u, 1000u, 12345u })
+	{
+		const float64 reference = pool->parallel_reduce(0u, uint32(values.size()), 0.0, map, combine, grain);
+		for (uint32 k = 0u; k < 10u; ++k)
+			EXPECT_EQ(pool->parallel_reduce(0u, uint32(values.size()), 0.0, map, combine, grain), reference);
+		for (uint32 nb : { 0u, 1u, nb_workers })
+		{
+			pool->set_nb_workers(nb);
+			EXPECT_EQ(pool->parallel_reduce(0u, uint32(values.size()), 0.0, map, combine, grain), reference);
+		}
+		pool->set_nb_workers(nb_workers);
+		if (nb_workers > 0u)
+		{
+			// from inside a task
+			float64 result = 0.0;
+			pool->enqueue([&] () { result = pool->parallel_reduce(0u, uint32(values.size()), 0.0, map, combine, grain); }).wait();
+			EXPECT_EQ(result, reference);
+		}
+	}
+
+	EXPECT_EQ(pool->parallel_reduce(3u, 3u, -1.0, map, combine), -1.0);
+}
+
+TEST(ThreadPoolTest, exceptions)
+{
+	ThreadPool* pool = thread_pool();
+
+	// all the subranges are done when the exception reaches the caller
+	for (uint32 thrower : { 0u, 500u, 9999u })
+	{
+		std::atomic<uint32> nb_done(0u);
+		EXPECT_THROW(pool->parallel_for(0u, 10000u, [&] (uint32 first, uint32 last)
+		{
+			nb_done += last - first;
+			if (first <= thrower && thrower < last)
+				throw std::runtime_error("parallel_for");
+		}, 10u), std::runtime_error);
+		EXPECT_EQ(nb_done.load(), 10000u);
+
+		EXPECT_THROW(pool->parallel_reduce(0u, 10000u, 0u, [&] (uint32 first, uint32 last) -> uint32
+		{
+			if (first <= thrower && thrower < last)
+				throw std::runtime_error("parallel_reduce");
+			return last - first;
+		}, [] (uint32 a, uint32 b) { return a + b; }, 10u), std::runtime_error);
+	}
+
+	// nested calls
+	EXPECT_THROW(pool->parallel_for(0u, 64u, [&] (uint32 first, uint32 last)
+	{
+		pool->parallel_for(0u, 1000u, [&] (uint32 f, uint32)
+		{
+			if (first <= 32u && 32u < last && f == 0u)
+				throw std::runtime_error("nested");
+		}, 10u);
+	}, 1u), std::runtime_error);
+
+	// the pool still works
+	std::atomic<uint32> nb_done(0u);
+	pool->parallel_for(0u, 10000u, [&] (uint32 first, uint32 last) { nb_done += last - first; }, 10u);
+	EXPECT_EQ(nb_done.load(), 10000u);
+}
+
+static void set_nb_workers_variable(const char* value)
+{
+#ifdef _WIN32
+	_putenv_s("CGOGN_NB_WORKERS", value == nullptr ? "" : value);
+#else
+	if (value == nullptr)
+		unsetenv("CGOGN_NB_WORKERS");
+	else
+		setenv("CGOGN_NB_WORKERS", value, 1);
+#endif
+}
+
+TEST(ThreadPoolTest, nb_workers_variable)
+{
+	const char* previous = std::getenv("CGOGN_NB_WORKERS");
+	const std::string previous_value = previous == nullptr ? "" : previous;
+	const uint32 nb_default = std::max(1u, std::thread::hardware_concurrency()) - 1u;
+
+	// the invalid values are ignored and the large ones are clamped
+	for (const char* value : { "abc", "", "-1", "3x", "99999999999" })
+	{
+		set_nb_workers_variable(value);
+		ThreadPool pool;
+		EXPECT_EQ(pool.max_nb_workers(), nb_default) << value;
+	}
+	set_nb_workers_variable("2");
+	{
+		ThreadPool pool;
+		EXPECT_EQ(pool.max_nb_workers(), 2u);
+	}
+	set_nb_workers_variable("100000");
+	{
+		ThreadPool pool;
+		EXPECT_EQ(pool.max_nb_workers(), ThreadPool::MAX_ENV_NB_WORKERS);
+	}
+
+	set_nb_workers_variable(previous == nullptr ? nullptr : previous_value.c_str());
+}
+
+TEST(ThreadPoolTest, enqueue)
+{
+	ThreadPool* pool = thread_pool();
+	if (pool->nb_workers() == 0u)
+		GTEST_SKIP() << "the enqueued tasks need a worker";
+
+	std::atomic<uint32> nb_done(0u);
+	std::vector<std::future<void>> futures;
+	for (uint32 i = 0u; i < 1000u; ++i)
+		futures.push_back(pool->enqueue([&] () { ++nb_done; }));
+	for (auto& f : futures)
+		f.wait();
+	EXPECT_EQ(nb_done.load(), 1000u);
+
+	// tasks enqueued without waiting from the workers
+	nb_done = 0u;
+	pool->parallel_for(0u, 64u, [&] (uint32, uint32) { pool->enqueue([&] () { ++nb_done; }); }, 1u);
+	while (nb_done < 64u)
+		std::this_thread::yield();
+}
+
+TEST(ThreadPoolTest, waiting_workers_only_help_their_group)
+{
+	ThreadPool* pool = thread_pool();
+	if (pool->nb_workers() == 0u)
+		GTEST_SKIP() << "the enqueued tasks need a worker";
+
+	// the tasks injected by another thread are never executed inside the nested parallel_for
+	static thread_local bool in_body = false;
+	std::atomic<uint32> nb_nested(0u);
+	std::atomic<bool> stop(false);
+	std::vector<std::future<void>> futures;
+	std::thread injector([&] ()
+	{
+		while (!stop)
+		{
+			futures.push_back(pool->enqueue([&] () { if (in_body) ++nb_nested; }));
+			std::this_thread::yield();
+		}
+	});
+	for (uint32 k = 0u; k < 100u; ++k)
+	{
+		pool->parallel_for(0u, 64u, [&] (uint32, uint32)
+		{
+			in_body = true;
+			std::atomic<uint32> n(0u);
+			pool->parallel_for(0u, 256u, [&] (uint32 begin, uint32 end) { n += end - begin; }, 1u);
+			EXPECT_EQ(n.load(), 256u);
+			in_body = false;
+		}, 1u);
+	}
+	stop = true;
+	injector.join();
+	for (auto& f : futures)
+		f.wait();
+	EXPECT_EQ(nb_nested.load(), 0u);
+}
+
+} // namespace cgogn
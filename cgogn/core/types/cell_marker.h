@@ -126,17 +126,17 @@ public:
 
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CellMarker);
 
-	inline void mark(CELL c) { (*mark_attribute_)[index_of(mesh_, c)] = 1u; }
-	inline void unmark(CELL c) { (*mark_attribute_)[index_of(mesh_, c)] = 0u; }
+	inline void mark(CELL c) { mark_attribute_->mark(index_of(mesh_, c)); }
+	inline void unmark(CELL c) { mark_attribute_->unmark(index_of(mesh_, c)); }
 
 	inline bool is_marked(CELL c) const
 	{
-		return (*mark_attribute_)[index_of(mesh_, c)] != 0u;
+		return mark_attribute_->is_marked(index_of(mesh_, c));
 	}
 
 	inline void unmark_all()
 	{
-		mark_attribute_->fill(0u);
+		mark_attribute_->unmark_all();
 	}
 };
 
@@ -170,7 +170,7 @@ public:
 		if (!is_marked(c))
 		{
 			uint32 index = index_of(mesh_, c);
-			(*mark_attribute_)[index] = 1u;
+			mark_attribute_->mark(index);
 			marked_cells_.push_back(index);
 		}
 	}
@@ -181,7 +181,7 @@ public:
 		auto it = std::find(marked_cells_.begin(), marked_cells_.end(), index);
 		if (it != marked_cells_.end())
 		{
-			(*mark_attribute_)[index] = 0u;
+			mark_attribute_->unmark(index);
 			std::swap(*it, marked_cells_.back());
 			marked_cells_.pop_back();
 		}
@@ -189,13 +189,13 @@ public:
 
 	inline bool is_marked(CELL c) const
 	{
-		return (*mark_attribute_)[index_of(mesh_, c)] != 0u;
+		return mark_attribute_->is_marked(index_of(mesh_, c));
 	}
 
 	inline void unmark_all()
 	{
 		for (uint32 i : marked_cells_)
-            (*mark_attribute_)[i] = 0u;
+			mark_attribute_->unmark(i);
 		marked_cells_.clear();
 	}
 
@@ -205,6 +205,51 @@ public:
 	}
 };
 
+/**
+ * AtomicCellMarker can be shared by the threads of a parallel traversal:
+ * its marks are set, unset and tested atomically
+ */
+template <typename MESH, typename CELL>
+class AtomicCellMarker
+{
+private:
+
+	const MESH& mesh_;
+	typename mesh_traits<MESH>::MarkAttribute* mark_attribute_;
+
+public:
+
+	AtomicCellMarker(const MESH& mesh) : mesh_(mesh)
+	{
+		mark_attribute_ = get_mark_attribute<CELL>(mesh_);
+	}
+
+	~AtomicCellMarker()
+	{
+		unmark_all();
+		release_mark_attribute<CELL>(mesh_, mark_attribute_);
+	}
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(AtomicCellMarker);
+
+	inline void mark(CELL c) { mark_attribute_->atomic_mark(index_of(mesh_, c)); }
+	inline void unmark(CELL c) { mark_attribute_->atomic_unmark(index_of(mesh_, c)); }
+
+	// marks the cell and returns true iff it was not already marked
+	inline bool test_and_mark(CELL c) { return mark_attribute_->test_and_mark(index_of(mesh_, c)); }
+
+	inline bool is_marked(CELL c) const
+	{
+		return mark_attribute_->is_marked(index_of(mesh_, c));
+	}
+
+	// should not be called concurrently with the other methods
+	inline void unmark_all()
+	{
+		mark_attribute_->unmark_all();
+	}
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_TYPES_MARKER_H_
@@ -49,7 +49,8 @@ public:
 	CellsSet(const MESH& m, const std::string& name) :
 		m_(m),
 		marker_(m),
-		name_(name)
+		name_(name),
+		version_(0u)
 	{}
 
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(CellsSet);
@@ -87,6 +88,14 @@ public:
 
 	inline void rebuild()
 	{
+		// the set is kept if the cells of the mesh did not change since the last rebuild
+		if constexpr (std::is_base_of<CMapBase, MESH>::value)
+		{
+			const uint64 version = m_.cells_version(CELL::ORBIT);
+			if (version == version_)
+				return;
+			version_ = version;
+		}
 		cells_.clear();
 		cgogn::foreach_cell(m_, [&] (CELL c) -> bool
 		{
@@ -118,6 +127,7 @@ private:
 	CellMarker<MESH, CELL> marker_;
 	std::unordered_map<uint32, CELL> cells_;
 	std::string name_;
+	uint64 version_;
 };
 
 } // namespace ui
@@ -0,0 +1,68 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_CORE_TYPES_CMAP_CELLS_JOURNAL_H_
+#define CGOGN_CORE_TYPES_CMAP_CELLS_JOURNAL_H_
+
+#include <cgogn/core/types/cmap/cell.h>
+
+#include <cgogn/core/utils/numerics.h>
+
+#include <array>
+#include <vector>
+
+namespace cgogn
+{
+
+/**
+ * Record of the changes of a map since a checkpoint (see CMapBase::enable_journal):
+ * the darts that were created or whose relations, boundary mark or cells indices changed
+ * (the cells that contain them are the modified cells) and the created and removed cells indices of each orbit.
+ * The darts may have been removed since they were recorded. Changes that cannot be recorded
+ * dart by dart (compactions, indexing of a new orbit) or more records than darts in the map make
+ * the journal incomplete: it is then emptied and the consumers fall back to a complete computation.
+ */
+struct CellsJournal
+{
+	uint64 epoch; // incremented at each checkpoint
+	bool complete;
+	std::vector<Dart> darts;
+	std::array<std::vector<uint32>, NB_ORBITS> created_cells;
+	std::array<std::vector<uint32>, NB_ORBITS> removed_cells;
+
+	inline void clear()
+	{
+		complete = true;
+		darts.clear();
+		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		{
+			created_cells[orbit].clear();
+			removed_cells[orbit].clear();
+		}
+	}
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_CMAP_CELLS_JOURNAL_H_
@@ -72,8 +72,11 @@ struct CGOGN_CORE_EXPORT CMap1 : public CMap0
 
 	inline void phi1_sew(Dart d, Dart e)
 	{
+		pure_simplicial_ = false;
+		connectivity_changed();
 		Dart f = phi1(d);
 		Dart g = phi1(e);
+		journal_darts({ d, e, f, g });
 		(*phi1_)[d.index] = g;
 		(*phi1_)[e.index] = f;
 		(*phi_1_)[g.index] = d;
@@ -82,8 +85,11 @@ struct CGOGN_CORE_EXPORT CMap1 : public CMap0
 
 	inline void phi1_unsew(Dart d)
 	{
+		pure_simplicial_ = false;
+		connectivity_changed();
 		Dart e = phi1(d);
 		Dart f = phi1(e);
+		journal_darts({ d, e, f });
 		(*phi1_)[d.index] = f;
 		(*phi1_)[e.index] = e;
 		(*phi_1_)[f.index] = d;
@@ -118,6 +124,17 @@ struct CGOGN_CORE_EXPORT CMap1 : public CMap0
 			it = phi1(it);
 		} while (it != d);
 	}
+
+	// unrolled version of foreach_dart_of_PHI1 for a triangle face
+	template <typename FUNC>
+	inline void foreach_dart_of_triangle(Dart d, const FUNC& f) const
+	{
+		static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
+		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+		const Dart d1 = phi1(d);
+		if (f(d) && f(d1))
+			f(phi1(d1));
+	}
 };
 
 } // namespace cgogn
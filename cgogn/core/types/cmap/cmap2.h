@@ -28,6 +28,7 @@
 
 #include <cgogn/core/types/cmap/cmap1.h>
 #include <cgogn/core/types/cmap/dart_marker.h>
+#include <cgogn/core/types/cmap/vertex_adjacency.h>
 
 namespace cgogn
 {
@@ -36,6 +37,9 @@ struct CGOGN_CORE_EXPORT CMap2 : public CMap1
 {
 	std::shared_ptr<Attribute<Dart>> phi2_;
 
+	// vertex-vertex adjacency snapshot (see build_adjacency_csr)
+	std::shared_ptr<VertexAdjacency> vertex_adjacency_;
+
 	using Vertex = Cell<PHI21>;
 	using Edge = Cell<PHI2>;
 	using Face = Cell<PHI1>;
@@ -44,7 +48,11 @@ struct CGOGN_CORE_EXPORT CMap2 : public CMap1
 
 	using Cells = std::tuple<Vertex, Edge, Face, Volume>;
 
-	CMap2() : CMap1()
+	// the phi2 (un)sewing keeps the degree of the faces but not of the volumes:
+	// it resets the pure simplicial flag in a CMap3, where the volumes should also be tetrahedra
+	bool phi2_sewing_resets_pure_simplicial_;
+
+	CMap2() : CMap1(), phi2_sewing_resets_pure_simplicial_(false)
 	{
 		phi2_ = add_relation("phi2");
 	}
@@ -54,6 +62,15 @@ struct CGOGN_CORE_EXPORT CMap2 : public CMap1
 		return (*phi2_)[d.index];
 	}
 
+	// the adjacency snapshot if it was built from the current vertices (and edges), nullptr otherwise
+	inline const VertexAdjacency* vertex_adjacency() const
+	{
+		if (vertex_adjacency_ && vertex_adjacency_->vertices_version == cells_version(Vertex::ORBIT) &&
+			(!vertex_adjacency_->has_edges() || vertex_adjacency_->edges_version == cells_version(Edge::ORBIT)))
+			return vertex_adjacency_.get();
+		return nullptr;
+	}
+
 	template <uint64 N>
 	inline Dart phi(Dart d) const
 	{
@@ -70,13 +87,21 @@ struct CGOGN_CORE_EXPORT CMap2 : public CMap1
 	{
 		cgogn_assert(phi2(d) == d);
 		cgogn_assert(phi2(e) == e);
+		if (phi2_sewing_resets_pure_simplicial_)
+			pure_simplicial_ = false;
+		connectivity_changed();
+		journal_darts({ d, e });
 		(*phi2_)[d.index] = e;
 		(*phi2_)[e.index] = d;
 	}
 
 	inline void phi2_unsew(Dart d)
 	{
+		if (phi2_sewing_resets_pure_simplicial_)
+			pure_simplicial_ = false;
+		connectivity_changed();
 		Dart e = phi2(d);
+		journal_darts({ d, e });
 		(*phi2_)[d.index] = d;
 		(*phi2_)[e.index] = e;
 	}
@@ -127,6 +152,9 @@ struct CGOGN_CORE_EXPORT CMap2 : public CMap1
 	{
 		static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
 		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+		if (is_labeled(PHI1_PHI2))
+			return foreach_dart_of_labeled_orbit(PHI1_PHI2, d, f);
+
 		DartMarkerStore marker(*this);
 
 		std::vector<Dart> visited_faces;
@@ -155,6 +183,15 @@ struct CGOGN_CORE_EXPORT CMap2 : public CMap1
 		}
 	}
 
+	/**
+	 * @brief labels the volumes (PHI1_PHI2 orbits) of the map: until the next change of the topology,
+	 * the traversals of the volumes and of their incident cells no longer use dart markers
+	 */
+	inline void label_volumes()
+	{
+		label_orbits(PHI1_PHI2, { phi1_.get(), phi2_.get() });
+	}
+
 	Face close_hole(Dart d, bool set_indices = true);
 
 	uint32 close(bool set_indices = true);
@@ -47,6 +47,7 @@ struct CGOGN_CORE_EXPORT CMap3 : public CMap2
 	CMap3() : CMap2()
 	{
 		phi3_ = add_relation("phi3");
+		phi2_sewing_resets_pure_simplicial_ = true;
 	}
 
 	inline Dart phi3(Dart d) const
@@ -71,13 +72,17 @@ struct CGOGN_CORE_EXPORT CMap3 : public CMap2
 	{
 		cgogn_assert(phi3(d) == d);
 		cgogn_assert(phi3(e) == e);
+		connectivity_changed();
+		journal_darts({ d, e });
 		(*phi3_)[d.index] = e;
 		(*phi3_)[e.index] = d;
 	}
 
 	inline void phi3_unsew(Dart d)
 	{
+		connectivity_changed();
 		Dart e = phi3(d);
+		journal_darts({ d, e });
 		(*phi3_)[d.index] = d;
 		(*phi3_)[e.index] = e;
 	}
@@ -161,6 +166,9 @@ struct CGOGN_CORE_EXPORT CMap3 : public CMap2
 	{
 		static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
 		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
+		if (is_labeled(PHI1_PHI2_PHI3))
+			return foreach_dart_of_labeled_orbit(PHI1_PHI2_PHI3, d, f);
+
 		DartMarkerStore marker(*this);
 
 		std::vector<Dart> visited_face2;
@@ -191,6 +199,15 @@ struct CGOGN_CORE_EXPORT CMap3 : public CMap2
 		}
 	}
 
+	/**
+	 * @brief labels the connected components (PHI1_PHI2_PHI3 orbits) of the map: until the next change
+	 * of the topology, their traversals no longer use dart markers (see also CMap2::label_volumes)
+	 */
+	inline void label_connected_components()
+	{
+		label_orbits(PHI1_PHI2_PHI3, { phi1_.get(), phi2_.get(), phi3_.get() });
+	}
+
 	Volume close_hole(Dart d, bool set_indices = true);
 
 	uint32 close(bool set_indices = true);
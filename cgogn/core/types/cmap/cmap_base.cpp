@@ -23,15 +23,166 @@
 
 #include <cgogn/core/types/cmap/cmap_base.h>
 
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/thread_pool.h>
+
+#include <algorithm>
+
 namespace cgogn
 {
 
-CMapBase::CMapBase()
+CMapBase::CMapBase() : pure_simplicial_(false), labeled_orbits_(0u), connectivity_version_(0u), journal_epoch_(0u)
 {
 	boundary_marker_ = topology_.get_mark_attribute();
+	for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+	{
+		cells_representatives_outdated_[orbit].store(false, std::memory_order_relaxed);
+		nb_represented_cells_[orbit] = 0u;
+		cells_indices_versions_[orbit].store(0u, std::memory_order_relaxed);
+		cells_indices_changed_[orbit].store(false, std::memory_order_relaxed);
+	}
 }
 
 CMapBase::~CMapBase()
 {}
 
+void CMapBase::update_representatives(Orbit orbit) const
+{
+	std::lock_guard<std::mutex> lock(cells_representatives_mutex_);
+	if (!cells_representatives_outdated_[orbit].load(std::memory_order_acquire))
+		return;
+
+	// the cells that have non boundary darts but lost their representative take the first one
+	const Attribute<uint32>& indices = *cells_indices_[orbit];
+	Attribute<Dart>& representatives = *cells_representatives_[orbit];
+	topology_.foreach_live_index([&] (uint32 i) -> bool
+	{
+		const uint32 index = indices[i];
+		if (index != INVALID_INDEX && representatives[index].is_nil() && !is_boundary(Dart(i)))
+			representatives[index] = Dart(i);
+		return true;
+	});
+
+	cells_representatives_outdated_[orbit].store(false, std::memory_order_release);
+}
+
+void CMapBase::label_orbits(Orbit orbit, const std::vector<const Attribute<Dart>*>& generators)
+{
+	if (!orbits_labels_[orbit])
+	{
+		std::ostringstream oss;
+		oss << "__label_" << orbit_name(orbit);
+		orbits_labels_[orbit] = topology_.add_attribute<uint32>(oss.str());
+	}
+	if (!orbits_positions_[orbit])
+	{
+		std::ostringstream oss;
+		oss << "__position_" << orbit_name(orbit);
+		orbits_positions_[orbit] = topology_.add_attribute<uint32>(oss.str());
+	}
+	Attribute<uint32>& labels = *orbits_labels_[orbit];
+	Attribute<uint32>& ranks = *orbits_positions_[orbit];
+
+	ThreadPool* pool = thread_pool();
+	const uint32 end = topology_.maximum_index();
+	const uint32 grain = std::max(PARALLEL_BUFFER_SIZE, end / 256u);
+
+	// union-find on the darts: a set is linked under the root of smaller index,
+	// so the parents only decrease and the concurrent unions cannot create cycles
+	std::vector<std::atomic<uint32>> parents(end);
+	pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+			parents[i].store(i, std::memory_order_relaxed);
+	}, grain);
+
+	auto find = [&] (uint32 i) -> uint32
+	{
+		while (true)
+		{
+			uint32 p = parents[i].load(std::memory_order_relaxed);
+			if (p == i)
+				return i;
+			const uint32 gp = parents[p].load(std::memory_order_relaxed);
+			if (gp != p) // path halving (a failure only means that another thread shortened the path)
+				parents[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+			i = gp;
+		}
+	};
+
+	auto unite = [&] (uint32 a, uint32 b)
+	{
+		while (true)
+		{
+			a = find(a);
+			b = find(b);
+			if (a == b)
+				return;
+			if (a < b)
+				std::swap(a, b);
+			// a may have been linked by another thread in the meantime: retry from the new roots
+			uint32 expected = a;
+			if (parents[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+				return;
+		}
+	};
+
+	pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+		{
+			if (!topology_.is_used(i))
+				continue;
+			for (const Attribute<Dart>* g : generators)
+			{
+				const uint32 j = (*g)[i].index;
+				if (j != i)
+					unite(i, j);
+			}
+		}
+	}, grain);
+
+	// the roots are labeled in increasing order, then the other darts get the label of their root
+	uint32 nb_labels = 0u;
+	for (uint32 i = 0u; i < end; ++i)
+	{
+		if (topology_.is_used(i) && parents[i].load(std::memory_order_relaxed) == i)
+			labels[i] = nb_labels++;
+	}
+	pool->parallel_for(0u, end, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+		{
+			if (!topology_.is_used(i))
+				continue;
+			const uint32 root = find(i);
+			if (root != i)
+				labels[i] = labels[root];
+		}
+	}, grain);
+
+	// group the darts by label (counting sort) and rank them in their orbit
+	std::vector<uint32>& offsets = orbits_offsets_[orbit];
+	std::vector<Dart>& darts = orbits_darts_[orbit];
+	offsets.assign(nb_labels + 1u, 0u);
+	topology_.foreach_live_index([&] (uint32 i) -> bool
+	{
+		++offsets[labels[i] + 1u];
+		return true;
+	});
+	for (uint32 l = 0u; l < nb_labels; ++l)
+		offsets[l + 1u] += offsets[l];
+	darts.resize(offsets[nb_labels]);
+	std::vector<uint32> positions(offsets.begin(), offsets.end() - 1);
+	topology_.foreach_live_index([&] (uint32 i) -> bool
+	{
+		const uint32 l = labels[i];
+		ranks[i] = positions[l] - offsets[l];
+		darts[positions[l]++] = Dart(i);
+		return true;
+	});
+
+	labeled_orbits_ |= 1u << orbit;
+}
+
 } // namespace cgogn
@@ -30,13 +30,19 @@
 #include <cgogn/core/types/container/vector.h>
 #include <cgogn/core/types/container/chunk_array.h>
 #include <cgogn/core/types/cmap/cell.h>
+#include <cgogn/core/types/cmap/cells_journal.h>
 
 #include <cgogn/core/utils/type_traits.h>
 #include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/small_vector.h>
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/utils/assert.h>
 
 #include <array>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
 namespace cgogn
@@ -44,8 +50,15 @@ namespace cgogn
 
 struct CGOGN_CORE_EXPORT CMapBase
 {
-	// using AttributeContainer = AttributeContainerT<Vector>;
+	// Attributes storage policy:
+	// - ChunkArray: elements addresses are stable when the container grows
+	// - Vector: elements are contiguous (single copy VBO upload, vectorizable loops)
+	//   but references to attribute values are invalidated when new indices are created
+#ifdef CGOGN_USE_VECTOR_ATTRIBUTES
+	using AttributeContainer = AttributeContainerT<Vector>;
+#else
 	using AttributeContainer = AttributeContainerT<ChunkArray>;
+#endif
 
 	template <typename T>
 	using Attribute = AttributeContainer::Attribute<T>;
@@ -64,11 +77,56 @@ struct CGOGN_CORE_EXPORT CMapBase
 	// Cells attributes containers
 	mutable std::array<AttributeContainer, NB_ORBITS> attribute_containers_;
 
+	// representative darts of the indexed cells (stored in the cells containers):
+	// a non boundary dart of the cell, or a nil dart if the cell has none.
+	// The number of non boundary darts of each cell and the number of cells that have one are updated
+	// by set_index, unset_index, set_boundary and remove_dart. When a representative leaves a cell that
+	// keeps other non boundary darts, the cell gets a new one on the next access to the representatives.
+	std::array<std::shared_ptr<Attribute<Dart>>, NB_ORBITS> cells_representatives_;
+	std::array<std::shared_ptr<Attribute<uint32>>, NB_ORBITS> cells_nb_inner_darts_;
+	mutable std::array<std::atomic<bool>, NB_ORBITS> cells_representatives_outdated_;
+	std::array<std::atomic<uint32>, NB_ORBITS> nb_represented_cells_;
+	mutable std::mutex cells_representatives_mutex_;
+
+	// set when all the non boundary faces are triangles (and all the non boundary volumes are tetrahedra in a CMap3):
+	// the traversals and geometric computations on these cells then use their fixed degree.
+	// It is a runtime flag, set at import (or by check_pure_simplicial) and reset by any phi1 (un)sewing
+	// outside of the creation of a triangle, and by the phi2 (un)sewing of a CMap3 (that can change the volumes).
+	bool pure_simplicial_;
+
+	// labelings of the orbits that are traversed as a whole (volumes, connected components):
+	// the darts of the orbit labeled l are orbits_darts_[orbit][orbits_offsets_[orbit][l] .. orbits_offsets_[orbit][l + 1][
+	// in increasing order, and orbits_positions_ gives the rank of each dart in its orbit.
+	// They are computed by label_orbits and outdated by any change of the topology.
+	std::array<std::shared_ptr<Attribute<uint32>>, NB_ORBITS> orbits_labels_;
+	std::array<std::shared_ptr<Attribute<uint32>>, NB_ORBITS> orbits_positions_;
+	std::array<std::vector<uint32>, NB_ORBITS> orbits_offsets_;
+	std::array<std::vector<Dart>, NB_ORBITS> orbits_darts_;
+	uint32 labeled_orbits_; // bit set of the orbits whose labeling is up to date
+
+	// incremented by the changes of the topology (darts, relations and boundary marks): the structures
+	// built from the connectivity of the map (labelings, adjacency CSR, caches) check it to know if they are outdated
+	uint64 connectivity_version_;
+	// incremented by the changes of the cells indices of each orbit (new_index, set_index, unset_index, compaction).
+	// Concurrent index changes only set the flag, it is folded in the version when the version is read.
+	mutable std::array<std::atomic<uint64>, NB_ORBITS> cells_indices_versions_;
+	mutable std::array<std::atomic<bool>, NB_ORBITS> cells_indices_changed_;
+
+	// record of the changes since the last checkpoint, only allocated while it is enabled (see enable_journal).
+	// The recording is not thread safe: the topology and the cells indices should be changed by a single thread.
+	std::unique_ptr<CellsJournal> journal_;
+	uint64 journal_epoch_;
+
 	CMapBase();
 	virtual ~CMapBase();
 
 protected:
 
+	void update_representatives(Orbit orbit) const;
+
+	// labels the orbits generated by the given relations (parallel union-find on the darts)
+	void label_orbits(Orbit orbit, const std::vector<const Attribute<Dart>*>& generators);
+
 	std::shared_ptr<Attribute<Dart>> add_relation(const std::string& name)
 	{
 		return relations_.emplace_back(topology_.add_attribute<Dart>(name));
@@ -81,14 +139,284 @@ public:
 		return topology_.nb_elements();
 	}
 
+	inline void outdate_representatives(Orbit orbit) const
+	{
+		// avoid writing the shared flag when it is already set (e.g. concurrent set_index)
+		if (!cells_representatives_outdated_[orbit].load(std::memory_order_relaxed))
+			cells_representatives_outdated_[orbit].store(true, std::memory_order_release);
+	}
+
+	// the cells of the given indices have no dart yet
+	inline void init_cells_representatives(Orbit orbit, uint32 first, uint32 end) const
+	{
+		for (uint32 i = first; i < end; ++i)
+		{
+			(*cells_representatives_[orbit])[i] = Dart();
+			(*cells_nb_inner_darts_[orbit])[i] = 0u;
+		}
+	}
+
+	// the non boundary dart d enters the cell of the given index
+	inline void add_inner_dart(Orbit orbit, uint32 index, Dart d)
+	{
+		if ((*cells_nb_inner_darts_[orbit])[index]++ == 0u)
+			nb_represented_cells_[orbit].fetch_add(1u, std::memory_order_relaxed);
+		Dart& representative = (*cells_representatives_[orbit])[index];
+		if (representative.is_nil())
+			representative = d;
+	}
+
+	// the non boundary dart d leaves the cell of the given index
+	inline void remove_inner_dart(Orbit orbit, uint32 index, Dart d)
+	{
+		Dart& representative = (*cells_representatives_[orbit])[index];
+		if (--(*cells_nb_inner_darts_[orbit])[index] == 0u)
+		{
+			nb_represented_cells_[orbit].fetch_sub(1u, std::memory_order_relaxed);
+			representative = Dart();
+		}
+		else if (representative == d)
+		{
+			representative = Dart();
+			outdate_representatives(orbit);
+		}
+	}
+
+	inline void cells_indices_changed(Orbit orbit) const
+	{
+		// avoid writing the shared flag when it is already set (e.g. concurrent set_index)
+		if (!cells_indices_changed_[orbit].load(std::memory_order_relaxed))
+			cells_indices_changed_[orbit].store(true, std::memory_order_release);
+	}
+
 	inline void set_boundary(Dart d, bool b)
 	{
-		(*boundary_marker_)[d.index] = b ? 1u : 0u;
+		if (is_boundary(d) == b)
+			return;
+		++connectivity_version_; // the boundary marks define the traversed cells
+		journal_dart(d);
+		boundary_marker_->set(d.index, b);
+		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		{
+			if (cells_indices_[orbit])
+			{
+				const uint32 index = (*cells_indices_[orbit])[d.index];
+				if (index == INVALID_INDEX)
+					continue;
+				if (b)
+					remove_inner_dart(Orbit(orbit), index, d);
+				else
+					add_inner_dart(Orbit(orbit), index, d);
+			}
+		}
 	}
 
 	inline bool is_boundary(Dart d) const
 	{
-		return (*boundary_marker_)[d.index] != 0u;
+		return boundary_marker_->is_marked(d.index);
+	}
+
+	inline bool is_live_dart(Dart d) const
+	{
+		return topology_.is_used(d.index);
+	}
+
+	/**
+	 * @brief starts recording the changes of the map in a journal (or makes a checkpoint if it is already enabled)
+	 */
+	inline void enable_journal()
+	{
+		if (!journal_)
+			journal_ = std::make_unique<CellsJournal>();
+		checkpoint_journal();
+	}
+
+	inline void disable_journal()
+	{
+		journal_.reset();
+	}
+
+	/**
+	 * @brief clears the journal: it records the changes from this point
+	 * Incremental updates based on the journal are only possible for data that were up to date at the checkpoint.
+	 */
+	inline void checkpoint_journal()
+	{
+		cgogn_message_assert(journal_, "The journal is not enabled");
+		journal_->clear();
+		journal_->epoch = ++journal_epoch_;
+	}
+
+	inline const CellsJournal* journal() const
+	{
+		return journal_.get();
+	}
+
+	// an incomplete journal records nothing more until the next checkpoint
+	inline bool is_journaling() const
+	{
+		return journal_ && journal_->complete;
+	}
+
+	inline void journal_dart(Dart d) const
+	{
+		if (is_journaling())
+		{
+			journal_->darts.push_back(d);
+			check_journal_size();
+		}
+	}
+
+	inline void journal_darts(std::initializer_list<Dart> darts) const
+	{
+		if (is_journaling())
+		{
+			journal_->darts.insert(journal_->darts.end(), darts);
+			check_journal_size();
+		}
+	}
+
+	inline void journal_created_cell(Orbit orbit, uint32 index) const
+	{
+		if (is_journaling())
+			journal_->created_cells[orbit].push_back(index);
+	}
+
+	inline void journal_removed_cell(Orbit orbit, uint32 index) const
+	{
+		if (is_journaling())
+			journal_->removed_cells[orbit].push_back(index);
+	}
+
+	inline void journal_incomplete() const
+	{
+		if (is_journaling())
+		{
+			journal_->clear();
+			journal_->complete = false;
+		}
+	}
+
+	// beyond one record per dart of the map, an incremental update costs as much as a complete computation:
+	// the journal is then made incomplete instead of growing with the edits
+	inline void check_journal_size() const
+	{
+		if (journal_->darts.size() > topology_.maximum_index())
+			journal_incomplete();
+	}
+
+	inline bool is_pure_simplicial() const
+	{
+		return pure_simplicial_;
+	}
+
+	inline void set_pure_simplicial(bool b)
+	{
+		pure_simplicial_ = b;
+	}
+
+	inline uint64 connectivity_version() const
+	{
+		return connectivity_version_;
+	}
+
+	inline void connectivity_changed()
+	{
+		labeled_orbits_ = 0u;
+		++connectivity_version_;
+	}
+
+	/**
+	 * @brief version of the cells of the given orbit: it increases with any change of the topology
+	 * or of the indices of the cells of the orbit (a cache of these cells is valid while it is unchanged)
+	 */
+	inline uint64 cells_version(Orbit orbit) const
+	{
+		if (cells_indices_changed_[orbit].load(std::memory_order_acquire) &&
+			cells_indices_changed_[orbit].exchange(false, std::memory_order_acq_rel))
+			cells_indices_versions_[orbit].fetch_add(1u, std::memory_order_acq_rel);
+		return connectivity_version_ + cells_indices_versions_[orbit].load(std::memory_order_acquire);
+	}
+
+	inline bool is_labeled(Orbit orbit) const
+	{
+		return (labeled_orbits_ & (1u << orbit)) != 0u;
+	}
+
+	inline uint32 nb_labels(Orbit orbit) const
+	{
+		cgogn_message_assert(is_labeled(orbit), "Trying to access the labels of an unlabeled orbit");
+		return uint32(orbits_offsets_[orbit].size()) - 1u;
+	}
+
+	/**
+	 * @brief the smallest non boundary dart of the orbit labeled l (a nil dart if it has none)
+	 */
+	inline Dart labeled_orbit_representative(Orbit orbit, uint32 l) const
+	{
+		cgogn_message_assert(is_labeled(orbit), "Trying to access the labels of an unlabeled orbit");
+		const std::vector<Dart>& darts = orbits_darts_[orbit];
+		for (uint32 i = orbits_offsets_[orbit][l], end = orbits_offsets_[orbit][l + 1u]; i < end; ++i)
+		{
+			if (!is_boundary(darts[i]))
+				return darts[i];
+		}
+		return Dart();
+	}
+
+	/**
+	 * @brief applies f to d and then to the other darts of its labeled orbit (in increasing order)
+	 */
+	template <typename FUNC>
+	inline void foreach_dart_of_labeled_orbit(Orbit orbit, Dart d, const FUNC& f) const
+	{
+		cgogn_message_assert(is_labeled(orbit), "Trying to access the labels of an unlabeled orbit");
+		if (!f(d))
+			return;
+		const std::vector<Dart>& darts = orbits_darts_[orbit];
+		const uint32 l = (*orbits_labels_[orbit])[d.index];
+		for (uint32 i = orbits_offsets_[orbit][l], end = orbits_offsets_[orbit][l + 1u]; i < end; ++i)
+		{
+			if (darts[i] != d && !f(darts[i]))
+				break;
+		}
+	}
+
+	/**
+	 * @brief applies f to the smallest dart of each sub-orbit of the labeled orbit of d, in increasing order
+	 * (foreach_sub(x, g) applies g to the darts of the sub-orbit of x, which must lie in the labeled orbit).
+	 * Each dart is visited once: the sub-orbits are marked by the ranks of their darts in the labeled orbit,
+	 * in a bit set that is kept on the stack for the orbits of up to 1024 darts.
+	 */
+	template <typename SUB_FOREACH, typename FUNC>
+	inline void foreach_sub_orbit_of_labeled_orbit(Orbit orbit, Dart d, const SUB_FOREACH& foreach_sub,
+												   const FUNC& f) const
+	{
+		cgogn_message_assert(is_labeled(orbit), "Trying to access the labels of an unlabeled orbit");
+		const std::vector<Dart>& darts = orbits_darts_[orbit];
+		const Attribute<uint32>& positions = *orbits_positions_[orbit];
+		const uint32 l = (*orbits_labels_[orbit])[d.index];
+		const uint32 first = orbits_offsets_[orbit][l];
+		const uint32 end = orbits_offsets_[orbit][l + 1u];
+		const uint32 nb_words = (end - first + 63u) / 64u;
+		SmallVector<uint64, 16u> visited;
+		visited.reserve(nb_words);
+		for (uint32 w = 0u; w < nb_words; ++w)
+			visited.push_back(0u);
+		for (uint32 i = first; i < end; ++i)
+		{
+			const uint32 rank = i - first;
+			if (visited[rank / 64u] & (uint64(1u) << (rank % 64u)))
+				continue;
+			foreach_sub(darts[i], [&] (Dart it) -> bool
+			{
+				const uint32 r = positions[it.index];
+				visited[r / 64u] |= uint64(1u) << (r % 64u);
+				return true;
+			});
+			if (!f(darts[i]))
+				break;
+		}
 	}
 
 	template <typename CELL>
@@ -115,11 +443,26 @@ public:
 		static_assert (orbit < NB_ORBITS, "Unknown orbit parameter");
 		cgogn_message_assert(is_indexed<CELL>(), "Trying to access the cell index of an unindexed cell type");
 		const uint32 old = (*cells_indices_[orbit])[d.index];
+		const bool inner = !is_boundary(d);
 		// ref_line() is done before unref_line() to avoid deleting the indexed line if old == emb
 		attribute_containers_[orbit].ref_index(emb);		// ref the new emb
 		if (old != INVALID_INDEX)
-			attribute_containers_[orbit].unref_index(old);	// unref the old emb
+		{
+			// unref the old emb: its cell may have lost its last dart or its representative
+			if (inner && old != emb)
+				remove_inner_dart(orbit, old, d);
+			if (attribute_containers_[orbit].unref_index(old))
+				journal_removed_cell(orbit, old);
+			if (old != emb)
+				journal_dart(d); // (the initial indexing of the cells is not recorded)
+		}
 		(*cells_indices_[orbit])[d.index] = emb;			// affect the index to the dart
+		if (old != emb)
+		{
+			cells_indices_changed(orbit);
+			if (inner)
+				add_inner_dart(orbit, emb, d);
+		}
 	}
 
 	template <typename CELL>
@@ -130,7 +473,14 @@ public:
 		cgogn_message_assert(is_indexed<CELL>(), "Trying to access the cell index of an unindexed cell type");
 		const uint32 old = (*cells_indices_[orbit])[d.index];
 		if (old != INVALID_INDEX)
-			attribute_containers_[orbit].unref_index(old);	// unref the old emb
+		{
+			if (!is_boundary(d))
+				remove_inner_dart(orbit, old, d);
+			if (attribute_containers_[orbit].unref_index(old))
+				journal_removed_cell(orbit, old);
+			journal_dart(d);
+			cells_indices_changed(orbit);
+		}
 		(*cells_indices_[orbit])[d.index] = INVALID_INDEX;	// affect the index to the dart
 	}
 
@@ -154,13 +504,46 @@ public:
 			oss << "__index_" << orbit_name(orbit);
 			cells_indices_[orbit] = topology_.add_attribute<uint32>(oss.str());
 			cells_indices_[orbit]->fill(INVALID_INDEX);
+			cells_representatives_[orbit] = attribute_containers_[orbit].add_attribute<Dart>("__representatives");
+			cells_nb_inner_darts_[orbit] = attribute_containers_[orbit].add_attribute<uint32>("__nb_inner_darts");
+			// the existing cells have no dart yet
+			cells_representatives_[orbit]->fill(Dart());
+			cells_nb_inner_darts_[orbit]->fill(0u);
+			nb_represented_cells_[orbit].store(0u, std::memory_order_relaxed);
+			cells_indices_changed(orbit);
+			journal_incomplete();
 		}
 	}
 
+	/**
+	 * @brief finds a representative dart for the CELL cells whose representative has left them
+	 * @return the attribute of the representative darts, indexed by the cells indices
+	 */
+	template <typename CELL>
+	inline const Attribute<Dart>& cells_representatives() const
+	{
+		static const Orbit orbit = CELL::ORBIT;
+		static_assert(orbit < NB_ORBITS, "Unknown orbit parameter");
+		cgogn_message_assert(is_indexed<CELL>(), "Trying to access the representatives of an unindexed cell type");
+		if (cells_representatives_outdated_[orbit].load(std::memory_order_acquire))
+			update_representatives(orbit);
+		return *cells_representatives_[orbit];
+	}
+
+	// the number of indexed CELL cells that have a non boundary dart
+	template <typename CELL>
+	inline uint32 nb_indexed_cells() const
+	{
+		static_assert(CELL::ORBIT < NB_ORBITS, "Unknown orbit parameter");
+		return nb_represented_cells_[CELL::ORBIT].load(std::memory_order_relaxed);
+	}
+
 	inline Dart add_dart()
 	{
+		connectivity_changed();
 		uint32 index = topology_.new_index();
 		Dart d(index);
+		journal_dart(d);
 		for (auto rel : relations_)
 			(*rel)[d.index] = d;
 		for (auto emb : cells_indices_)
@@ -169,28 +552,114 @@ public:
 		return d;
 	}
 
+	// adds n darts with contiguous indices (taken after the last used index) and returns the first one
+	inline Dart add_darts(uint32 n)
+	{
+		cgogn_message_assert(n > 0u, "add_darts: at least one dart should be added");
+		connectivity_changed();
+		const uint32 first = topology_.new_indices(n);
+		const uint32 end = first + n;
+		if (is_journaling())
+		{
+			for (uint32 i = first; i < end; ++i)
+				journal_->darts.push_back(Dart(i));
+			check_journal_size();
+		}
+		for (auto rel : relations_)
+			for (uint32 i = first; i < end; ++i)
+				(*rel)[i] = Dart(i);
+		for (auto emb : cells_indices_)
+			if (emb)
+				for (uint32 i = first; i < end; ++i)
+					(*emb)[i] = INVALID_INDEX;
+		return Dart(first);
+	}
+
 	inline void remove_dart(Dart d)
 	{
+		connectivity_changed();
 		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
 		{
 			if (cells_indices_[orbit])
 			{
 				uint32 index = (*cells_indices_[orbit])[d.index];
 				if (index != INVALID_INDEX)
-					attribute_containers_[orbit].unref_index(index);
+				{
+					if (!is_boundary(d))
+						remove_inner_dart(Orbit(orbit), index, d);
+					if (attribute_containers_[orbit].unref_index(index))
+						journal_removed_cell(Orbit(orbit), index);
+				}
 			}
 		}
 		topology_.release_index(d.index);
 	}
 
+	/**
+	 * @brief packs the darts of the map in [0, nb_darts()[ and updates the relations accordingly
+	 * Dart handles and Dart valued attributes kept outside of the relations are invalidated.
+	 * @return the old dart index -> new dart index map
+	 */
+	inline std::vector<uint32> compact_topology()
+	{
+		connectivity_changed();
+		journal_incomplete();
+		std::vector<uint32> old_new = topology_.compact();
+		for (auto rel : relations_)
+		{
+			for (uint32 i = 0, end = topology_.maximum_index(); i < end; ++i)
+			{
+				Dart& d = (*rel)[i];
+				d = Dart(old_new[d.index]);
+			}
+		}
+		for (uint32 orbit = 0; orbit < NB_ORBITS; ++orbit)
+		{
+			if (cells_representatives_[orbit])
+			{
+				attribute_containers_[orbit].foreach_live_index([&] (uint32 i) -> bool
+				{
+					// (nil representatives stay nil)
+					Dart& d = (*cells_representatives_[orbit])[i];
+					d = d.index < old_new.size() ? Dart(old_new[d.index]) : Dart();
+					return true;
+				});
+			}
+		}
+		return old_new;
+	}
+
+	/**
+	 * @brief packs the indices of the CELL container in [0, nb_elements()[ and updates the cells indices of the darts
+	 * @return the old cell index -> new cell index map
+	 */
+	template <typename CELL>
+	inline std::vector<uint32> compact_cells()
+	{
+		static const Orbit orbit = CELL::ORBIT;
+		static_assert(orbit < NB_ORBITS, "Unknown orbit parameter");
+		std::vector<uint32> old_new = attribute_containers_[orbit].compact();
+		if (is_indexed<CELL>())
+		{
+			cells_indices_changed(orbit);
+			journal_incomplete();
+			topology_.foreach_live_index([&] (uint32 i) -> bool
+			{
+				uint32& index = (*cells_indices_[orbit])[i];
+				if (index != INVALID_INDEX)
+					index = old_new[index];
+				return true;
+			});
+		}
+		return old_new;
+	}
+
 	template <typename FUNC>
 	void foreach_dart(const FUNC& f) const
 	{
 		static_assert(is_func_parameter_same<FUNC, Dart>::value, "Given function should take a Dart as parameter");
 		static_assert(is_func_return_same<FUNC, bool>::value, "Given function should return a bool");
-		for (uint32 i = topology_.first_index(), last_index = topology_.last_index(); i < last_index; i = topology_.next_index(i))
-			if (!f(Dart(i)))
-				break;
+		topology_.foreach_live_index([&] (uint32 i) -> bool { return f(Dart(i)); });
 	}
 
 	inline Dart begin() const { return Dart(topology_.first_index()); }
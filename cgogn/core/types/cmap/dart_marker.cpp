@@ -49,4 +49,15 @@ DartMarkerStore::~DartMarkerStore()
 	map_.topology_.release_mark_attribute(mark_attribute_);
 }
 
+AtomicDartMarker::AtomicDartMarker(const CMapBase& map) : map_(map)
+{
+	mark_attribute_ = map_.topology_.get_mark_attribute();
+}
+
+AtomicDartMarker::~AtomicDartMarker()
+{
+	unmark_all();
+	map_.topology_.release_mark_attribute(mark_attribute_);
+}
+
 } // namespace cgogn
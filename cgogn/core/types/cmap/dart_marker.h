@@ -45,17 +45,17 @@ public:
 
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(DartMarker);
 
-	inline void mark(Dart d) { (*mark_attribute_)[d.index] = 1u; }
-	inline void unmark(Dart d) { (*mark_attribute_)[d.index] = 0u; }
+	inline void mark(Dart d) { mark_attribute_->mark(d.index); }
+	inline void unmark(Dart d) { mark_attribute_->unmark(d.index); }
 
 	inline bool is_marked(Dart d) const
 	{
-		return (*mark_attribute_)[d.index] != 0u;
+		return mark_attribute_->is_marked(d.index);
 	}
 
 	inline void unmark_all()
 	{
-		mark_attribute_->fill(0u);
+		mark_attribute_->unmark_all();
 	}
 };
 
@@ -78,7 +78,7 @@ public:
 	{
 		if (!is_marked(d))
 		{
-			(*mark_attribute_)[d.index] = 1u;
+			mark_attribute_->mark(d.index);
 			marked_darts_.push_back(d);
 		}
 	}
@@ -88,7 +88,7 @@ public:
 		auto it = std::find(marked_darts_.begin(), marked_darts_.end(), d);
 		if (it != marked_darts_.end())
 		{
-			(*mark_attribute_)[d.index] = 0u;
+			mark_attribute_->unmark(d.index);
 			std::swap(*it, marked_darts_.back());
 			marked_darts_.pop_back();
 		}
@@ -96,13 +96,13 @@ public:
 
 	inline bool is_marked(Dart d) const
 	{
-		return (*mark_attribute_)[d.index] != 0u;
+		return mark_attribute_->is_marked(d.index);
 	}
 
 	inline void unmark_all()
 	{
 		for (Dart d : marked_darts_)
-			(*mark_attribute_)[d.index] = 0u;
+			mark_attribute_->unmark(d.index);
 		marked_darts_.clear();
 	}
 
@@ -112,6 +112,42 @@ public:
 	}
 };
 
+/**
+ * AtomicDartMarker can be shared by the threads of a parallel traversal:
+ * its marks are set, unset and tested atomically
+ */
+class CGOGN_CORE_EXPORT AtomicDartMarker
+{
+private:
+
+	const CMapBase& map_;
+	CMapBase::MarkAttribute* mark_attribute_;
+
+public:
+
+	AtomicDartMarker(const CMapBase& map);
+	~AtomicDartMarker();
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(AtomicDartMarker);
+
+	inline void mark(Dart d) { mark_attribute_->atomic_mark(d.index); }
+	inline void unmark(Dart d) { mark_attribute_->atomic_unmark(d.index); }
+
+	// marks the dart and returns true iff it was not already marked
+	inline bool test_and_mark(Dart d) { return mark_attribute_->test_and_mark(d.index); }
+
+	inline bool is_marked(Dart d) const
+	{
+		return mark_attribute_->is_marked(d.index);
+	}
+
+	// should not be called concurrently with the other methods
+	inline void unmark_all()
+	{
+		mark_attribute_->unmark_all();
+	}
+};
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_TYPES_CMAP_DART_MARKER_H_
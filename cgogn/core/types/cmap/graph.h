@@ -68,13 +68,17 @@ struct CGOGN_CORE_EXPORT Graph : public CMapBase
 	/* alpha0 is an involution */
 	inline void alpha0_sew(Dart d, Dart e)
 	{
+		connectivity_changed();
+		journal_darts({ d, e });
 		(*alpha0_)[d.index] = e;
 		(*alpha0_)[e.index] = d;
 	}
 
 	inline void alpha0_unsew(Dart d)
 	{
+		connectivity_changed();
 		Dart e = alpha0(d);
+		journal_darts({ d, e });
 		(*alpha0_)[d.index] = d;
 		(*alpha0_)[e.index] = e;
 	}
@@ -82,8 +86,10 @@ struct CGOGN_CORE_EXPORT Graph : public CMapBase
 	/* alpha1 is a permutation */
 	inline void alpha1_sew(Dart d, Dart e)
 	{
+		connectivity_changed();
 		Dart f = alpha1(d);
 		Dart g = alpha1(e);
+		journal_darts({ d, e, f, g });
 		(*alpha1_)[d.index] = g;
 		(*alpha1_)[e.index] = f;
 		(*alpha_1_)[g.index] = d;
@@ -92,8 +98,10 @@ struct CGOGN_CORE_EXPORT Graph : public CMapBase
 
 	inline void alpha1_unsew(Dart d)
 	{
+		connectivity_changed();
 		Dart e = alpha1(d);
 		Dart f = alpha_1(d);
+		journal_darts({ d, e, f });
 		(*alpha1_)[f.index] = e;
 		(*alpha1_)[d.index] = d;
 		(*alpha_1_)[e.index] = f;
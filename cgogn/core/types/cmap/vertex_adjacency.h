@@ -0,0 +1,65 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_TYPES_CMAP_VERTEX_ADJACENCY_H_
+#define CGOGN_CORE_TYPES_CMAP_VERTEX_ADJACENCY_H_
+
+#include <cgogn/core/types/cmap/dart.h>
+
+#include <cgogn/core/utils/numerics.h>
+
+#include <vector>
+
+namespace cgogn
+{
+
+/**
+ * Snapshot of the vertex-vertex adjacency of a map in compressed sparse rows, over the vertex indices:
+ * the neighbours of the vertex of index v are stored in [offsets[v], offsets[v + 1][ (in the order of the
+ * darts of the vertex from its representative), with the dart of the neighbour vertex seen from v and
+ * optionally the edge index.
+ * It is only valid for the versions of the vertices (and edges) of the map it was built from (see build_adjacency_csr).
+ */
+struct VertexAdjacency
+{
+	uint64 vertices_version;
+	uint64 edges_version;
+	std::vector<uint32> offsets;
+	std::vector<uint32> neighbors;
+	std::vector<Dart> neighbor_darts;
+	std::vector<uint32> edges; // empty if the edge indices were not requested
+
+	inline uint32 degree(uint32 v) const
+	{
+		return offsets[v + 1u] - offsets[v];
+	}
+
+	inline bool has_edges() const
+	{
+		return edges.size() == neighbors.size();
+	}
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_TYPES_CMAP_VERTEX_ADJACENCY_H_
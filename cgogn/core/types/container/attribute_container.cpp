@@ -22,20 +22,30 @@
 *******************************************************************************/
 
 #include <cgogn/core/types/container/attribute_container.h>
+#include <cgogn/core/types/container/chunk_array.h>
 
-#include <cgogn/core/utils/thread_pool.h>
 #include <cgogn/core/utils/assert.h>
 
+#include <algorithm>
+
 namespace cgogn
 {
 
+static std::atomic<uint64> attributes_versions_counter(0u);
+
+static inline uint64 new_attribute_version()
+{
+	return attributes_versions_counter.fetch_add(1u, std::memory_order_relaxed) + 1u;
+}
+
 /////////////////////////
 // AttributeGenT class //
 /////////////////////////
 
 AttributeGenT::AttributeGenT(AttributeContainerGen* container, const std::string& name) :
 	container_(container),
-	name_(name)
+	name_(name),
+	version_(new_attribute_version())
 {}
 
 AttributeGenT::~AttributeGenT()
@@ -51,37 +61,37 @@ uint32 AttributeGenT::maximum_index() const
 	return 0;
 }
 
+uint64 AttributeGenT::version() const
+{
+	const uint64 v = version_.load(std::memory_order_acquire);
+	if (container_)
+		return std::max(v, container_->version_);
+	return v;
+}
+
+void AttributeGenT::set_modified()
+{
+	version_.store(new_attribute_version(), std::memory_order_release);
+}
+
 /////////////////////////////////
 // AttributeContainerGen class //
 /////////////////////////////////
 
 AttributeContainerGen::AttributeContainerGen() :
 	nb_elements_(0),
-	maximum_index_(0)
+	maximum_index_(0),
+	version_(0)
 {
 	attributes_.reserve(32);
 	attributes_shared_ptr_.reserve(32);
 
-	uint32 max_nb_threads = thread_pool()->max_nb_threads();
-	mark_attributes_.resize(max_nb_threads);
-	available_mark_attributes_.resize(max_nb_threads);
-	for (uint32 i = 0; i < max_nb_threads; ++i)
-	{
-		mark_attributes_[i].reserve(32);
-		available_mark_attributes_[i].reserve(32);
-	}
-	
 	available_indices_.reserve(1024);
+	used_indices_.reserve(1024);
 }
 
 AttributeContainerGen::~AttributeContainerGen()
-{
-	for (uint32 i = 0, nb = mark_attributes_.size(); i < nb; ++i)
-	{
-		for (AttributeGenT* mark_attribute : mark_attributes_[i])
-			delete mark_attribute;
-	}
-}
+{}
 
 uint32 AttributeContainerGen::new_index()
 {
@@ -96,28 +106,44 @@ uint32 AttributeContainerGen::new_index()
 
 	for (AttributeGenT* ag : attributes_)
 		ag->manage_index(index);
-	
-	{
-		std::lock_guard<std::mutex> lock(mark_attributes_mutex_);
-		for (uint32 i = 0, nb = mark_attributes_.size(); i < nb; ++i)
-		{
-			for (AttributeGenT* ag : mark_attributes_[i])
-				ag->manage_index(index);
-		}
-		init_mark_attributes(index);
-	}
 
+	init_mark_attributes(index);
 	init_ref_counter(index);
+	set_used(index);
+	elements_changed();
 
 	++nb_elements_;
 	return index;
 }
 
+uint32 AttributeContainerGen::new_indices(uint32 n)
+{
+	// the range is taken at the end of the container (holes are not reused) so that it is contiguous
+	const uint32 first = maximum_index_;
+	if (n == 0u)
+		return first;
+
+	maximum_index_ += n;
+	const uint32 last = maximum_index_ - 1u;
+
+	for (AttributeGenT* ag : attributes_)
+		ag->manage_index(last);
+
+	init_mark_attributes(first, maximum_index_);
+	init_ref_counter(first, maximum_index_);
+	set_used(first, maximum_index_);
+	elements_changed();
+
+	nb_elements_ += n;
+	return first;
+}
+
 void AttributeContainerGen::release_index(uint32 index)
 {
 	cgogn_message_assert(nb_refs(index) > 0, "Trying to release an unused index");
 	available_indices_.push_back(index);
 	reset_ref_counter(index);
+	set_unused(index);
 	--nb_elements_;
 }
 
@@ -145,6 +171,11 @@ void AttributeContainerGen::remove_attribute(AttributeGenT* attribute)
 	}
 }
 
+void AttributeContainerGen::elements_changed()
+{
+	version_ = new_attribute_version();
+}
+
 void AttributeContainerGen::delete_attribute(AttributeGenT* attribute)
 {
 	auto iter = std::find(attributes_.begin(), attributes_.end(), attribute);
@@ -155,4 +186,68 @@ void AttributeContainerGen::delete_attribute(AttributeGenT* attribute)
 	}
 }
 
+/////////////////////////
+// MarkAttribute class //
+/////////////////////////
+
+MarkAttribute::MarkAttribute() :
+	AttributeGenT(nullptr, "__mark"),
+	nb_words_(0u),
+	generation_(uint64(1u) << GENERATION_SHIFT),
+	in_use_(true),
+	next_(nullptr)
+{}
+
+MarkAttribute::~MarkAttribute()
+{
+	for (std::atomic<uint64>* chunk : chunks_)
+	{
+		std::destroy_n(chunk, CHUNK_SIZE);
+		free_chunk_memory(chunk);
+	}
+}
+
+void MarkAttribute::manage_index(uint32 index)
+{
+	while (index / NB_MARKS_PER_WORD >= nb_words_)
+	{
+		std::atomic<uint64>* chunk =
+			static_cast<std::atomic<uint64>*>(allocate_chunk_memory(CHUNK_SIZE * sizeof(std::atomic<uint64>)));
+		std::uninitialized_value_construct_n(chunk, CHUNK_SIZE); // generation 0 is never current: no mark is set
+		chunks_.push_back(chunk);
+		nb_words_ = uint32(chunks_.size()) * CHUNK_SIZE;
+	}
+}
+
+void MarkAttribute::move_index(uint32 from, uint32 to)
+{
+	set(to, is_marked(from));
+}
+
+void MarkAttribute::shrink(uint32 size)
+{
+	const uint32 nb_words = (size + NB_MARKS_PER_WORD - 1u) / NB_MARKS_PER_WORD;
+	const uint32 nb_chunks = (nb_words + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+	while (chunks_.size() > nb_chunks)
+	{
+		std::destroy_n(chunks_.back(), CHUNK_SIZE);
+		free_chunk_memory(chunks_.back());
+		chunks_.pop_back();
+	}
+	nb_words_ = uint32(chunks_.size()) * CHUNK_SIZE;
+}
+
+void MarkAttribute::clear_words()
+{
+	for (std::atomic<uint64>* chunk : chunks_)
+		for (uint32 i = 0u; i < CHUNK_SIZE; ++i)
+			chunk[i].store(0u, std::memory_order_relaxed);
+}
+
+std::size_t MarkAttribute::memory_footprint() const
+{
+	return sizeof(*this) + chunks_.capacity() * sizeof(std::atomic<uint64>*) +
+		   std::size_t(nb_words_) * sizeof(std::atomic<uint64>);
+}
+
 } // namespace cgogn
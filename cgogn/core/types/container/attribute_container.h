@@ -28,11 +28,12 @@
 
 #include <cgogn/core/utils/numerics.h>
 #include <cgogn/core/utils/thread.h>
+#include <cgogn/core/utils/assert.h>
 
 #include <vector>
 #include <string>
 #include <memory>
-#include <mutex>
+#include <atomic>
 
 namespace cgogn
 {
@@ -56,10 +57,24 @@ public:
 
 	uint32 maximum_index() const;
 
+	// number of bytes allocated by the attribute
+	virtual std::size_t memory_footprint() const = 0;
+
+	// version of the values of the attribute: it increases when they are signaled as modified
+	// and when the elements of the container are created or moved. The versions are taken from
+	// a counter shared by all the attributes, so a given version identifies the attribute values.
+	// The writes through value<T>() or operator[] do not change it.
+	uint64 version() const;
+	// to be called once the values have been written (not per written element).
+	// Writing the values without calling it leaves the caches built from them stale:
+	// e.g. MeshData::update_vbo does not fill the VBO again while the version is unchanged.
+	void set_modified();
+
 protected:
 
 	AttributeContainerGen* container_;
 	std::string name_;
+	std::atomic<uint64> version_;
 
 private:
 
@@ -67,6 +82,10 @@ private:
 	template <template <typename> class AttributeT> friend class AttributeContainerT;
 
 	virtual void manage_index(uint32 index) = 0;
+	// moves the element at index from to index to (used when compacting the container)
+	virtual void move_index(uint32 from, uint32 to) = 0;
+	// releases the storage allocated beyond the given size
+	virtual void shrink(uint32 size) = 0;
 };
 
 /////////////////////////////////
@@ -84,6 +103,7 @@ public:
 	inline uint32 maximum_index() const { return maximum_index_; }
 
 	uint32 new_index();
+	uint32 new_indices(uint32 n);
 	void release_index(uint32 index);
 
 	void remove_attribute(const std::shared_ptr<AttributeGenT>& attribute);
@@ -95,10 +115,7 @@ public:
 
 	inline uint32 first_index() const
 	{
-		uint32 index = 0u;
-		while (index < maximum_index_ && nb_refs(index) == 0)
-			++index;
-		return index;
+		return next_used_index(0u);
 	}
 
 	inline uint32 last_index() const
@@ -108,12 +125,45 @@ public:
 
 	inline uint32 next_index(uint32 index) const
 	{
-		do { ++index; }
-		while (
-			index < maximum_index_ &&
-			nb_refs(index) == 0
-		);
-		return index;
+		return next_used_index(index + 1u);
+	}
+
+	/**
+	 * @brief calls f on each used index of the container (in increasing order)
+	 * The occupancy bitmap is scanned one word at a time, so that empty ranges are skipped quickly
+	 * @param f a function that takes an uint32 and returns a bool (false to stop the traversal)
+	 */
+	template <typename FUNC>
+	inline void foreach_live_index(const FUNC& f) const
+	{
+		for (uint32 w = 0, nb_words = uint32(used_indices_.size()); w < nb_words; ++w)
+		{
+			uint64 word = used_indices_[w];
+			while (word != 0u)
+			{
+				if (!f((w << 6u) + count_trailing_zeros(word)))
+					return;
+				// clear the lowest set bit, and the indices that f released in the rest of the word
+				word &= (word - 1u) & used_indices_[w];
+			}
+		}
+	}
+
+	inline bool is_used(uint32 index) const
+	{
+		return index < maximum_index_ && (used_indices_[index >> 6u] & (uint64(1u) << (index & 63u))) != 0u;
+	}
+
+	// true if all the indices of [first, end[ are used (first and end should be multiples of 64)
+	inline bool all_used(uint32 first, uint32 end) const
+	{
+		cgogn_message_assert(first % 64u == 0u && end % 64u == 0u, "Range bounds should be multiples of 64");
+		if (end > maximum_index_)
+			return false;
+		for (uint32 w = first >> 6u, end_word = end >> 6u; w < end_word; ++w)
+			if (used_indices_[w] != ~uint64(0u))
+				return false;
+		return true;
 	}
 
 protected:
@@ -121,23 +171,216 @@ protected:
 	std::vector<AttributeGenT*> attributes_;
 	std::vector<std::shared_ptr<AttributeGenT>> attributes_shared_ptr_;
 
-	std::mutex mark_attributes_mutex_;
-	std::vector<std::vector<AttributeGenT*>> mark_attributes_;
-	std::vector<std::vector<uint32>> available_mark_attributes_;
-	
 	std::vector<uint32> available_indices_;
+	// occupancy bitmap: bit i is set iff index i is in use
+	std::vector<uint64> used_indices_;
 
 	uint32 nb_elements_;
 	uint32 maximum_index_;
+	uint64 version_; // version of the last creation or move of elements (see AttributeGenT::version)
 
 	friend AttributeGenT;
 
+	void elements_changed();
+
 	void delete_attribute(AttributeGenT* attribute);
 
 	virtual void init_ref_counter(uint32 index) = 0;
+	virtual void init_ref_counter(uint32 first, uint32 end) = 0;
 	virtual void reset_ref_counter(uint32 index) = 0;
 	virtual uint32 nb_refs(uint32 index) const = 0;
+	// manages & unmarks the given indices in the mark attributes in use
 	virtual void init_mark_attributes(uint32 index) = 0;
+	virtual void init_mark_attributes(uint32 first, uint32 end) = 0;
+
+	inline uint32 next_used_index(uint32 index) const
+	{
+		uint32 w = index >> 6u;
+		const uint32 nb_words = uint32(used_indices_.size());
+		if (w >= nb_words)
+			return maximum_index_;
+		uint64 word = used_indices_[w] & (~uint64(0u) << (index & 63u));
+		while (word == 0u)
+		{
+			if (++w >= nb_words)
+				return maximum_index_;
+			word = used_indices_[w];
+		}
+		return (w << 6u) + count_trailing_zeros(word);
+	}
+
+	inline void set_used(uint32 index)
+	{
+		const uint32 w = index >> 6u;
+		if (w >= used_indices_.size())
+			used_indices_.resize(w + 1u, 0u);
+		used_indices_[w] |= uint64(1u) << (index & 63u);
+	}
+
+	inline void set_used(uint32 first, uint32 end)
+	{
+		if (first >= end)
+			return;
+		const uint32 last_word = (end - 1u) >> 6u;
+		if (last_word >= used_indices_.size())
+			used_indices_.resize(last_word + 1u, 0u);
+		for (uint32 index = first; index < end && (index & 63u) != 0u; ++index)
+			used_indices_[index >> 6u] |= uint64(1u) << (index & 63u);
+		for (uint32 w = (first + 63u) >> 6u, end_word = end >> 6u; w < end_word; ++w)
+			used_indices_[w] = ~uint64(0u);
+		for (uint32 index = std::max(first, end & ~63u); index < end; ++index)
+			used_indices_[index >> 6u] |= uint64(1u) << (index & 63u);
+	}
+
+	inline void set_unused(uint32 index)
+	{
+		used_indices_[index >> 6u] &= ~(uint64(1u) << (index & 63u));
+	}
+};
+
+/////////////////////////
+// MarkAttribute class //
+/////////////////////////
+
+/**
+ * MarkAttribute stores one mark bit per element of a container, in atomic 64 bits words.
+ * Each word packs the marks of 56 consecutive elements with the 8 bits generation it was written in:
+ * the marks of a word whose generation differs from the current generation of the attribute are all unset.
+ * All the elements are thus unmarked at once by moving to the next generation, the words
+ * only being reset when the generation wraps around (every 255 calls).
+ * As the marks of different elements share a word, all the writes are atomic read-modify-write operations:
+ * the marks of distinct elements can be set concurrently (e.g. in a parallel traversal).
+ */
+class CGOGN_CORE_EXPORT MarkAttribute : public AttributeGenT
+{
+public:
+
+	static const uint32 NB_MARKS_PER_WORD = 56u;
+	static const uint32 CHUNK_SIZE = 1024u; // words per chunk
+
+private:
+
+	template <template <typename> class AttributeT> friend class AttributeContainerT;
+
+	static const uint32 GENERATION_SHIFT = 56u;
+	static const uint64 MARKS_MASK = (uint64(1u) << GENERATION_SHIFT) - 1u;
+
+	std::vector<std::atomic<uint64>*> chunks_;
+	uint32 nb_words_;
+	uint64 generation_; // current generation, already shifted in the high bits of a word
+
+	// mark attributes pool data
+	std::atomic<bool> in_use_;
+	MarkAttribute* next_;
+
+	void manage_index(uint32 index) override;
+	void move_index(uint32 from, uint32 to) override;
+	void shrink(uint32 size) override;
+	// resets all the words to generation 0
+	void clear_words();
+
+	inline std::atomic<uint64>& word(uint32 index) const
+	{
+		const uint32 w = index / NB_MARKS_PER_WORD;
+		cgogn_message_assert(w < nb_words_, "index out of bounds");
+		return chunks_[w / CHUNK_SIZE][w % CHUNK_SIZE];
+	}
+
+	static inline uint64 bit(uint32 index)
+	{
+		return uint64(1u) << (index % NB_MARKS_PER_WORD);
+	}
+
+public:
+
+	MarkAttribute();
+	~MarkAttribute() override;
+
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(MarkAttribute);
+
+	inline bool is_marked(uint32 index) const
+	{
+		const uint64 w = word(index).load(std::memory_order_relaxed);
+		return (w & ~MARKS_MASK) == generation_ && (w & bit(index)) != 0u;
+	}
+
+	inline void mark(uint32 index)
+	{
+		std::atomic<uint64>& aw = word(index);
+		const uint64 b = bit(index);
+		uint64 w = aw.load(std::memory_order_relaxed);
+		uint64 nw;
+		do
+		{
+			// a word of a former generation is reset to the current one
+			nw = ((w & ~MARKS_MASK) == generation_ ? w : generation_) | b;
+			if (nw == w)
+				return;
+		} while (!aw.compare_exchange_weak(w, nw, std::memory_order_relaxed, std::memory_order_relaxed));
+	}
+
+	inline void unmark(uint32 index)
+	{
+		std::atomic<uint64>& aw = word(index);
+		// the marks of a word of a former generation are already unset
+		if ((aw.load(std::memory_order_relaxed) & ~MARKS_MASK) == generation_)
+			aw.fetch_and(~bit(index), std::memory_order_relaxed);
+	}
+
+	inline void set(uint32 index, bool b)
+	{
+		if (b)
+			mark(index);
+		else
+			unmark(index);
+	}
+
+	// marks the element and returns true iff it was not already marked (by this or another thread)
+	inline bool test_and_mark(uint32 index)
+	{
+		std::atomic<uint64>& aw = word(index);
+		const uint64 b = bit(index);
+		uint64 w = aw.load(std::memory_order_relaxed);
+		uint64 nw;
+		do
+		{
+			if ((w & ~MARKS_MASK) != generation_)
+				nw = generation_ | b;
+			else if ((w & b) != 0u)
+				return false;
+			else
+				nw = w | b;
+		} while (!aw.compare_exchange_weak(w, nw, std::memory_order_acq_rel, std::memory_order_relaxed));
+		return true;
+	}
+
+	inline void atomic_mark(uint32 index)
+	{
+		test_and_mark(index);
+	}
+
+	inline void atomic_unmark(uint32 index)
+	{
+		std::atomic<uint64>& aw = word(index);
+		const uint64 b = bit(index);
+		uint64 w = aw.load(std::memory_order_relaxed);
+		while ((w & ~MARKS_MASK) == generation_ && (w & b) != 0u &&
+			   !aw.compare_exchange_weak(w, w & ~b, std::memory_order_acq_rel, std::memory_order_relaxed))
+			;
+	}
+
+	// unmarks all the elements (O(1) except when the generation wraps around)
+	inline void unmark_all()
+	{
+		generation_ += uint64(1u) << GENERATION_SHIFT;
+		if (generation_ == 0u)
+		{
+			clear_words();
+			generation_ = uint64(1u) << GENERATION_SHIFT;
+		}
+	}
+
+	std::size_t memory_footprint() const override;
 };
 
 ///////////////////////////////
@@ -152,18 +395,30 @@ public:
 	template <typename T>
 	using Attribute = AttributeT<T>;
 	using AttributeGen = AttributeGenT;
-	using MarkAttribute = Attribute<uint8>;
+	using MarkAttribute = cgogn::MarkAttribute;
 
 protected:
 
 	std::unique_ptr<Attribute<uint32>> ref_counter_;
 
+	// lock-free pool of mark attributes: a singly linked list whose nodes are only added at its head
+	// and deleted with the container, so that it can be traversed while other threads acquire marks.
+	// Free mark attributes are not managed by new_index and are only grown when acquired.
+	std::atomic<MarkAttribute*> mark_attributes_;
+
 	inline void init_ref_counter(uint32 index) override
 	{
 		static_cast<AttributeGenT*>(ref_counter_.get())->manage_index(index); // AttributeContainerT is friend of AttributeGenT
 		(*ref_counter_)[index] = 1u;
 	}
 
+	inline void init_ref_counter(uint32 first, uint32 end) override
+	{
+		static_cast<AttributeGenT*>(ref_counter_.get())->manage_index(end - 1u); // AttributeContainerT is friend of AttributeGenT
+		for (uint32 index = first; index < end; ++index)
+			(*ref_counter_)[index] = 1u;
+	}
+
 	inline void reset_ref_counter(uint32 index) override
 	{
 		(*ref_counter_)[index] = 0u;
@@ -176,29 +431,64 @@ protected:
 
 	inline void init_mark_attributes(uint32 index) override
 	{
-		for (uint32 i = 0, nb = mark_attributes_.size(); i < nb; ++i)
+		for (MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire); m != nullptr; m = m->next_)
 		{
-			for (AttributeGenT* mark_attribute : mark_attributes_[i])
+			if (m->in_use_.load(std::memory_order_acquire))
 			{
-				MarkAttribute* m = static_cast<MarkAttribute*>(mark_attribute);
-				(*m)[index] = 0u;
+				static_cast<AttributeGenT*>(m)->manage_index(index); // AttributeContainerT is friend of AttributeGenT
+				m->unmark(index);
+			}
+		}
+	}
+
+	inline void init_mark_attributes(uint32 first, uint32 end) override
+	{
+		for (MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire); m != nullptr; m = m->next_)
+		{
+			if (m->in_use_.load(std::memory_order_acquire))
+			{
+				static_cast<AttributeGenT*>(m)->manage_index(end - 1u); // AttributeContainerT is friend of AttributeGenT
+				for (uint32 index = first; index < end; ++index)
+					m->unmark(index);
 			}
 		}
 	}
 
 public:
 
-	AttributeContainerT() : AttributeContainerGen()
+	AttributeContainerT() : AttributeContainerGen(), mark_attributes_(nullptr)
 	{
 		ref_counter_ = std::make_unique<Attribute<uint32>>(nullptr, "__refs");
 	}
 
 	~AttributeContainerT()
-	{}
+	{
+		MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire);
+		while (m != nullptr)
+		{
+			MarkAttribute* next = m->next_;
+			delete m;
+			m = next;
+		}
+	}
 
 	template <typename T>
 	std::shared_ptr<Attribute<T>> add_attribute(const std::string& name)
 	{
+		return add_attribute_of_type<Attribute<T>>(name);
+	}
+
+	template <typename T>
+	std::shared_ptr<Attribute<T>> get_attribute(const std::string& name) const
+	{
+		return get_attribute_of_type<Attribute<T>>(name);
+	}
+
+	// adds an attribute of any type derived from AttributeGenT (e.g. with a specific storage layout)
+	template <typename ATTRIBUTE>
+	std::shared_ptr<ATTRIBUTE> add_attribute_of_type(const std::string& name)
+	{
+		static_assert(std::is_base_of<AttributeGenT, ATTRIBUTE>::value, "ATTRIBUTE should derive from AttributeGenT");
 		auto it = std::find_if(
 			attributes_.begin(),
 			attributes_.end(),
@@ -206,18 +496,18 @@ public:
 		);
 		if (it == attributes_.end())
 		{
-			std::shared_ptr<Attribute<T>> asp = std::make_shared<Attribute<T>>(this, name);
-			Attribute<T>* ap = asp.get();
+			std::shared_ptr<ATTRIBUTE> asp = std::make_shared<ATTRIBUTE>(this, name);
+			ATTRIBUTE* ap = asp.get();
 			static_cast<AttributeGenT*>(ap)->manage_index(maximum_index_); // AttributeContainerT is friend of AttributeGenT
 			attributes_.push_back(ap);
 			attributes_shared_ptr_.push_back(asp);
 			return asp;
 		}
-		return std::shared_ptr<Attribute<T>>();
+		return std::shared_ptr<ATTRIBUTE>();
 	}
 
-	template <typename T>
-	std::shared_ptr<Attribute<T>> get_attribute(const std::string& name) const
+	template <typename ATTRIBUTE>
+	std::shared_ptr<ATTRIBUTE> get_attribute_of_type(const std::string& name) const
 	{
 		auto it = std::find_if(
 			attributes_shared_ptr_.begin(),
@@ -225,34 +515,118 @@ public:
 			[&] (const auto& att) { return att->name().compare(name) == 0; }
 		);
 		if (it != attributes_shared_ptr_.end())
-			return std::dynamic_pointer_cast<Attribute<T>>(*it);
-		return std::shared_ptr<Attribute<T>>();
+			return std::dynamic_pointer_cast<ATTRIBUTE>(*it);
+		return std::shared_ptr<ATTRIBUTE>();
 	}
 
-	MarkAttribute* get_mark_attribute()
+	/**
+	 * @brief packs the used indices of the container in [0, nb_elements()[
+	 * Elements of all the attributes (including mark attributes) are moved from the end of the container into
+	 * the holes left by released indices, and the storage beyond the new maximum index is freed.
+	 * Attributes that store indices of this container must be updated by the caller.
+	 * @return the old index -> new index map (INVALID_INDEX for unused old indices)
+	 */
+	std::vector<uint32> compact()
 	{
-		uint32 thread_index = current_thread_index();
-		if (available_mark_attributes_[thread_index].size() > 0)
+		std::vector<uint32> old_new(maximum_index_, INVALID_INDEX);
+
+		uint32 down = 0u;
+		uint32 up = maximum_index_;
+		while (true)
 		{
-			uint32 index = available_mark_attributes_[thread_index].back();
-			available_mark_attributes_[thread_index].pop_back();
-			return static_cast<MarkAttribute*>(mark_attributes_[thread_index][index]);
+			// find the first hole
+			while (down < up && nb_refs(down) > 0u)
+			{
+				old_new[down] = down;
+				++down;
+			}
+			// find the last used index
+			while (up > down && nb_refs(up - 1u) == 0u)
+				--up;
+			if (down >= up)
+				break;
+
+			const uint32 from = up - 1u;
+			for (AttributeGenT* ag : attributes_)
+				ag->move_index(from, down);
+			// free mark attributes have no marked element and do not need to be updated
+			for (MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire); m != nullptr; m = m->next_)
+			{
+				if (m->in_use_.load(std::memory_order_acquire))
+					static_cast<AttributeGenT*>(m)->move_index(from, down);
+			}
+			(*ref_counter_)[down] = (*ref_counter_)[from];
+			(*ref_counter_)[from] = 0u;
+			old_new[from] = down;
+
+			++down;
+			--up;
 		}
-		else
+		cgogn_assert(down == nb_elements_);
+		elements_changed();
+
+		available_indices_.clear();
+		maximum_index_ = nb_elements_;
+
+		used_indices_.assign((maximum_index_ + 63u) / 64u, ~uint64(0u));
+		used_indices_.shrink_to_fit();
+		if (maximum_index_ % 64u != 0u)
+			used_indices_.back() = (uint64(1u) << (maximum_index_ % 64u)) - 1u;
+
+		for (AttributeGenT* ag : attributes_)
+			ag->shrink(maximum_index_);
+		for (MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire); m != nullptr; m = m->next_)
+			static_cast<AttributeGenT*>(m)->shrink(maximum_index_);
+		static_cast<AttributeGenT*>(ref_counter_.get())->shrink(maximum_index_);
+
+		return old_new;
+	}
+
+	// number of bytes allocated by the container (attributes, mark attributes and internal data)
+	std::size_t memory_footprint() const
+	{
+		std::size_t size = sizeof(*this);
+		for (AttributeGenT* ag : attributes_)
+			size += ag->memory_footprint();
+		for (MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire); m != nullptr; m = m->next_)
+			size += m->memory_footprint();
+		size += ref_counter_->memory_footprint();
+		size += available_indices_.capacity() * sizeof(uint32);
+		size += used_indices_.capacity() * sizeof(uint64);
+		return size;
+	}
+
+	/**
+	 * @brief acquires a mark attribute (with no marked element) from the pool
+	 * Mark attributes can be acquired and released concurrently from any thread,
+	 * but not concurrently with the creation of new indices in the container.
+	 */
+	MarkAttribute* get_mark_attribute()
+	{
+		for (MarkAttribute* m = mark_attributes_.load(std::memory_order_acquire); m != nullptr; m = m->next_)
 		{
-			MarkAttribute* ap = new MarkAttribute(nullptr, "__mark");
-			static_cast<AttributeGenT*>(ap)->manage_index(maximum_index_); // AttributeContainerT is friend of AttributeGenT
-			mark_attributes_[thread_index].push_back(ap);
-			return ap;
+			bool expected = false;
+			if (!m->in_use_.load(std::memory_order_relaxed) &&
+				m->in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire))
+			{
+				static_cast<AttributeGenT*>(m)->manage_index(maximum_index_); // AttributeContainerT is friend of AttributeGenT
+				return m;
+			}
 		}
+
+		MarkAttribute* m = new MarkAttribute();
+		static_cast<AttributeGenT*>(m)->manage_index(maximum_index_); // AttributeContainerT is friend of AttributeGenT
+		m->next_ = mark_attributes_.load(std::memory_order_relaxed);
+		while (!mark_attributes_.compare_exchange_weak(m->next_, m, std::memory_order_release, std::memory_order_relaxed))
+			;
+		return m;
 	}
 
+	// gives a mark attribute back to the pool (no element should be marked anymore)
 	void release_mark_attribute(MarkAttribute* attribute)
 	{
-		uint32 thread_index = current_thread_index();
-		auto it = std::find(mark_attributes_[thread_index].begin(), mark_attributes_[thread_index].end(), attribute);
-		cgogn_message_assert(it != mark_attributes_[thread_index].end(), "Mark Attribute not found on release");
-		available_mark_attributes_[thread_index].push_back(std::distance(mark_attributes_[thread_index].begin(), it));
+		cgogn_message_assert(attribute->in_use_.load(std::memory_order_relaxed), "Releasing a free mark attribute");
+		attribute->in_use_.store(false, std::memory_order_release);
 	}
 
 	inline void ref_index(uint32 index)
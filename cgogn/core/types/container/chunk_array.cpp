@@ -0,0 +1,103 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cgogn/core/types/container/chunk_array.h>
+
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace cgogn
+{
+
+namespace
+{
+
+const std::size_t CACHE_LINE_SIZE = 64u;
+const std::size_t HUGE_PAGE_SIZE = 2u * 1024u * 1024u;
+
+std::atomic<uint32> dynamic_chunk_size_(1024u);
+std::atomic<bool> huge_page_chunks_(false);
+
+} // namespace
+
+/////////////////////////////
+// ChunkArray memory tools //
+/////////////////////////////
+
+uint32 dynamic_chunk_size()
+{
+	return dynamic_chunk_size_;
+}
+
+void set_dynamic_chunk_size(uint32 chunk_size)
+{
+	cgogn_message_assert(chunk_size > 0u && (chunk_size & (chunk_size - 1u)) == 0u, "Chunk size should be a power of 2");
+	dynamic_chunk_size_ = chunk_size;
+}
+
+bool huge_page_chunks()
+{
+	return huge_page_chunks_;
+}
+
+void set_huge_page_chunks(bool b)
+{
+	huge_page_chunks_ = b;
+}
+
+void* allocate_chunk_memory(std::size_t size)
+{
+	void* p = nullptr;
+#ifdef _WIN32
+	p = _aligned_malloc(size, CACHE_LINE_SIZE);
+	if (!p)
+		throw std::bad_alloc();
+#else
+	const bool huge = huge_page_chunks_ && size >= HUGE_PAGE_SIZE;
+	if (posix_memalign(&p, huge ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE, size) != 0)
+		throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+	if (huge)
+		madvise(p, size, MADV_HUGEPAGE);
+#endif
+#endif
+	return p;
+}
+
+void free_chunk_memory(void* p)
+{
+#ifdef _WIN32
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+} // namespace cgogn
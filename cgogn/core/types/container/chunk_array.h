@@ -33,78 +33,158 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <algorithm>
 
 namespace cgogn
 {
 
+/////////////////////////////
+// ChunkArray memory tools //
+/////////////////////////////
+
+// chunk size used by the ChunkArrayT<T, 0> attributes created afterwards (must be a power of 2)
+CGOGN_CORE_EXPORT uint32 dynamic_chunk_size();
+CGOGN_CORE_EXPORT void set_dynamic_chunk_size(uint32 chunk_size);
+
+// when enabled, chunks of at least 2MB are aligned on huge pages and advised as such (Linux only)
+CGOGN_CORE_EXPORT bool huge_page_chunks();
+CGOGN_CORE_EXPORT void set_huge_page_chunks(bool b);
+
+// chunks storage is at least aligned on cache lines
+CGOGN_CORE_EXPORT void* allocate_chunk_memory(std::size_t size);
+CGOGN_CORE_EXPORT void free_chunk_memory(void* p);
+
 //////////////////////
 // ChunkArray class //
 //////////////////////
 
-template <typename T>
-class CGOGN_CORE_EXPORT ChunkArray : public AttributeGenT
+/**
+ * ChunkArrayT stores its elements in fixed size chunks (whose addresses never change)
+ * CHUNK_SIZE_ must be a power of 2, or 0 to use the dynamic_chunk_size() value at construction
+ */
+template <typename T, uint32 CHUNK_SIZE_>
+class CGOGN_CORE_EXPORT ChunkArrayT : public AttributeGenT
 {
+	static_assert((CHUNK_SIZE_ & (CHUNK_SIZE_ - 1u)) == 0u, "CHUNK_SIZE should be a power of 2");
+
 public:
 
-	static const uint32 CHUNK_SIZE = 1024;
+	static const uint32 CHUNK_SIZE = CHUNK_SIZE_;
 
 private:
 
 	std::vector<T*> chunks_;
 	uint32 capacity_;
+	uint32 chunk_shift_;
+	uint32 chunk_mask_;
+
+	inline T* new_chunk() const
+	{
+		T* chunk = static_cast<T*>(allocate_chunk_memory(chunk_size() * sizeof(T)));
+		std::uninitialized_value_construct_n(chunk, chunk_size());
+		return chunk;
+	}
+
+	inline void delete_chunk(T* chunk) const
+	{
+		std::destroy_n(chunk, chunk_size());
+		free_chunk_memory(chunk);
+	}
 
 	inline void manage_index(uint32 index) override
 	{
 		while (index >= capacity_)
 		{
-			chunks_.push_back(new T[CHUNK_SIZE]());
-			capacity_ = chunks_.size() * CHUNK_SIZE;
+			chunks_.push_back(new_chunk());
+			capacity_ = chunks_.size() * chunk_size();
+		}
+	}
+
+	inline void move_index(uint32 from, uint32 to) override
+	{
+		(*this)[to] = std::move((*this)[from]);
+	}
+
+	inline void shrink(uint32 size) override
+	{
+		const uint32 nb_chunks = (size + chunk_size() - 1u) / chunk_size();
+		while (chunks_.size() > nb_chunks)
+		{
+			delete_chunk(chunks_.back());
+			chunks_.pop_back();
 		}
+		capacity_ = chunks_.size() * chunk_size();
 	}
 
 public:
 
-	ChunkArray(AttributeContainerGen* container, const std::string& name) : AttributeGenT(container, name)
+	ChunkArrayT(AttributeContainerGen* container, const std::string& name) : AttributeGenT(container, name)
 	{
+		const uint32 cs = CHUNK_SIZE > 0u ? CHUNK_SIZE : dynamic_chunk_size();
+		cgogn_message_assert(cs > 0u && (cs & (cs - 1u)) == 0u, "Chunk size should be a power of 2");
+		chunk_shift_ = 0u;
+		while ((1u << chunk_shift_) < cs)
+			++chunk_shift_;
+		chunk_mask_ = cs - 1u;
 		chunks_.reserve(512u);
 		capacity_ = 0u;
 	}
 
-	~ChunkArray() override
+	~ChunkArrayT() override
 	{
 		for (auto chunk : chunks_)
-			delete[] chunk;
+			delete_chunk(chunk);
+	}
+
+	inline uint32 chunk_size() const
+	{
+		if constexpr (CHUNK_SIZE > 0u)
+			return CHUNK_SIZE;
+		else
+			return chunk_mask_ + 1u;
 	}
 
 	inline T& operator[](uint32 index)
 	{
 		cgogn_message_assert(index < capacity_, "index out of bounds");
-		return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+		if constexpr (CHUNK_SIZE > 0u)
+			return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+		else
+			return chunks_[index >> chunk_shift_][index & chunk_mask_];
 	}
 
 	inline const T& operator[](uint32 index) const
 	{
 		cgogn_message_assert(index < capacity_, "index out of bounds");
-		return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+		if constexpr (CHUNK_SIZE > 0u)
+			return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+		else
+			return chunks_[index >> chunk_shift_][index & chunk_mask_];
 	}
 
 	inline void fill(const T& value)
 	{
 		for (auto chunk : chunks_)
-			std::fill(chunk, chunk + CHUNK_SIZE, value);
+			std::fill(chunk, chunk + chunk_size(), value);
 	}
 
-	inline void swap(ChunkArray<T>* ca)
+	// the values can only be swapped or copied between attributes of the same container with the same chunk size
+	// (a DynamicChunkArray created after a set_dynamic_chunk_size may not match): returns false if nothing was done
+	inline bool swap(ChunkArrayT<T, CHUNK_SIZE_>* ca)
 	{
-		if (ca->container_ == this->container_)
-			chunks_.swap(ca->chunks_);
+		if (ca->container_ != this->container_ || ca->chunk_size() != chunk_size())
+			return false;
+		chunks_.swap(ca->chunks_);
+		return true;
 	}
 
-	inline void copy(ChunkArray<T>* ca)
+	inline bool copy(ChunkArrayT<T, CHUNK_SIZE_>* ca)
 	{
-		if (ca->container_ == this->container_)
-			for (uint32 i = 0; i < chunks_.size(); ++i)
-				std::copy(ca->chunks_[i], ca->chunks_[i] + CHUNK_SIZE, chunks_[i]);
+		if (ca->container_ != this->container_ || ca->chunk_size() != chunk_size())
+			return false;
+		for (uint32 i = 0; i < chunks_.size(); ++i)
+			std::copy(ca->chunks_[i], ca->chunks_[i] + chunk_size(), chunks_[i]);
+		return true;
 	}
 
 	inline uint32 nb_chunks() const
@@ -122,14 +202,19 @@ public:
 		return pointers;
 	}
 
+	inline std::size_t memory_footprint() const override
+	{
+		return sizeof(*this) + chunks_.capacity() * sizeof(T*) + std::size_t(capacity_) * sizeof(T);
+	}
+
 	class const_iterator
 	{
-		const ChunkArray<T>* ca_;
+		const ChunkArrayT<T, CHUNK_SIZE_>* ca_;
 		uint32 index_;
 
 	public:
 
-		inline const_iterator(const ChunkArray<T>* ca, uint32 index) : ca_(ca), index_(index)
+		inline const_iterator(const ChunkArrayT<T, CHUNK_SIZE_>* ca, uint32 index) : ca_(ca), index_(index)
 		{}
 		inline const_iterator(const const_iterator& it) : ca_(it.ca_), index_(it.index_)
 		{}
@@ -160,12 +245,12 @@ public:
 
 	class iterator
 	{
-		ChunkArray<T>* ca_;
+		ChunkArrayT<T, CHUNK_SIZE_>* ca_;
 		uint32 index_;
 
 	public:
 
-		inline iterator(ChunkArray<T>* ca, uint32 index) : ca_(ca), index_(index)
+		inline iterator(ChunkArrayT<T, CHUNK_SIZE_>* ca, uint32 index) : ca_(ca), index_(index)
 		{}
 		inline iterator(const iterator& it) : ca_(it.ca_), index_(it.index_)
 		{}
@@ -195,6 +280,12 @@ public:
 	inline iterator end() { return iterator(this, this->container_->last_index()); }
 };
 
+template <typename T>
+using ChunkArray = ChunkArrayT<T, 1024u>;
+
+template <typename T>
+using DynamicChunkArray = ChunkArrayT<T, 0u>;
+
 } // namespace cgogn
 
 #endif // CGOGN_CORE_CONTAINER_CHUNK_ARRAY_H_
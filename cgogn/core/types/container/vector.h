@@ -50,8 +50,20 @@ private:
 
 	inline void manage_index(uint32 index) override
 	{
-		while (index >= data_.size())
-			data_.push_back(T());
+		if (index >= data_.size())
+			data_.resize(index + 1u);
+	}
+
+	inline void move_index(uint32 from, uint32 to) override
+	{
+		data_[to] = std::move(data_[from]);
+	}
+
+	inline void shrink(uint32 size) override
+	{
+		if (size < data_.size())
+			data_.resize(size);
+		data_.shrink_to_fit();
 	}
 
 public:
@@ -81,21 +93,31 @@ public:
 		std::fill(data_.begin(), data_.end(), value);
 	}
 
-	inline void swap(Vector<T>* ca)
+	// the values can only be swapped or copied between attributes of the same container: returns false if nothing was done
+	inline bool swap(Vector<T>* ca)
 	{
-		if (ca->container_ == this->container_)
-			data_.swap(ca->data_);
+		if (ca->container_ != this->container_)
+			return false;
+		data_.swap(ca->data_);
+		return true;
 	}
 
-	inline void copy(Vector<T>* ca)
+	inline bool copy(Vector<T>* ca)
 	{
-		if (ca->container_ == this->container_)
-			data_ = ca->data_;
+		if (ca->container_ != this->container_)
+			return false;
+		data_ = ca->data_;
+		return true;
 	}
 
 	inline const void* data_pointer() const
 	{
-		return &data_[0];
+		return data_.data();
+	}
+
+	inline std::size_t memory_footprint() const override
+	{
+		return sizeof(*this) + data_.capacity() * sizeof(T);
 	}
 
 	class const_iterator
@@ -30,6 +30,8 @@
 #include <cgogn/core/utils/tuples.h>
 #include <cgogn/core/functions/traversals/global.h>
 
+#include <array>
+
 namespace cgogn
 {
 
@@ -47,13 +49,24 @@ class CellCache
 
 	const MESH& m_;
 	CellVectors cells_;
+	// versions of the mesh cells the vectors were built from (0 if they hold other cells)
+	std::array<uint64, std::tuple_size<CellVectors>::value> versions_;
+
+	template <typename CELL>
+	uint64& version()
+	{
+		return versions_[tuple_type_index<std::vector<CELL>, CellVectors>::value];
+	}
 
 public:
 
 	static const bool is_mesh_view = true;
 	using MeshType = MESH;
 
-	CellCache(const MESH& m) : m_(m) {}
+	CellCache(const MESH& m) : m_(m)
+	{
+		versions_.fill(0u);
+	}
 
 	MESH& mesh() { return const_cast<MESH&>(m_); }
 	const MESH& mesh() const { return m_; }
@@ -69,6 +82,7 @@ public:
 	std::vector<CELL>& cell_vector()
 	{
 		static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+		version<CELL>() = 0u; // the cells may be modified by the caller
 		return std::get<tuple_type_index<std::vector<CELL>, CellVectors>::value>(cells_);
 	}
 
@@ -97,9 +111,18 @@ public:
 	void build()
 	{
 		static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+		// all the cells are already cached if the mesh cells did not change since the last build
+		uint64 v = 0u;
+		if constexpr (std::is_base_of<CMapBase, MESH>::value)
+		{
+			v = m_.cells_version(CELL::ORBIT);
+			if (v == version<CELL>())
+				return;
+		}
 		std::vector<CELL>& cells = cell_vector<CELL>();
 		cells.clear();
 		foreach_cell(m_, [&] (CELL c) -> bool { cells.push_back(c); return true; });
+		version<CELL>() = v;
 	}
 
 	template <typename CELL, typename FUNC>
@@ -0,0 +1,132 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_UTILS_ENDIAN_H_
+#define CGOGN_CORE_UTILS_ENDIAN_H_
+
+#include <cgogn/core/utils/numerics.h>
+
+#include <cstring>
+#include <type_traits>
+
+namespace cgogn
+{
+
+#if defined(CGOGN_ENDIANNESS) && CGOGN_ENDIANNESS == CGOGN_BIG_ENDIAN
+static const bool cgogn_is_big_endian = true;
+static const bool cgogn_is_little_endian = false;
+#else
+static const bool cgogn_is_big_endian = false;
+static const bool cgogn_is_little_endian = true;
+#endif
+
+namespace internal
+{
+
+inline numerics::uint16 swap_endianness16u(numerics::uint16 x)
+{
+	return numerics::uint16((x >> 8) | (x << 8));
+}
+
+inline numerics::uint32 swap_endianness32u(numerics::uint32 x)
+{
+	return
+		((x >> 24) & 0x000000FFu) |
+		((x >>  8) & 0x0000FF00u) |
+		((x <<  8) & 0x00FF0000u) |
+		((x << 24) & 0xFF000000u);
+}
+
+inline numerics::uint64 swap_endianness64u(numerics::uint64 x)
+{
+	return
+		(numerics::uint64(swap_endianness32u(numerics::uint32(x))) << 32) |
+		numerics::uint64(swap_endianness32u(numerics::uint32(x >> 32)));
+}
+
+template <typename T, bool COND>
+inline T swap_endianness_if(T x)
+{
+	static_assert(std::is_arithmetic<T>::value, "swap_endianness works only on arithmetic types");
+	static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "unsupported size");
+
+	if (!COND || sizeof(T) == 1)
+		return x;
+
+	// go through unsigned integers of the same size (floating points included)
+	if constexpr (sizeof(T) == 2)
+	{
+		numerics::uint16 u;
+		std::memcpy(&u, &x, 2);
+		u = swap_endianness16u(u);
+		std::memcpy(&x, &u, 2);
+	}
+	else if constexpr (sizeof(T) == 4)
+	{
+		numerics::uint32 u;
+		std::memcpy(&u, &x, 4);
+		u = swap_endianness32u(u);
+		std::memcpy(&x, &u, 4);
+	}
+	else if constexpr (sizeof(T) == 8)
+	{
+		numerics::uint64 u;
+		std::memcpy(&u, &x, 8);
+		u = swap_endianness64u(u);
+		std::memcpy(&x, &u, 8);
+	}
+	return x;
+}
+
+} // namespace internal
+
+/**
+ * @brief swap the bytes of a value
+ */
+template <typename T>
+inline T swap_endianness(T x)
+{
+	return internal::swap_endianness_if<T, true>(x);
+}
+
+/**
+ * @brief convert a value between the native byte order and the little endian byte order (in both directions)
+ */
+template <typename T>
+inline T swap_endianness_native_little(T x)
+{
+	return internal::swap_endianness_if<T, cgogn_is_big_endian>(x);
+}
+
+/**
+ * @brief convert a value between the native byte order and the big endian byte order (in both directions)
+ */
+template <typename T>
+inline T swap_endianness_native_big(T x)
+{
+	return internal::swap_endianness_if<T, cgogn_is_little_endian>(x);
+}
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_ENDIAN_H_
@@ -0,0 +1,163 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_CORE_UTILS_SMALL_VECTOR_H_
+#define CGOGN_CORE_UTILS_SMALL_VECTOR_H_
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/assert.h>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace cgogn
+{
+
+/**
+ * SmallVector stores up to N elements in place and only allocates memory when it grows beyond N
+ * (the elements are then moved to a std::vector).
+ * T must be default constructible (the in place storage is constructed with the SmallVector).
+ */
+template <typename T, uint32 N>
+class SmallVector
+{
+	static_assert(N > 0u, "SmallVector should have a non zero in place capacity");
+
+	std::array<T, N> local_;
+	uint32 local_size_;
+	std::vector<T> heap_; // holds the elements when not empty (i.e. once N was exceeded)
+
+	inline bool on_heap() const { return !heap_.empty(); }
+
+	inline void move_to_heap(uint32 capacity)
+	{
+		heap_.reserve(capacity);
+		for (uint32 i = 0u; i < local_size_; ++i)
+			heap_.push_back(std::move(local_[i]));
+		local_size_ = 0u;
+	}
+
+public:
+
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	inline SmallVector() : local_size_(0u)
+	{}
+
+	inline SmallVector(std::initializer_list<T> l) : local_size_(0u)
+	{
+		reserve(uint32(l.size()));
+		for (const T& v : l)
+			push_back(v);
+	}
+
+	inline uint32 size() const { return on_heap() ? uint32(heap_.size()) : local_size_; }
+	inline bool empty() const { return size() == 0u; }
+	inline uint32 capacity() const { return on_heap() ? uint32(heap_.capacity()) : N; }
+
+	inline T* data() { return on_heap() ? heap_.data() : local_.data(); }
+	inline const T* data() const { return on_heap() ? heap_.data() : local_.data(); }
+
+	inline void reserve(uint32 capacity)
+	{
+		if (capacity <= N)
+			return;
+		if (on_heap())
+			heap_.reserve(capacity);
+		else if (local_size_ == 0u)
+			heap_.reserve(capacity); // the storage switches to the heap on the first push_back
+		else
+			move_to_heap(capacity);
+	}
+
+	inline void push_back(const T& v)
+	{
+		emplace_back(v);
+	}
+
+	inline void push_back(T&& v)
+	{
+		emplace_back(std::move(v));
+	}
+
+	template <typename... Args>
+	inline T& emplace_back(Args&&... args)
+	{
+		if (on_heap())
+			return heap_.emplace_back(std::forward<Args>(args)...);
+		if (local_size_ < N && heap_.capacity() == 0u)
+		{
+			T& v = local_[local_size_++];
+			v = T(std::forward<Args>(args)...);
+			return v;
+		}
+		move_to_heap(std::max(uint32(heap_.capacity()), 2u * N));
+		return heap_.emplace_back(std::forward<Args>(args)...);
+	}
+
+	inline void pop_back()
+	{
+		cgogn_message_assert(!empty(), "pop_back on an empty SmallVector");
+		if (on_heap())
+			heap_.pop_back();
+		else
+			--local_size_;
+	}
+
+	inline void clear()
+	{
+		heap_.clear(); // the heap capacity is kept (the next elements are directly stored there)
+		local_size_ = 0u;
+	}
+
+	inline T& operator[](uint32 i)
+	{
+		cgogn_message_assert(i < size(), "index out of bounds");
+		return data()[i];
+	}
+
+	inline const T& operator[](uint32 i) const
+	{
+		cgogn_message_assert(i < size(), "index out of bounds");
+		return data()[i];
+	}
+
+	inline T& front() { return (*this)[0u]; }
+	inline const T& front() const { return (*this)[0u]; }
+	inline T& back() { return (*this)[size() - 1u]; }
+	inline const T& back() const { return (*this)[size() - 1u]; }
+
+	inline iterator begin() { return data(); }
+	inline iterator end() { return data() + size(); }
+	inline const_iterator begin() const { return data(); }
+	inline const_iterator end() const { return data() + size(); }
+};
+
+} // namespace cgogn
+
+#endif // CGOGN_CORE_UTILS_SMALL_VECTOR_H_
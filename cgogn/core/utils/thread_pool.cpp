@@ -24,82 +24,353 @@
 #include <cgogn/core/utils/thread_pool.h>
 #include <cgogn/core/utils/thread.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
 namespace cgogn
 {
 
-ThreadPool::ThreadPool() :
-    stop_(false)
+namespace
 {
-	uint32 nb_ww = std::thread::hardware_concurrency() - 1;
-	nb_working_workers_ = nb_ww;
 
-	for (uint32 i = 0u; i < nb_ww; ++i)
+/**
+ * Chase-Lev work-stealing deque
+ * ("Dynamic Circular Work-Stealing Deque", Chase & Lev 2005, with the C11 memory
+ * orderings of "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013)
+ * Only the owner pushes and pops at the bottom, the other threads steal at the top.
+ * The group of each task is stored next to it, so that a thief can check it before
+ * taking the task (the task itself may already be done and destroyed).
+ */
+class WorkStealingDeque
+{
+	using Task = ThreadPool::Task;
+
+	struct Buffer
 	{
-		workers_.emplace_back([this, i] () -> void
+		int64 mask_;
+		std::unique_ptr<std::atomic<Task*>[]> tasks_;
+		std::unique_ptr<std::atomic<const void*>[]> groups_;
+
+		Buffer(int64 capacity) :
+			mask_(capacity - 1),
+			tasks_(new std::atomic<Task*>[std::size_t(capacity)]),
+			groups_(new std::atomic<const void*>[std::size_t(capacity)])
+		{}
+
+		inline int64 capacity() const { return mask_ + 1; }
+		inline Task* get(int64 i) const { return tasks_[std::size_t(i & mask_)].load(std::memory_order_relaxed); }
+		inline const void* group(int64 i) const { return groups_[std::size_t(i & mask_)].load(std::memory_order_relaxed); }
+		inline void put(int64 i, Task* t, const void* group)
 		{
-			thread_start(i + 1);
-			for(;;)
-			{
-				while (i >= nb_working_workers_)
-				{
-					std::unique_lock<std::mutex> lock(running_mutex_);
-					condition_running_.wait(lock);
-				}
-
-				std::unique_lock<std::mutex> lock(queue_mutex_);
-				condition_task_.wait(
-					lock,
-					[this] () { return stop_ || !tasks_.empty(); }
-				);
-
-				if (stop_ && tasks_.empty())
-				{
-					thread_stop();
-					return;
-				}
-				
-				if (i < nb_working_workers_)
-				{
-					PackagedTask task = std::move(tasks_.front());
-					tasks_.pop();
-					lock.unlock();
-#if defined(_MSC_VER) && _MSC_VER < 1900
-					(*task)();
-#else
-					task();
-#endif
-				}
-				else
-				{
-					lock.unlock();
-					condition_task_.notify_one();
-				}
-			}
-		});
+			tasks_[std::size_t(i & mask_)].store(t, std::memory_order_relaxed);
+			groups_[std::size_t(i & mask_)].store(group, std::memory_order_relaxed);
+		}
+	};
+
+	alignas(64) std::atomic<int64> top_;
+	alignas(64) std::atomic<int64> bottom_;
+	std::atomic<Buffer*> buffer_;
+	// the replaced buffers are kept alive as thieves may still read them
+	std::vector<std::unique_ptr<Buffer>> buffers_;
+
+public:
+
+	WorkStealingDeque() : top_(0), bottom_(0)
+	{
+		buffers_.push_back(std::make_unique<Buffer>(256));
+		buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+	}
+
+	void push(Task* t)
+	{
+		const int64 b = bottom_.load(std::memory_order_relaxed);
+		const int64 top = top_.load(std::memory_order_acquire);
+		Buffer* a = buffer_.load(std::memory_order_relaxed);
+		if (b - top > a->capacity() - 1)
+		{
+			buffers_.push_back(std::make_unique<Buffer>(a->capacity() * 2));
+			Buffer* grown = buffers_.back().get();
+			for (int64 i = top; i < b; ++i)
+				grown->put(i, a->get(i), a->group(i));
+			buffer_.store(grown, std::memory_order_release);
+			a = grown;
+		}
+		a->put(b, t, t->group());
+		bottom_.store(b + 1, std::memory_order_seq_cst);
+	}
+
+	Task* pop()
+	{
+		const int64 b = bottom_.load(std::memory_order_relaxed) - 1;
+		Buffer* a = buffer_.load(std::memory_order_relaxed);
+		bottom_.store(b, std::memory_order_seq_cst);
+		int64 top = top_.load(std::memory_order_seq_cst);
+		if (top > b)
+		{
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		Task* t = a->get(b);
+		if (top == b)
+		{
+			// last task: race against the thieves
+			if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				t = nullptr;
+			bottom_.store(b + 1, std::memory_order_relaxed);
+		}
+		return t;
+	}
+
+	// steals the top task if it belongs to the given group (any task if group is nullptr)
+	Task* steal(const void* group)
+	{
+		int64 top = top_.load(std::memory_order_seq_cst);
+		const int64 b = bottom_.load(std::memory_order_seq_cst);
+		if (top >= b)
+			return nullptr;
+		Buffer* a = buffer_.load(std::memory_order_acquire);
+		Task* t = a->get(top);
+		if (group && a->group(top) != group)
+			return nullptr;
+		if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+		return t;
+	}
+};
+
+} // namespace
+
+struct ThreadPool::Worker
+{
+	WorkStealingDeque tasks_;
+	uint32 random_state_;
+
+	Worker(uint32 index) : random_state_(2u * index + 1u)
+	{}
+
+	// xorshift, used to choose the first victim of the steals
+	inline uint32 random()
+	{
+		random_state_ ^= random_state_ << 13;
+		random_state_ ^= random_state_ >> 17;
+		random_state_ ^= random_state_ << 5;
+		return random_state_;
 	}
+};
+
+static CGOGN_TLS const ThreadPool* current_pool_ = nullptr;
+static CGOGN_TLS ThreadPool::Worker* current_worker_ = nullptr;
+static CGOGN_TLS const void* current_group_ = nullptr;
+
+// executes the task in its fork/join tree (the task may delete itself)
+static void execute_task(ThreadPool::Task* t)
+{
+	const void* previous = current_group_;
+	current_group_ = t->group();
+	t->execute();
+	current_group_ = previous;
+}
+
+ThreadPool::ThreadPool() :
+	nb_injected_tasks_(0u),
+	nb_sleeping_workers_(0u),
+	wake_up_epoch_(0u),
+	stop_(false)
+{
+	uint32 nb_ww = std::max(1u, std::thread::hardware_concurrency()) - 1u;
+	// the CGOGN_NB_WORKERS environment variable overrides the number of workers
+	// (e.g. to run the parallel code on a single core machine), up to MAX_ENV_NB_WORKERS
+	if (const char* nb = std::getenv("CGOGN_NB_WORKERS"))
+	{
+		const std::string value(nb);
+		if (!value.empty() && value.size() < 10u &&
+			std::all_of(value.begin(), value.end(), [] (char c) { return c >= '0' && c <= '9'; }))
+			nb_ww = std::min(uint32(std::stoul(value)), MAX_ENV_NB_WORKERS);
+		else
+			std::cerr << "CGOGN_NB_WORKERS=\"" << value << "\" is not a number of workers (ignored)" << std::endl;
+	}
+	nb_working_workers_ = nb_ww;
+
+	// all the deques exist before the workers start stealing
+	for (uint32 i = 0u; i < nb_ww; ++i)
+		workers_data_.push_back(std::make_unique<Worker>(i));
+	for (uint32 i = 0u; i < nb_ww; ++i)
+		workers_.emplace_back([this, i] () -> void { worker_loop(i); });
 
 	std::cout << "ThreadPool launched with " << nb_working_workers_ << " workers" << std::endl;
 }
 
 ThreadPool::~ThreadPool()
 {
+	// all the workers help to finish the remaining tasks
 	nb_working_workers_ = uint32(workers_.size());
-	condition_running_.notify_all();
-
 	{
-		std::unique_lock<std::mutex> lock(queue_mutex_);
+		std::unique_lock<std::mutex> lock(sleep_mutex_);
 		stop_ = true;
+		++wake_up_epoch_;
 	}
-
-#if !(defined(CGOGN_WIN_VER) && (CGOGN_WIN_VER <= 61))
-	condition_running_.notify_all();
 	condition_task_.notify_all();
-#endif
+	condition_running_.notify_all();
 
 	for (std::thread& worker : workers_)
 		worker.join();
 }
 
+bool ThreadPool::is_worker() const
+{
+	return current_pool_ == this;
+}
+
+const void*& ThreadPool::current_group()
+{
+	return current_group_;
+}
+
+void ThreadPool::push_task(Task* task)
+{
+	// the deques only hold the tasks of fork/join trees: a worker always waits for the ones it spawns
+	if (current_pool_ == this && task->group())
+		current_worker_->tasks_.push(task);
+	else
+	{
+		std::unique_lock<std::mutex> lock(injection_mutex_);
+		injected_tasks_.push_back(task);
+		++nb_injected_tasks_;
+	}
+	wake_up_workers(false);
+}
+
+void ThreadPool::wake_up_workers(bool all)
+{
+	// a working worker registers itself as sleeping before its last search for a task:
+	// either it finds the pushed task or it is seen here
+	if (!all && nb_sleeping_workers_.load() == 0u)
+		return;
+	{
+		std::unique_lock<std::mutex> lock(sleep_mutex_);
+		++wake_up_epoch_;
+	}
+	// only the working workers wait on condition_task_: one of them is enough for one task
+	if (all)
+	{
+		condition_task_.notify_all();
+		condition_running_.notify_all();
+	}
+	else
+		condition_task_.notify_one();
+}
+
+ThreadPool::Task* ThreadPool::find_task(Worker* w, const void* group)
+{
+	if (Task* t = w->tasks_.pop())
+	{
+		// the tasks above the waited one were spawned in the same tree
+		cgogn_message_assert(!group || t->group() == group, "A worker deque mixes fork/join trees");
+		return t;
+	}
+
+	if (!group && nb_injected_tasks_.load() > 0u)
+	{
+		std::unique_lock<std::mutex> lock(injection_mutex_);
+		if (!injected_tasks_.empty())
+		{
+			Task* t = injected_tasks_.front();
+			injected_tasks_.pop_front();
+			--nb_injected_tasks_;
+			return t;
+		}
+	}
+
+	const uint32 nb = uint32(workers_data_.size());
+	const uint32 first = w->random() % nb;
+	for (uint32 i = 0u; i < nb; ++i)
+	{
+		Worker* victim = workers_data_[(first + i) % nb].get();
+		if (victim == w)
+			continue;
+		if (Task* t = victim->tasks_.steal(group))
+			return t;
+	}
+
+	return nullptr;
+}
+
+void ThreadPool::wait_until(const std::atomic<bool>& done)
+{
+	cgogn_message_assert(is_worker(), "Only the workers of the pool can wait for a spawned task");
+	// the tasks of other trees may block or be long: only the tasks of the waited tree are executed
+	const void* group = current_group_;
+	while (!done.load(std::memory_order_acquire))
+	{
+		if (Task* t = find_task(current_worker_, group))
+			t->execute();
+		else
+			std::this_thread::yield();
+	}
+}
+
+void ThreadPool::worker_loop(uint32 index)
+{
+	thread_start(index + 1);
+	current_pool_ = this;
+	current_worker_ = workers_data_[index].get();
+
+	// number of unsuccessful searches before sleeping
+	const uint32 nb_spins = 64u;
+	uint32 nb_failures = 0u;
+
+	for (;;)
+	{
+		if (index >= nb_working_workers_.load(std::memory_order_relaxed))
+		{
+			// the remaining own tasks are executed before waiting to work again
+			if (Task* t = current_worker_->tasks_.pop())
+			{
+				execute_task(t);
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleep_mutex_);
+			condition_running_.wait(lock, [&] () { return stop_.load() || index < nb_working_workers_.load(); });
+			nb_failures = 0u;
+			continue;
+		}
+
+		if (Task* t = find_task(current_worker_, nullptr))
+		{
+			execute_task(t);
+			nb_failures = 0u;
+			continue;
+		}
+		if (++nb_failures < nb_spins)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		++nb_sleeping_workers_;
+		const uint64 epoch = wake_up_epoch_.load();
+		Task* t = find_task(current_worker_, nullptr);
+		const bool stop = stop_.load();
+		if (!t && !stop)
+		{
+			std::unique_lock<std::mutex> lock(sleep_mutex_);
+			condition_task_.wait(lock, [&] () { return stop_.load() || wake_up_epoch_.load() != epoch; });
+		}
+		--nb_sleeping_workers_;
+
+		if (t)
+			execute_task(t);
+		else if (stop)
+			break;
+		nb_failures = 0u;
+	}
+
+	current_worker_ = nullptr;
+	current_pool_ = nullptr;
+	thread_stop();
+}
+
 void ThreadPool::set_nb_workers(uint32 nb)
 {
 	if (nb == 0xffffffff)
@@ -107,7 +378,7 @@ void ThreadPool::set_nb_workers(uint32 nb)
 	else
 		nb_working_workers_ = std::min(uint32(workers_.size()), nb);
 
-	condition_running_.notify_all();
+	wake_up_workers(true);
 
 	std::cout << "ThreadPool now using " << nb_working_workers_ << " workers" << std::endl;
 }
@@ -63,13 +63,17 @@
 
 #include <iostream>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <future>
 #include <functional>
+#include <exception>
+#include <optional>
+#include <algorithm>
 
 namespace cgogn
 {
@@ -97,14 +101,45 @@ private:
 	std::ptrdiff_t count_ = 0;
 };
 
+/**
+ * Work-stealing thread pool
+ * Each worker owns a deque of tasks: it pushes and pops the tasks it spawns at the bottom
+ * while idle workers steal from the top (lock-free, Chase-Lev deque).
+ * Tasks enqueued from outside of the pool go through an injection queue.
+ * parallel_for and parallel_reduce split the range recursively (fork/join): a worker waiting
+ * for a half of the range to be done executes the other tasks of the same fork/join tree
+ * (nested calls included) instead of blocking.
+ */
 class CGOGN_CORE_EXPORT ThreadPool final
 {
 public:
 
+	// maximum number of workers that can be asked with the CGOGN_NB_WORKERS environment variable
+	static constexpr uint32 MAX_ENV_NB_WORKERS = 256u;
+
 	ThreadPool();
 	~ThreadPool();
 	CGOGN_NOT_COPYABLE_NOR_MOVABLE(ThreadPool);
 
+	class Task
+	{
+	public:
+
+		Task(const void* group = nullptr) : group_(group)
+		{}
+		virtual ~Task() {}
+		// executed once by a thread of the pool, that may delete the task
+		virtual void execute() = 0;
+		// the fork/join tree of the task (nullptr for the enqueued tasks)
+		inline const void* group() const { return group_; }
+
+	private:
+
+		const void* group_;
+	};
+
+	struct Worker;
+
 #if defined(_MSC_VER) && _MSC_VER < 1900
 	using PackagedTask = std::shared_ptr<std::packaged_task<void()>>; // avoiding a MSVC 2013 Bug
 #else
@@ -124,21 +159,15 @@ public:
 		std::future<void> res = task.get_future();
 #endif
 
+		// don't allow enqueueing after stopping the pool
+		if (stop_.load(std::memory_order_relaxed))
 		{
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			// don't allow enqueueing after stopping the pool
-			if (stop_)
-			{
-				std::cout << "ThreadPool::enqueue : Enqueue on stopped ThreadPool." << std::endl;
-				cgogn_assert_not_reached("Enqueue on stopped ThreadPool");
-			}
-			// Push work back on the queue
-			tasks_.push(std::move(task));
+			std::cout << "ThreadPool::enqueue : Enqueue on stopped ThreadPool." << std::endl;
+			cgogn_assert_not_reached("Enqueue on stopped ThreadPool");
 		}
-		
-		// Notify a thread that there is new work to perform
-		condition_task_.notify_one();
-		
+
+		push_task(new HeapTask<PackagedTask>(std::move(task)));
+
 		return res;
 	}
 
@@ -157,6 +186,60 @@ public:
 			future.wait();
 	}
 
+	/**
+	 * @brief calls f(first, last) on subranges of [begin, end[ that are processed in parallel
+	 * @param f the function called on each subrange
+	 * @param grain_size the maximum size of the subranges (0 = 1/256 of the range)
+	 * Can be called from inside a task. Without working workers, f is called on the whole range.
+	 * An exception thrown by f is rethrown once the spawned subranges are done.
+	 */
+	template <typename FUNC>
+	void parallel_for(uint32 begin, uint32 end, const FUNC& f, uint32 grain_size = 0u)
+	{
+		static_assert(std::is_same<decltype(f(begin, end)), void>::value, "Given function should not return a value");
+		if (begin >= end)
+			return;
+		const uint32 grain = range_grain_size(begin, end, grain_size);
+		if (nb_working_workers_ == 0u || end - begin <= grain)
+			f(begin, end);
+		else if (is_worker())
+		{
+			GroupScope scope(&grain);
+			parallel_for_range(begin, end, grain, f);
+		}
+		else
+			enqueue([&] () { GroupScope scope(&grain); parallel_for_range(begin, end, grain, f); }).get();
+	}
+
+	/**
+	 * @brief reduces the values map(first, last) computed on subranges of [begin, end[ with combine
+	 * @param identity the neutral element of combine
+	 * @param map the function that computes the value of a subrange
+	 * @param combine the function that combines the values of two consecutive subranges
+	 * @param grain_size the maximum size of the subranges (0 = 1/256 of the range)
+	 * The subranges and the combination tree only depend on the range and the grain size:
+	 * the result is the same whatever the number of workers and the thread that computes each part.
+	 */
+	template <typename T, typename MAP, typename COMBINE>
+	T parallel_reduce(uint32 begin, uint32 end, const T& identity, const MAP& map, const COMBINE& combine, uint32 grain_size = 0u)
+	{
+		static_assert(std::is_convertible<decltype(map(begin, end)), T>::value, "Wrong map function return type");
+		static_assert(std::is_convertible<decltype(combine(identity, identity)), T>::value, "Wrong combine function return type");
+		if (begin >= end)
+			return identity;
+		const uint32 grain = range_grain_size(begin, end, grain_size);
+		if (nb_working_workers_ == 0u || end - begin <= grain)
+			return reduce_range<T>(begin, end, grain, map, combine, false);
+		if (is_worker())
+		{
+			GroupScope scope(&grain);
+			return reduce_range<T>(begin, end, grain, map, combine, true);
+		}
+		T result = identity;
+		enqueue([&] () { GroupScope scope(&grain); result = reduce_range<T>(begin, end, grain, map, combine, true); }).get();
+		return result;
+	}
+
 	/**
 	* @brief get the number of currently working thread for parallel algos
 	*/
@@ -184,27 +267,194 @@ public:
 	*/
 	void set_nb_workers(uint32 nb = 0xffffffff);
 
+	/**
+	 * @brief is the calling thread a worker of this pool
+	 */
+	bool is_worker() const;
+
 private:
 
+	template <typename F>
+	class HeapTask : public Task
+	{
+		F f_;
+
+	public:
+
+		HeapTask(F&& f) : f_(std::move(f))
+		{}
+
+		void execute() override
+		{
+#if defined(_MSC_VER) && _MSC_VER < 1900
+			(*f_)();
+#else
+			f_();
+#endif
+			delete this;
+		}
+	};
+
+	// task that lives on the stack of the thread that spawns it and waits for it
+	template <typename F>
+	class JoinTask : public Task
+	{
+		const F& f_;
+		std::atomic<bool> done_;
+		// the exception thrown by f, rethrown by the thread that waits for the task
+		std::exception_ptr exception_;
+
+	public:
+
+		JoinTask(const F& f, const void* group) : Task(group), f_(f), done_(false)
+		{}
+
+		void execute() override
+		{
+			try
+			{
+				f_();
+			}
+			catch (...)
+			{
+				exception_ = std::current_exception();
+			}
+			done_.store(true, std::memory_order_release);
+		}
+
+		const std::atomic<bool>& done() const
+		{
+			return done_;
+		}
+
+		void rethrow_exception() const
+		{
+			if (exception_)
+				std::rethrow_exception(exception_);
+		}
+	};
+
+	// the fork/join tree of the tasks spawned by the calling thread (nullptr outside of a tree)
+	static const void*& current_group();
+
+	// a parallel_for or parallel_reduce called outside of a tree starts a new one, identified
+	// by an address of its stack; a nested call spawns its tasks in the tree of its caller
+	class GroupScope
+	{
+		const void* previous_;
+
+	public:
+
+		GroupScope(const void* root) : previous_(current_group())
+		{
+			if (!previous_)
+				current_group() = root;
+		}
+		~GroupScope()
+		{
+			current_group() = previous_;
+		}
+	};
+
+	// pushes the task of a tree in the deque of the calling worker, the other ones in the injection queue
+	void push_task(Task* task);
+	// the calling worker executes the available tasks of its tree until done becomes true
+	void wait_until(const std::atomic<bool>& done);
+
+	inline static uint32 range_grain_size(uint32 begin, uint32 end, uint32 grain_size)
+	{
+		return grain_size > 0u ? grain_size : std::max(1u, (end - begin) / 256u);
+	}
+
+	template <typename FUNC>
+	void parallel_for_range(uint32 begin, uint32 end, uint32 grain, const FUNC& f)
+	{
+		if (end - begin <= grain)
+		{
+			f(begin, end);
+			return;
+		}
+		const uint32 middle = begin + (end - begin) / 2u;
+		auto right_half = [&] () { parallel_for_range(middle, end, grain, f); };
+		JoinTask<decltype(right_half)> right(right_half, current_group());
+		push_task(&right);
+		try
+		{
+			parallel_for_range(begin, middle, grain, f);
+		}
+		catch (...)
+		{
+			// the task on the stack may still be in a deque or running on another worker
+			wait_until(right.done());
+			throw;
+		}
+		wait_until(right.done());
+		right.rethrow_exception();
+	}
+
+	template <typename T, typename MAP, typename COMBINE>
+	T reduce_range(uint32 begin, uint32 end, uint32 grain, const MAP& map, const COMBINE& combine, bool parallel)
+	{
+		if (end - begin <= grain)
+			return map(begin, end);
+		const uint32 middle = begin + (end - begin) / 2u;
+		if (!parallel)
+			return combine(
+				reduce_range<T>(begin, middle, grain, map, combine, false),
+				reduce_range<T>(middle, end, grain, map, combine, false)
+			);
+		std::optional<T> right_result;
+		auto right_half = [&] () { right_result.emplace(reduce_range<T>(middle, end, grain, map, combine, true)); };
+		JoinTask<decltype(right_half)> right(right_half, current_group());
+		push_task(&right);
+		std::optional<T> left_result;
+		try
+		{
+			left_result.emplace(reduce_range<T>(begin, middle, grain, map, combine, true));
+		}
+		catch (...)
+		{
+			// the task on the stack may still be in a deque or running on another worker
+			wait_until(right.done());
+			throw;
+		}
+		wait_until(right.done());
+		right.rethrow_exception();
+		return combine(std::move(*left_result), std::move(*right_result));
+	}
+
 #pragma warning(push)
 #pragma warning(disable:4251)
 
 	// need to keep track of threads so we can join them
 	std::vector<std::thread> workers_;
-	// the task queue
-	std::queue<PackagedTask> tasks_;
+	// the tasks deques of the workers
+	std::vector<std::unique_ptr<Worker>> workers_data_;
 
-	// synchronization
-	std::mutex queue_mutex_;
+	// tasks enqueued by the threads that are not workers of the pool
+	std::deque<Task*> injected_tasks_;
+	std::mutex injection_mutex_;
+	std::atomic<uint32> nb_injected_tasks_;
+
+	// idle workers wait for new tasks
+	std::mutex sleep_mutex_;
 	std::condition_variable condition_task_;
-	bool stop_;
+	// number of working workers that wait for new tasks
+	std::atomic<uint32> nb_sleeping_workers_;
+	std::atomic<uint64> wake_up_epoch_;
+	std::atomic<bool> stop_;
 
 	// limit usage to the n-th first workers
-	uint32 nb_working_workers_;
-	std::mutex running_mutex_;
+	std::atomic<uint32> nb_working_workers_;
+	// the other workers wait for set_nb_workers
 	std::condition_variable condition_running_;
 
 #pragma warning(pop)
+
+	// any task if group is nullptr, otherwise a task of the given tree
+	Task* find_task(Worker* w, const void* group);
+	void wake_up_workers(bool all);
+	void worker_loop(uint32 index);
 };
 
 CGOGN_CORE_EXPORT ThreadPool* thread_pool();
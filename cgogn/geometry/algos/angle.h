@@ -73,8 +73,7 @@ angle(
 {
 	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
 
-	using Face = typename mesh_traits<MESH>::Face;
-	std::vector<Face> faces = incident_faces(m, e);
+	auto faces = incident_faces(m, e);
 	if (faces.size() < 2)
 		return 0;
 	return angle(
@@ -94,8 +93,7 @@ angle(
 {
 	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
 
-	using Face = typename mesh_traits<MESH>::Face;
-	std::vector<Face> faces = incident_faces(m, e);
+	auto faces = incident_faces(m, e);
 	if (faces.size() < 2)
 		return 0;
 	return angle(
@@ -120,6 +118,7 @@ compute_angle(
 		value<Scalar>(m, edge_angle, e) = angle(m, e, vertex_position);
         return true;
 	});
+	edge_angle->set_modified();
 }
 
 template <typename MESH>
@@ -139,6 +138,7 @@ compute_angle(
 		value<Scalar>(m, edge_angle, e) = angle(m, e, vertex_position, face_normal);
         return true;
 	});
+	edge_angle->set_modified();
 }
 
 } // namespace geometry
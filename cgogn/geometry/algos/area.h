@@ -49,9 +49,21 @@ convex_area(
 )
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
+	if constexpr (std::is_base_of<CMapBase, MESH>::value)
+	{
+		if (m.is_pure_simplicial() && !m.is_boundary(f.dart))
+		{
+			const Dart d1 = m.phi1(f.dart);
+			return area(
+				value<Vec3>(m, vertex_position, Vertex(f.dart)),
+				value<Vec3>(m, vertex_position, Vertex(d1)),
+				value<Vec3>(m, vertex_position, Vertex(m.phi1(d1)))
+			);
+		}
+	}
     if (codegree(m, f) == 3)
     {
-        std::vector<Vertex> vertices = incident_vertices(m, f);
+        auto vertices = incident_vertices(m, f);
 		return area(
             value<Vec3>(m, vertex_position, vertices[0]),
             value<Vec3>(m, vertex_position, vertices[1]),
@@ -62,7 +74,7 @@ convex_area(
 	{
 		Scalar face_area{0};
 		Vec3 center = centroid<Vec3>(m, f, vertex_position);
-        std::vector<Vertex> vertices = incident_vertices(m, f);
+        auto vertices = incident_vertices(m, f);
         for (uint32 i = 0, size = vertices.size(); i < size; ++i)
 		{
 			face_area += area(
@@ -95,17 +107,14 @@ area(
 {
 	using Face = typename mesh_traits<MESH>::Face;
 
-    Scalar area_sum = 0;
-	uint32 nbf = 0;
+	using AreaSum = std::pair<Scalar, uint32>;
 
-    foreach_cell(m, [&] (Face f) -> bool
-    {
-		area_sum += area(m, f, vertex_position);
-		++nbf;
-        return true;
-    });
+	AreaSum area_sum = parallel_reduce_cells<Face>(m, AreaSum{0, 0},
+		[&] (Face f) -> AreaSum { return { area(m, f, vertex_position), 1u }; },
+		[] (const AreaSum& a, const AreaSum& b) -> AreaSum { return { a.first + b.first, a.second + b.second }; }
+	);
 
-	return area_sum / Scalar(nbf);
+	return area_sum.first / Scalar(area_sum.second);
 }
 
 } // namespace geometry
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_ALGOS_BOUNDING_BOX_H_
+#define CGOGN_GEOMETRY_ALGOS_BOUNDING_BOX_H_
+
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/attributes.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+#include <cgogn/geometry/types/soa_attribute.h>
+
+#include <limits>
+#include <utility>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+namespace internal
+{
+
+template <typename MESH, typename POSITION>
+std::pair<Vec3, Vec3>
+bounding_box(const MESH& m, const POSITION* vertex_position)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	using BB = std::pair<Vec3, Vec3>;
+	return parallel_reduce_cells<Vertex>(m,
+		BB{Vec3::Constant(std::numeric_limits<Scalar>::max()), Vec3::Constant(std::numeric_limits<Scalar>::lowest())},
+		[&] (Vertex v) -> BB
+		{
+			const Vec3& p = value<Vec3>(m, vertex_position, v);
+			return { p, p };
+		},
+		[] (const BB& a, const BB& b) -> BB { return { a.first.cwiseMin(b.first), a.second.cwiseMax(b.second) }; }
+	);
+}
+
+} // namespace internal
+
+/**
+ * @brief component-wise min & max of the positions of the vertices of m
+ */
+template <typename MESH>
+std::pair<Vec3, Vec3>
+bounding_box(const MESH& m, const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position)
+{
+	return internal::bounding_box(m, vertex_position);
+}
+
+/**
+ * @brief component-wise min & max of the positions of the vertices of m
+ * (on a map: of all the indexed vertices, reduced on the component streams)
+ */
+template <typename MESH>
+std::pair<Vec3, Vec3>
+bounding_box(const MESH& m, const SoAAttribute<Vec3>* vertex_position)
+{
+	if constexpr (std::is_base_of<CMapBase, MESH>::value)
+		return bounding_box(*vertex_position);
+	else
+		return internal::bounding_box(m, vertex_position);
+}
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_ALGOS_BOUNDING_BOX_H_
@@ -70,17 +70,12 @@ centroid(
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Scalar = typename vector_traits<VEC>::Scalar;
-	VEC result;
-	result.setZero();
-	uint32 count = 0;
-	foreach_cell(m, [&] (Vertex v) -> bool
-	{
-		result += value<VEC>(m, attribute, v);
-		++count;
-		return true;
-	});
-	result /= Scalar(count);
-	return result;
+	using Sum = std::pair<VEC, uint32>;
+	Sum sum = parallel_reduce_cells<Vertex>(m, Sum{VEC::Zero(), 0u},
+		[&] (Vertex v) -> Sum { return { value<VEC>(m, attribute, v), 1u }; },
+		[] (const Sum& a, const Sum& b) -> Sum { return { a.first + b.first, a.second + b.second }; }
+	);
+	return sum.first / Scalar(sum.second);
 }
 
 template <typename VEC, typename CELL, typename MESH,
@@ -97,6 +92,44 @@ compute_centroid(
 		value<VEC>(m, cell_centroid, c) = centroid<VEC>(m, c, attribute);
 		return true;
 	});
+	cell_centroid->set_modified();
+}
+
+/**
+ * @brief updates the centroids of the cells created or modified since the checkpoint of the journal of m
+ * (a complete computation if the journal is incomplete)
+ */
+template <typename VEC, typename CELL, typename MESH,
+		  typename = typename std::enable_if<is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value>::type>
+void
+update_centroid(
+	const MESH& m,
+	const typename mesh_traits<MESH>::template Attribute<VEC>* attribute,
+	typename mesh_traits<MESH>::template Attribute<VEC>* cell_centroid
+)
+{
+	if constexpr (std::is_base_of<CMapBase, MESH>::value)
+	{
+		const CellsJournal* journal = m.journal();
+		if (journal && journal->complete)
+		{
+			std::vector<CELL> cells;
+			foreach_journaled_cell(m, [&] (CELL c) -> bool
+			{
+				cells.push_back(c);
+				return true;
+			});
+			const uint32 nb_cells = uint32(cells.size());
+			thread_pool()->parallel_for(0u, nb_cells, [&] (uint32 first, uint32 last)
+			{
+				for (uint32 i = first; i < last; ++i)
+					value<VEC>(m, cell_centroid, cells[i]) = centroid<VEC>(m, cells[i], attribute);
+			}, PARALLEL_BUFFER_SIZE);
+			cell_centroid->set_modified();
+			return;
+		}
+	}
+	compute_centroid<VEC, CELL>(m, attribute, cell_centroid);
 }
 
 template <typename VEC, typename MESH>
@@ -108,20 +141,14 @@ central_vertex(
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Scalar = typename vector_traits<VEC>::Scalar;
+	using Closest = std::pair<Scalar, Vertex>;
 	VEC center = centroid<VEC>(m, attribute);
-	Scalar min_dist = std::numeric_limits<Scalar>::max();
-	Vertex min_vertex;
-	foreach_cell(m, [&] (Vertex v) -> bool
-	{
-		Scalar distance = square_norm(value(m, attribute, v) - center);
-		if (distance < min_dist)
-		{
-			min_dist = distance;
-			min_vertex = v;
-		}
-		return true;
-	});
-	return min_vertex;
+	// on equal distances, the first vertex is kept
+	Closest closest = parallel_reduce_cells<Vertex>(m, Closest{std::numeric_limits<Scalar>::max(), Vertex()},
+		[&] (Vertex v) -> Closest { return { (value<VEC>(m, attribute, v) - center).squaredNorm(), v }; },
+		[] (const Closest& a, const Closest& b) -> Closest { return b.first < a.first ? b : a; }
+	);
+	return closest.second;
 }
 
 } // namespace geometry
@@ -53,7 +53,6 @@ curvature(
 	const typename mesh_traits<MESH>::template Attribute<Scalar>* edge_angle
 )
 {
-	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Edge = typename mesh_traits<MESH>::Edge;
 
 	CellCache<MESH> neighborhood = within_sphere(m, v, radius, vertex_position);
@@ -63,7 +62,7 @@ curvature(
 
 	foreach_cell(neighborhood, [&] (Edge e) -> bool
 	{
-		std::vector<Vertex> vv = incident_vertices(m, e);
+		auto vv = incident_vertices(m, e);
 		Vec3 ev = value<Vec3>(m, vertex_position, vv[0]) - value<Vec3>(m, vertex_position, vv[1]);
 		tensor += (ev * ev.transpose()) * value<Scalar>(m, edge_angle, e) * (Scalar(1) / ev.norm());
 		return true;
@@ -146,6 +145,11 @@ compute_curvature(
 		value<Vec3>(m, vertex_Knormal, v) = Knormal;
 		return true;
 	});
+	vertex_kmax->set_modified();
+	vertex_kmin->set_modified();
+	vertex_Kmax->set_modified();
+	vertex_Kmin->set_modified();
+	vertex_Knormal->set_modified();
 }
 
 } // namespace geometry
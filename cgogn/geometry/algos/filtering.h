@@ -30,6 +30,7 @@
 #include <cgogn/core/functions/attributes.h>
 
 #include <cgogn/geometry/types/vector_traits.h>
+#include <cgogn/geometry/types/soa_attribute.h>
 
 #include <Eigen/IterativeLinearSolvers>
 
@@ -39,14 +40,32 @@ namespace cgogn
 namespace geometry
 {
 
-template <typename T, typename MESH>
-void filter_average(
-	const MESH& m,
-	const typename mesh_traits<MESH>::template Attribute<T>* attribute_in,
-	typename mesh_traits<MESH>::template Attribute<T>* attribute_out
-)
+namespace internal
+{
+
+template <typename T, typename MESH, typename ATTRIBUTE>
+void filter_average(const MESH& m, const ATTRIBUTE* attribute_in, ATTRIBUTE* attribute_out)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
+	if constexpr (std::is_same<MESH, CMap2>::value)
+	{
+		if (const VertexAdjacency* adjacency = m.vertex_adjacency())
+		{
+			// the neighbours values are directly read through their indices
+			parallel_foreach_cell(m, [&] (Vertex v) -> bool
+			{
+				const uint32 index = index_of(m, v);
+				T sum;
+				sum.setZero();
+				for (uint32 i = adjacency->offsets[index], end = adjacency->offsets[index + 1u]; i < end; ++i)
+					sum += (*attribute_in)[adjacency->neighbors[i]];
+				(*attribute_out)[index] = sum / adjacency->degree(index);
+				return true;
+			});
+			attribute_out->set_modified();
+			return;
+		}
+	}
 	parallel_foreach_cell(m, [&] (Vertex v) -> bool
 	{
 		T sum;
@@ -61,6 +80,25 @@ void filter_average(
 		value<T>(m, attribute_out, v) = sum / count;
 		return true;
 	});
+	attribute_out->set_modified();
+}
+
+} // namespace internal
+
+template <typename T, typename MESH>
+void filter_average(
+	const MESH& m,
+	const typename mesh_traits<MESH>::template Attribute<T>* attribute_in,
+	typename mesh_traits<MESH>::template Attribute<T>* attribute_out
+)
+{
+	internal::filter_average<T>(m, attribute_in, attribute_out);
+}
+
+template <typename VEC, typename MESH>
+void filter_average(const MESH& m, const SoAAttribute<VEC>* attribute_in, SoAAttribute<VEC>* attribute_out)
+{
+	internal::filter_average<VEC>(m, attribute_in, attribute_out);
 }
 
 //template <typename MAP, typename MASK, typename VERTEX_ATTR>
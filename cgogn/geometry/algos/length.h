@@ -45,8 +45,7 @@ length(
 	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position
 )
 {
-	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices = incident_vertices(m, e);
+	auto vertices = incident_vertices(m, e);
 	return (value<Vec3>(m, vertex_position, vertices[0]) - value<Vec3>(m, vertex_position, vertices[1])).norm();
 }
 
@@ -58,32 +57,14 @@ mean_edge_length(
 )
 {
 	using Edge = typename mesh_traits<MESH>::Edge;
+	using LengthSum = std::pair<Scalar, uint32>;
 
-	thread_pool()->execute_all([] ()
-	{
-		float64_value() = 0.0;
-		uint32_value() = 0;
-	});
+	LengthSum length_sum = parallel_reduce_cells<Edge>(m, LengthSum{0, 0},
+		[&] (Edge e) -> LengthSum { return { length(m, e, vertex_position), 1u }; },
+		[] (const LengthSum& a, const LengthSum& b) -> LengthSum { return { a.first + b.first, a.second + b.second }; }
+	);
 
-	parallel_foreach_cell(m, [&] (Edge e) -> bool
-	{
-		float64_value() += length(m, e, vertex_position);
-		++uint32_value();
-		return true;
-	});
-
-	Scalar length_sum = 0.0;
-	uint32 nbe = 0;
-
-	std::mutex mutex;
-	thread_pool()->execute_all([&] ()
-	{
-		std::lock_guard<std::mutex> lock(mutex);
-		length_sum += float64_value();
-		nbe += uint32_value();
-	});
-
-	return length_sum / Scalar(nbe);
+	return length_sum.first / Scalar(length_sum.second);
 }
 
 } // namespace geometry
@@ -31,6 +31,7 @@
 #include <cgogn/core/functions/attributes.h>
 
 #include <cgogn/geometry/types/vector_traits.h>
+#include <cgogn/geometry/types/soa_attribute.h>
 #include <cgogn/geometry/functions/normal.h>
 
 namespace cgogn
@@ -39,19 +40,32 @@ namespace cgogn
 namespace geometry
 {
 
-template <typename MESH>
+namespace internal
+{
+
+template <typename MESH, typename POSITION>
 Vec3
-normal(
-	const MESH& m,
-	typename mesh_traits<MESH>::Face f,
-	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position
-)
+normal(const MESH& m, typename mesh_traits<MESH>::Face f, const POSITION* vertex_position)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	std::vector<Vertex> vertices = incident_vertices(m, f);
+	if constexpr (std::is_base_of<CMapBase, MESH>::value)
+	{
+		if (m.is_pure_simplicial() && !m.is_boundary(f.dart))
+		{
+			const Dart d1 = m.phi1(f.dart);
+			Vec3 n = geometry::normal(
+				value<Vec3>(m, vertex_position, Vertex(f.dart)),
+				value<Vec3>(m, vertex_position, Vertex(d1)),
+				value<Vec3>(m, vertex_position, Vertex(m.phi1(d1)))
+			);
+			n.normalize();
+			return n;
+		}
+	}
+	auto vertices = incident_vertices(m, f);
 	if (vertices.size() == 3)
 	{
-		Vec3 n = normal(
+		Vec3 n = geometry::normal(
 			value<Vec3>(m, vertex_position, vertices[0]),
 			value<Vec3>(m, vertex_position, vertices[1]),
 			value<Vec3>(m, vertex_position, vertices[2])
@@ -75,13 +89,9 @@ normal(
 	}
 }
 
-template <typename MESH>
+template <typename MESH, typename POSITION>
 Vec3
-normal(
-	const MESH& m,
-	typename mesh_traits<MESH>::Vertex v,
-	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position
-)
+normal(const MESH& m, typename mesh_traits<MESH>::Vertex v, const POSITION* vertex_position)
 {
 	using Face = typename mesh_traits<MESH>::Face;
 	Vec3 n{0.0, 0.0, 0.0};
@@ -94,6 +104,57 @@ normal(
 	return n;
 }
 
+template <typename MESH, typename POSITION>
+void
+compute_normal(const MESH& m, const POSITION* vertex_position, POSITION* vertex_normal)
+{
+	using Vertex = typename mesh_traits<MESH>::Vertex;
+	parallel_foreach_cell(m, [&] (Vertex v) -> bool
+	{
+		value<Vec3>(m, vertex_normal, v) = normal(m, v, vertex_position);
+		return true;
+	});
+	vertex_normal->set_modified();
+}
+
+} // namespace internal
+
+template <typename MESH>
+Vec3
+normal(
+	const MESH& m,
+	typename mesh_traits<MESH>::Face f,
+	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position
+)
+{
+	return internal::normal(m, f, vertex_position);
+}
+
+template <typename MESH>
+Vec3
+normal(const MESH& m, typename mesh_traits<MESH>::Face f, const SoAAttribute<Vec3>* vertex_position)
+{
+	return internal::normal(m, f, vertex_position);
+}
+
+template <typename MESH>
+Vec3
+normal(
+	const MESH& m,
+	typename mesh_traits<MESH>::Vertex v,
+	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position
+)
+{
+	return internal::normal(m, v, vertex_position);
+}
+
+template <typename MESH>
+Vec3
+normal(const MESH& m, typename mesh_traits<MESH>::Vertex v, const SoAAttribute<Vec3>* vertex_position)
+{
+	return internal::normal(m, v, vertex_position);
+}
+
 template <typename MESH>
 void
 compute_normal(
@@ -101,13 +162,76 @@ compute_normal(
 	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position,
 	typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_normal
 )
+{
+	internal::compute_normal(m, vertex_position, vertex_normal);
+}
+
+template <typename MESH>
+void
+compute_normal(const MESH& m, const SoAAttribute<Vec3>* vertex_position, SoAAttribute<Vec3>* vertex_normal)
+{
+	internal::compute_normal(m, vertex_position, vertex_normal);
+}
+
+/**
+ * @brief updates the normals of the vertices whose neighbourhood changed since the checkpoint of the journal of m:
+ * the vertices of the recorded faces and of the faces incident to the recorded vertices
+ * (a complete computation if the journal is incomplete)
+ */
+template <typename MESH>
+void
+update_normal(
+	const MESH& m,
+	const typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_position,
+	typename mesh_traits<MESH>::template Attribute<Vec3>* vertex_normal
+)
 {
 	using Vertex = typename mesh_traits<MESH>::Vertex;
-	parallel_foreach_cell(m, [&] (Vertex v) -> bool
+	using Face = typename mesh_traits<MESH>::Face;
+
+	if constexpr (std::is_base_of<CMapBase, MESH>::value)
 	{
-		value<Vec3>(m, vertex_normal, v) = normal(m, v, vertex_position);
-		return true;
-	});
+		const CellsJournal* journal = m.journal();
+		if (journal && journal->complete)
+		{
+			std::vector<Vertex> vertices;
+			CellMarkerStore<MESH, Vertex> marker(m);
+			auto add_vertex = [&] (Vertex v) -> bool
+			{
+				if (!marker.is_marked(v))
+				{
+					marker.mark(v);
+					vertices.push_back(v);
+				}
+				return true;
+			};
+			foreach_journaled_cell(m, [&] (Face f) -> bool
+			{
+				foreach_incident_vertex(m, f, add_vertex);
+				return true;
+			});
+			foreach_journaled_cell(m, [&] (Vertex v) -> bool
+			{
+				add_vertex(v);
+				foreach_incident_face(m, v, [&] (Face f) -> bool
+				{
+					foreach_incident_vertex(m, f, add_vertex);
+					return true;
+				});
+				return true;
+			});
+
+			const uint32 nb_vertices = uint32(vertices.size());
+			thread_pool()->parallel_for(0u, nb_vertices, [&] (uint32 first, uint32 last)
+			{
+				for (uint32 i = first; i < last; ++i)
+					value<Vec3>(m, vertex_normal, vertices[i]) = normal(m, vertices[i], vertex_position);
+			}, PARALLEL_BUFFER_SIZE);
+			vertex_normal->set_modified();
+			return;
+		}
+	}
+	compute_normal(m, vertex_position, vertex_normal);
 }
 
 } // namespace geometry
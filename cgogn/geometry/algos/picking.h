@@ -50,7 +50,6 @@ picking(
 	const Vec3& B
 )
 {
-	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Face = typename mesh_traits<MESH>::Face;
 	using SelectedFace = std::tuple<Face, Vec3, Scalar>;
 
@@ -58,14 +57,13 @@ picking(
 	cgogn_message_assert(AB.squaredNorm() > 0.0, "line must be defined by 2 different points");
 	AB.normalize();
 
-	std::vector<std::vector<SelectedFace>> selected_per_thread(thread_pool()->nb_workers());
-	// std::vector<std::vector<uint32>> ear_indices_per_thread(thread_pool()->nb_workers());
+	using SelectedFaces = std::vector<SelectedFace>;
 
-	parallel_foreach_cell(m, [&] (Face f) -> bool
+	SelectedFaces result = parallel_reduce_cells<Face>(m, SelectedFaces(), [&] (Face f) -> SelectedFaces
 	{
-		uint32 worker_index = current_worker_index();
+		SelectedFaces selected;
 		Vec3 intersection_point;
-		std::vector<Vertex> vertices = incident_vertices(m, f);
+		auto vertices = incident_vertices(m, f);
 		if (codegree(m, f) == 3)
 		{
 			if (intersection_ray_triangle(
@@ -75,12 +73,11 @@ picking(
 				value<Vec3>(m, vertex_position, vertices[2]),
 				&intersection_point
 			))
-				selected_per_thread[worker_index].emplace_back(f, intersection_point, (intersection_point - A).squaredNorm());
+				selected.emplace_back(f, intersection_point, (intersection_point - A).squaredNorm());
 		}
 		// else
 		// {
-		// 	std::vector<uint32>& ear_indices = ear_indices_per_thread[worker_index];
-		// 	ear_indices.clear();
+		// 	std::vector<uint32> ear_indices;
 		// 	append_ear_triangulation(m, f, position, ear_indices);
 		// 	for (std::size_t i = 0; i < ear_indices.size(); i += 3)
 		// 	{
@@ -89,20 +86,19 @@ picking(
 		// 		const VEC3& p3 = position[ear_indices[i+2]];
 		// 		if (intersection_ray_triangle(A, AB, p1, p2, p3, &intersection_point))
 		// 		{
-		// 			selected_per_thread[worker_index].push_back({ f, intersection_point, (intersection_point - A).squaredNorm() });
+		// 			selected.push_back({ f, intersection_point, (intersection_point - A).squaredNorm() });
 		// 			i = ear_indices.size();
 		// 		}
 		// 	}
 		// }
-		return true;
+		return selected;
+	},
+	[] (SelectedFaces a, SelectedFaces b) -> SelectedFaces
+	{
+		a.insert(a.end(), b.begin(), b.end());
+		return a;
 	});
 
-	std::vector<SelectedFace> result;
-
-	for (const auto& selected_faces_vector : selected_per_thread)
-		for (const auto& x : selected_faces_vector)
-			result.push_back(x);
-
 	std::sort(result.begin(), result.end(), [] (const SelectedFace& f1, const SelectedFace& f2) -> bool
 	{
 		return std::get<2>(f1) < std::get<2>(f2);
@@ -167,7 +163,6 @@ void picking(
 	std::vector<typename mesh_traits<MESH>::Edge>& result
 )
 {
-	using Vertex = typename mesh_traits<MESH>::Vertex;
 	using Edge = typename mesh_traits<MESH>::Edge;
 	using Face = typename mesh_traits<MESH>::Face;
 	using SelectedFace = std::tuple<Face, Vec3, Scalar>;
@@ -187,7 +182,7 @@ void picking(
 
 		foreach_incident_edge(m, f, [&] (Edge e) -> bool
 		{
-			std::vector<Vertex> vertices = incident_vertices(m, e);
+			auto vertices = incident_vertices(m, e);
 			Scalar d2 = squared_distance_line_point(
 				value<Vec3>(m, vertex_position, vertices[0]),
 				value<Vec3>(m, vertex_position, vertices[1]),
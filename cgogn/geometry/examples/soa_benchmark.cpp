@@ -0,0 +1,138 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/adjacency.h>
+
+#include <cgogn/io/surface/surface_import.h>
+
+#include <cgogn/geometry/types/soa_attribute.h>
+#include <cgogn/geometry/algos/bounding_box.h>
+#include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/geometry/algos/normal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+using namespace cgogn;
+
+using Vec3 = geometry::Vec3;
+using Vertex = CMap2::Vertex;
+
+// builds a triangulated grid of n x n vertices with random coordinates
+void build_grid(CMap2& m, uint32 n)
+{
+	std::mt19937 gen(0u);
+	std::uniform_real_distribution<float64> dist(-1.0, 1.0);
+	io::SurfaceImportData surface_data;
+	surface_data.reserve(n * n, 2u * (n - 1u) * (n - 1u));
+	auto position = add_attribute<Vec3, Vertex>(m, "position");
+	const uint32 first_vertex_id = new_indices<Vertex>(m, n * n);
+	for (uint32 i = 0u; i < n * n; ++i)
+	{
+		surface_data.vertices_id_.push_back(first_vertex_id + i);
+		(*position)[first_vertex_id + i] = Vec3(float64(i % n) + dist(gen) * 0.1, float64(i / n) + dist(gen) * 0.1, dist(gen));
+	}
+	for (uint32 j = 0u; j + 1u < n; ++j)
+	{
+		for (uint32 i = 0u; i + 1u < n; ++i)
+		{
+			const uint32 v = first_vertex_id + j * n + i;
+			for (uint32 x : { v, v + 1u, v + n + 1u, v, v + n + 1u, v + n })
+				surface_data.faces_vertex_indices_.push_back(x);
+			surface_data.faces_nb_vertices_.push_back(3u);
+			surface_data.faces_nb_vertices_.push_back(3u);
+		}
+	}
+	io::import_surface_data(m, surface_data);
+}
+
+// best time of a few runs (in ms)
+template <typename FUNC>
+float64 measure(const FUNC& f)
+{
+	float64 best = std::numeric_limits<float64>::max();
+	for (uint32 i = 0u; i < 5u; ++i)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		f();
+		auto end = std::chrono::high_resolution_clock::now();
+		best = std::min(best, std::chrono::duration<float64>(end - start).count() * 1e3);
+	}
+	return best;
+}
+
+void print(const std::string& name, float64 aos, float64 soa)
+{
+	std::cout << std::setw(24) << name
+			  << " | AoS " << std::setw(8) << std::setprecision(4) << aos << " ms"
+			  << " | SoA " << std::setw(8) << std::setprecision(4) << soa << " ms"
+			  << " | x" << std::setprecision(3) << aos / soa << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	const uint32 n = argc > 1 ? uint32(std::stoul(argv[1])) : 1000u;
+
+	thread_start();
+
+	CMap2 m;
+	build_grid(m, n);
+	std::cout << n * n << " vertices, " << thread_pool()->nb_workers() << " workers" << std::endl;
+
+	auto position = get_attribute<Vec3, Vertex>(m, "position");
+	auto result = add_attribute<Vec3, Vertex>(m, "result");
+	auto soa_position = geometry::add_soa_attribute<Vec3, Vertex>(m, "soa_position");
+	auto soa_result = geometry::add_soa_attribute<Vec3, Vertex>(m, "soa_result");
+	geometry::copy(*soa_position, *position);
+
+	print("filter_average",
+		measure([&] () { geometry::filter_average<Vec3>(m, position.get(), result.get()); }),
+		measure([&] () { geometry::filter_average(m, soa_position.get(), soa_result.get()); })
+	);
+	print("compute_normal",
+		measure([&] () { geometry::compute_normal(m, position.get(), result.get()); }),
+		measure([&] () { geometry::compute_normal(m, soa_position.get(), soa_result.get()); })
+	);
+	std::pair<Vec3, Vec3> bb, soa_bb;
+	print("bounding_box",
+		measure([&] () { bb = geometry::bounding_box(m, position.get()); }),
+		measure([&] () { soa_bb = geometry::bounding_box(m, soa_position.get()); })
+	);
+	if (bb != soa_bb)
+		std::cout << "the bounding boxes differ" << std::endl;
+
+	// the neighbours are then read through the adjacency CSR
+	build_adjacency_csr(m);
+	print("filter_average (CSR)",
+		measure([&] () { geometry::filter_average<Vec3>(m, position.get(), result.get()); }),
+		measure([&] () { geometry::filter_average(m, soa_position.get(), soa_result.get()); })
+	);
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_ops/edge.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/global.h>
+
+#include <cgogn/geometry/algos/centroid.h>
+#include <cgogn/geometry/algos/normal.h>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+using Face = CMap2::Face;
+using Volume = CMap2::Volume;
+
+class IncrementalUpdateTest : public CMap2Fixture
+{
+protected:
+
+	std::shared_ptr<CMap2::Attribute<Vec3>> position_;
+	std::shared_ptr<CMap2::Attribute<Vec3>> normal_;
+	std::shared_ptr<CMap2::Attribute<Vec3>> centroid_;
+
+	void SetUp() override
+	{
+		add_cells_attributes<Edge, Volume>();
+		position_ = add_attribute<Vec3, Vertex>(map_, "position");
+		normal_ = add_attribute<Vec3, Vertex>(map_, "normal");
+		centroid_ = add_attribute<Vec3, Face>(map_, "centroid");
+		add_prisms(20u, [] (uint32 i) { return 3u + i % 4u; });
+		// distinct positions, the faces are not planar
+		uint32 n = 0u;
+		foreach_cell(map_, [&] (Vertex v) -> bool
+		{
+			++n;
+			value<Vec3>(map_, position_, v) = Vec3(Scalar(n % 7u), Scalar(n % 11u), Scalar(n % 13u));
+			return true;
+		});
+		compute_normal(map_, position_.get(), normal_.get());
+		compute_centroid<Vec3, Face>(map_, position_.get(), centroid_.get());
+	}
+
+	// the incrementally updated values match a complete computation
+	void check_updates()
+	{
+		update_normal(map_, position_.get(), normal_.get());
+		update_centroid<Vec3, Face>(map_, position_.get(), centroid_.get());
+
+		auto normal = add_attribute<Vec3, Vertex>(map_, "expected_normal");
+		auto centroid = add_attribute<Vec3, Face>(map_, "expected_centroid");
+		compute_normal(map_, position_.get(), normal.get());
+		compute_centroid<Vec3, Face>(map_, position_.get(), centroid.get());
+
+		uint32 nb_errors = 0u;
+		foreach_cell(map_, [&] (Vertex v) -> bool
+		{
+			if (!value<Vec3>(map_, normal_, v).isApprox(value<Vec3>(map_, normal, v), Scalar(1e-4)))
+				++nb_errors;
+			return true;
+		});
+		foreach_cell(map_, [&] (Face f) -> bool
+		{
+			if (!value<Vec3>(map_, centroid_, f).isApprox(value<Vec3>(map_, centroid, f), Scalar(1e-4)))
+				++nb_errors;
+			return true;
+		});
+		EXPECT_EQ(nb_errors, 0u);
+
+		remove_attribute<Vertex>(map_, normal);
+		remove_attribute<Face>(map_, centroid);
+	}
+};
+
+TEST_F(IncrementalUpdateTest, local_edits)
+{
+	map_.enable_journal();
+
+	// the new vertex of a cut edge is placed at its middle
+	Dart d = inner_dart();
+	const Vec3 middle = (value<Vec3>(map_, position_, Vertex(d)) +
+		value<Vec3>(map_, position_, Vertex(map_.phi2(d)))) / Scalar(2);
+	Vertex v = cut_edge(map_, Edge(d));
+	value<Vec3>(map_, position_, v) = middle;
+	ASSERT_TRUE(map_.journal()->complete);
+	check_updates();
+
+	map_.checkpoint_journal();
+	d = inner_dart(40u);
+	cut_face(map_, Vertex(d), Vertex(map_.phi1(map_.phi1(d))));
+	ASSERT_TRUE(map_.journal()->complete);
+	check_updates();
+
+	// the merged vertex is moved: its change of geometry is recorded explicitly
+	map_.checkpoint_journal();
+	v = collapse_edge(map_, Edge(inner_dart(80u)));
+	value<Vec3>(map_, position_, v) += Vec3(Scalar(0.5), Scalar(0), Scalar(1));
+	journal_cell(map_, v);
+	ASSERT_TRUE(map_.journal()->complete);
+	check_updates();
+
+	// several edits between two checkpoints
+	map_.checkpoint_journal();
+	for (uint32 i = 0u; i < 3u; ++i)
+	{
+		d = inner_dart(120u + 30u * i);
+		cut_face(map_, Vertex(d), Vertex(map_.phi1(map_.phi1(d))));
+		Vertex w(inner_dart(10u + 50u * i));
+		value<Vec3>(map_, position_, w) *= Scalar(2);
+		journal_cell(map_, w);
+	}
+	ASSERT_TRUE(map_.journal()->complete);
+	check_updates();
+}
+
+TEST_F(IncrementalUpdateTest, incomplete_journal)
+{
+	// the updates fall back to a complete computation when the journal is incomplete
+	map_.enable_journal();
+	value<Vec3>(map_, position_, Vertex(inner_dart())) = Vec3(Scalar(1), Scalar(2), Scalar(3));
+	journal_cell(map_, Vertex(inner_dart()));
+	map_.compact_cells<Vertex>();
+	ASSERT_FALSE(map_.journal()->complete);
+	value<Vec3>(map_, position_, Vertex(inner_dart(60u))) = Vec3(Scalar(3), Scalar(2), Scalar(1));
+	check_updates();
+
+	// or when there is no journal
+	map_.disable_journal();
+	value<Vec3>(map_, position_, Vertex(inner_dart(90u))) = Vec3(Scalar(2), Scalar(3), Scalar(1));
+	check_updates();
+}
+
+} // namespace geometry
+
+} // namespace cgogn
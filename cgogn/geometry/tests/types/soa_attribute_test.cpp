@@ -0,0 +1,199 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/tests/cmap2_fixture.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_ops/edge.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/global.h>
+
+#include <cgogn/geometry/algos/bounding_box.h>
+#include <cgogn/geometry/algos/filtering.h>
+#include <cgogn/geometry/algos/normal.h>
+#include <cgogn/geometry/types/soa_attribute.h>
+
+#include <limits>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+using Vertex = CMap2::Vertex;
+using Edge = CMap2::Edge;
+using Volume = CMap2::Volume;
+
+class SoAAttributeTest : public CMap2Fixture
+{
+protected:
+
+	std::shared_ptr<CMap2::Attribute<Vec3>> position_;
+	std::shared_ptr<SoAAttribute<Vec3>> soa_position_;
+
+	void SetUp() override
+	{
+		add_cells_attributes<Edge, Volume>();
+		// more vertices than the chunk size of SoAAttribute
+		add_prisms(300u, 4u);
+		position_ = add_attribute<Vec3, Vertex>(map_, "position");
+		uint32 n = 0u;
+		foreach_cell(map_, [&] (Vertex v) -> bool
+		{
+			++n;
+			value<Vec3>(map_, position_, v) = Vec3(Scalar(n % 17u), Scalar(n % 23u) - Scalar(10), Scalar(n % 29u) / Scalar(4));
+			return true;
+		});
+		soa_position_ = add_soa_attribute<Vec3, Vertex>(map_, "soa_position");
+		copy(*soa_position_, *position_);
+	}
+
+	// releases vertex indices in the middle (collapsed edges) and at the end (released indices)
+	// of the container, the released values being out of the bounding box
+	void make_holes()
+	{
+		for (uint32 i = 0u; i < 5u; ++i)
+		{
+			Dart d = map_.begin();
+			for (uint32 j = 0u; j < 400u * i + 7u; ++j)
+				d = map_.next(d);
+			collapse_edge(map_, Edge(d));
+		}
+		const uint32 first = new_indices<Vertex>(map_, 1500u);
+		for (uint32 i = first; i < first + 1500u; ++i)
+		{
+			(*position_)[i] = Vec3(Scalar(1000), Scalar(-1000), Scalar(1000));
+			(*soa_position_)[i] = (*position_)[i];
+			map_.attribute_containers_[Vertex::ORBIT].release_index(i);
+		}
+	}
+
+	// the SoAAttribute has the values of the array of structures attribute on all the vertices
+	template <typename ATTRIBUTE>
+	void expect_same_values(const ATTRIBUTE& aos, const SoAAttribute<Vec3>& soa, Scalar epsilon = Scalar(0))
+	{
+		uint32 nb_errors = 0u;
+		foreach_cell(map_, [&] (Vertex v) -> bool
+		{
+			const Vec3 a = value<Vec3>(map_, aos, v);
+			const Vec3 b = value<Vec3>(map_, &soa, v);
+			if (epsilon == Scalar(0) ? a != b : !a.isApprox(b, epsilon))
+				++nb_errors;
+			return true;
+		});
+		EXPECT_EQ(nb_errors, 0u);
+	}
+
+	void check_kernels()
+	{
+		expect_same_values(position_, *soa_position_);
+
+		// element proxies
+		Vertex v(map_.begin());
+		value<Vec3>(map_, soa_position_, v) = Vec3(Scalar(1), Scalar(2), Scalar(3));
+		value<Vec3>(map_, soa_position_, v)[1] += Scalar(1);
+		EXPECT_EQ(Vec3(value<Vec3>(map_, soa_position_, v)), Vec3(Scalar(1), Scalar(3), Scalar(3)));
+		value<Vec3>(map_, position_, v) = value<Vec3>(map_, soa_position_, v);
+
+		// bounding box
+		auto [aos_min, aos_max] = geometry::bounding_box(map_, position_.get());
+		auto [soa_min, soa_max] = geometry::bounding_box(map_, soa_position_.get());
+		EXPECT_EQ(soa_min, aos_min);
+		EXPECT_EQ(soa_max, aos_max);
+		EXPECT_TRUE(bounding_box(*soa_position_) == std::make_pair(aos_min, aos_max));
+
+		// axpy, scale & normalize
+		auto soa = add_soa_attribute<Vec3, Vertex>(map_, "soa");
+		auto aos = add_attribute<Vec3, Vertex>(map_, "aos");
+		copy(*soa, *position_);
+		copy(*aos, *soa);
+		expect_same_values(aos, *soa);
+		axpy(*soa, Scalar(2), *soa_position_);
+		scale(*soa, Scalar(-0.5));
+		normalize(*soa);
+		foreach_cell(map_, [&] (Vertex x) -> bool
+		{
+			Vec3& a = value<Vec3>(map_, aos, x);
+			a = (a + Scalar(2) * value<Vec3>(map_, position_, x)) * Scalar(-0.5);
+			if (a.squaredNorm() > Scalar(0))
+				a.normalize();
+			return true;
+		});
+		expect_same_values(aos, *soa, Scalar(1e-5));
+
+		// algorithms on both layouts
+		auto aos_normal = add_attribute<Vec3, Vertex>(map_, "aos_normal");
+		auto soa_normal = add_soa_attribute<Vec3, Vertex>(map_, "soa_normal");
+		compute_normal(map_, position_.get(), aos_normal.get());
+		compute_normal(map_, soa_position_.get(), soa_normal.get());
+		expect_same_values(aos_normal, *soa_normal, Scalar(1e-5));
+		filter_average<Vec3>(map_, position_.get(), aos.get());
+		filter_average<Vec3>(map_, soa_position_.get(), soa.get());
+		expect_same_values(aos, *soa, Scalar(1e-5));
+
+		remove_attribute<Vertex>(map_, aos);
+		remove_attribute<Vertex>(map_, aos_normal);
+		map_.attribute_containers_[Vertex::ORBIT].remove_attribute(soa);
+		map_.attribute_containers_[Vertex::ORBIT].remove_attribute(soa_normal);
+	}
+};
+
+TEST_F(SoAAttributeTest, get_attribute)
+{
+	EXPECT_EQ((get_soa_attribute<Vec3, Vertex>(map_, "soa_position")), soa_position_);
+	EXPECT_FALSE((get_soa_attribute<Vec3, Vertex>(map_, "position")));
+	EXPECT_FALSE((get_soa_attribute<Vec3, Vertex>(map_, "missing")));
+	EXPECT_GE(soa_position_->nb_chunks() * uint32(SoAAttribute<Vec3>::CHUNK_SIZE),
+			  map_.attribute_containers_[Vertex::ORBIT].maximum_index());
+	EXPECT_GT(soa_position_->nb_chunks(), 1u);
+}
+
+TEST_F(SoAAttributeTest, kernels)
+{
+	check_kernels();
+}
+
+TEST_F(SoAAttributeTest, holes)
+{
+	make_holes();
+	check_kernels();
+}
+
+TEST_F(SoAAttributeTest, compaction)
+{
+	make_holes();
+	const uint32 nb_chunks = soa_position_->nb_chunks();
+	map_.compact_cells<Vertex>();
+	// the values are moved with the indices and the storage beyond the used indices is freed
+	EXPECT_LT(soa_position_->nb_chunks(), nb_chunks);
+	check_kernels();
+}
+
+} // namespace geometry
+
+} // namespace cgogn
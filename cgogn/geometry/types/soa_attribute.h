@@ -0,0 +1,394 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_GEOMETRY_TYPES_SOA_ATTRIBUTE_H_
+#define CGOGN_GEOMETRY_TYPES_SOA_ATTRIBUTE_H_
+
+#include <cgogn/core/types/container/attribute_container.h>
+#include <cgogn/core/types/container/chunk_array.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/functions/cells.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <limits>
+
+namespace cgogn
+{
+
+namespace geometry
+{
+
+////////////////////////
+// SoAAttribute class //
+////////////////////////
+
+/**
+ * SoAAttribute stores fixed size vectors as a structure of arrays:
+ * each chunk holds SIZE contiguous streams of CHUNK_SIZE scalars (one per component).
+ * Elements are accessed through Eigen::Map proxies (strided views on the streams)
+ * while the per-component streams can be processed by vectorized kernels.
+ */
+template <typename VEC>
+class SoAAttribute : public AttributeGenT
+{
+public:
+
+	using Scalar = typename vector_traits<VEC>::Scalar;
+	static const uint32 SIZE = uint32(vector_traits<VEC>::SIZE);
+	static const uint32 CHUNK_SIZE = 1024u;
+
+	using reference = Eigen::Map<VEC, Eigen::Unaligned, Eigen::InnerStride<CHUNK_SIZE>>;
+	using const_reference = Eigen::Map<const VEC, Eigen::Unaligned, Eigen::InnerStride<CHUNK_SIZE>>;
+
+	using Stream = Eigen::Map<Eigen::Array<Scalar, CHUNK_SIZE, 1>, Eigen::Aligned16>;
+	using ConstStream = Eigen::Map<const Eigen::Array<Scalar, CHUNK_SIZE, 1>, Eigen::Aligned16>;
+
+private:
+
+	std::vector<Scalar*> chunks_;
+	uint32 capacity_;
+
+	inline void manage_index(uint32 index) override
+	{
+		while (index >= capacity_)
+		{
+			Scalar* chunk = static_cast<Scalar*>(allocate_chunk_memory(SIZE * CHUNK_SIZE * sizeof(Scalar)));
+			std::fill(chunk, chunk + SIZE * CHUNK_SIZE, Scalar(0));
+			chunks_.push_back(chunk);
+			capacity_ = chunks_.size() * CHUNK_SIZE;
+		}
+	}
+
+	inline void move_index(uint32 from, uint32 to) override
+	{
+		(*this)[to] = (*this)[from];
+	}
+
+	inline void shrink(uint32 size) override
+	{
+		const uint32 nb_chunks = (size + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+		while (chunks_.size() > nb_chunks)
+		{
+			free_chunk_memory(chunks_.back());
+			chunks_.pop_back();
+		}
+		capacity_ = chunks_.size() * CHUNK_SIZE;
+	}
+
+public:
+
+	SoAAttribute(AttributeContainerGen* container, const std::string& name) : AttributeGenT(container, name)
+	{
+		chunks_.reserve(512u);
+		capacity_ = 0u;
+	}
+
+	~SoAAttribute() override
+	{
+		for (auto chunk : chunks_)
+			free_chunk_memory(chunk);
+	}
+
+	inline reference operator[](uint32 index)
+	{
+		cgogn_message_assert(index < capacity_, "index out of bounds");
+		return reference(chunks_[index / CHUNK_SIZE] + index % CHUNK_SIZE);
+	}
+
+	inline const_reference operator[](uint32 index) const
+	{
+		cgogn_message_assert(index < capacity_, "index out of bounds");
+		return const_reference(chunks_[index / CHUNK_SIZE] + index % CHUNK_SIZE);
+	}
+
+	inline uint32 nb_chunks() const
+	{
+		return uint32(chunks_.size());
+	}
+
+	// stream of the given component in the given chunk
+	inline Stream stream(uint32 chunk, uint32 component)
+	{
+		return Stream(chunks_[chunk] + component * CHUNK_SIZE);
+	}
+
+	inline ConstStream stream(uint32 chunk, uint32 component) const
+	{
+		return ConstStream(chunks_[chunk] + component * CHUNK_SIZE);
+	}
+
+	inline void fill(const VEC& value)
+	{
+		for (auto chunk : chunks_)
+			for (uint32 k = 0u; k < SIZE; ++k)
+				std::fill(chunk + k * CHUNK_SIZE, chunk + (k + 1u) * CHUNK_SIZE, value[k]);
+	}
+
+	inline std::size_t memory_footprint() const override
+	{
+		return sizeof(*this) + chunks_.capacity() * sizeof(Scalar*) + std::size_t(capacity_) * SIZE * sizeof(Scalar);
+	}
+
+	inline const AttributeContainerGen* container() const
+	{
+		return container_;
+	}
+};
+
+/*****************************************************************************/
+
+// template <typename VEC, typename CELL, typename MESH>
+// std::shared_ptr<SoAAttribute<VEC>> add_soa_attribute(MESH& m, const std::string& name);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type* = nullptr>
+std::shared_ptr<SoAAttribute<VEC>>
+add_soa_attribute(MESH& m, const std::string& name)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	if (!m.template is_indexed<CELL>())
+		index_cells<CELL>(m);
+	return m.attribute_containers_[CELL::ORBIT].template add_attribute_of_type<SoAAttribute<VEC>>(name);
+}
+
+//////////////
+// MESHVIEW //
+//////////////
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
+std::shared_ptr<SoAAttribute<VEC>>
+add_soa_attribute(MESH& m, const std::string& name)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return add_soa_attribute<VEC, CELL>(m.mesh(), name);
+}
+
+/*****************************************************************************/
+
+// template <typename VEC, typename CELL, typename MESH>
+// std::shared_ptr<SoAAttribute<VEC>> get_soa_attribute(const MESH& m, const std::string& name);
+
+/*****************************************************************************/
+
+//////////////
+// CMapBase //
+//////////////
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<std::is_base_of<CMapBase, MESH>::value>::type* = nullptr>
+std::shared_ptr<SoAAttribute<VEC>>
+get_soa_attribute(const MESH& m, const std::string& name)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return m.attribute_containers_[CELL::ORBIT].template get_attribute_of_type<SoAAttribute<VEC>>(name);
+}
+
+//////////////
+// MESHVIEW //
+//////////////
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<is_mesh_view<MESH>::value>::type* = nullptr>
+std::shared_ptr<SoAAttribute<VEC>>
+get_soa_attribute(const MESH& m, const std::string& name)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return get_soa_attribute<VEC, CELL>(m.mesh(), name);
+}
+
+} // namespace geometry
+
+/*****************************************************************************/
+
+// template <typename VEC, typename CELL, typename MESH>
+// typename geometry::SoAAttribute<VEC>::reference value(const MESH& m, const std::shared_ptr<geometry::SoAAttribute<VEC>>& attribute, CELL c);
+
+/*****************************************************************************/
+
+// the overloads are restricted to the Eigen types and their return type is deduced:
+// the value<T> calls on the Attribute<T> of the other types must not instantiate SoAAttribute<T>
+
+/////////////
+// GENERIC //
+/////////////
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<geometry::is_eigen<VEC>::value>::type* = nullptr>
+inline
+auto
+value(const MESH& m, const std::shared_ptr<geometry::SoAAttribute<VEC>>& attribute, CELL c)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return (*attribute)[index_of(m, c)];
+}
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<geometry::is_eigen<VEC>::value>::type* = nullptr>
+inline
+auto
+value(const MESH& m, geometry::SoAAttribute<VEC>* attribute, CELL c)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return (*attribute)[index_of(m, c)];
+}
+
+template <typename VEC, typename CELL, typename MESH,
+		  typename std::enable_if<geometry::is_eigen<VEC>::value>::type* = nullptr>
+inline
+auto
+value(const MESH& m, const geometry::SoAAttribute<VEC>* attribute, CELL c)
+{
+	static_assert(is_in_tuple<CELL, typename mesh_traits<MESH>::Cells>::value, "CELL not supported in this MESH");
+	return (*attribute)[index_of(m, c)];
+}
+
+namespace geometry
+{
+
+/////////////
+// KERNELS //
+/////////////
+
+// The kernels below work on whole chunks: the unused indices of the container are processed
+// with the used ones (they do not affect the results), except for the reductions.
+
+// copies an array of structures attribute (e.g. Attribute<Vec3>) into a SoAAttribute of the same container
+template <typename VEC, typename ATTRIBUTE>
+void copy(SoAAttribute<VEC>& dst, const ATTRIBUTE& src)
+{
+	dst.container()->foreach_live_index([&] (uint32 i) -> bool
+	{
+		dst[i] = src[i];
+		return true;
+	});
+}
+
+// copies a SoAAttribute into an array of structures attribute of the same container
+template <typename VEC, typename ATTRIBUTE>
+void copy(ATTRIBUTE& dst, const SoAAttribute<VEC>& src)
+{
+	src.container()->foreach_live_index([&] (uint32 i) -> bool
+	{
+		dst[i] = src[i];
+		return true;
+	});
+}
+
+// y += a * x
+template <typename VEC>
+void axpy(SoAAttribute<VEC>& y, typename SoAAttribute<VEC>::Scalar a, const SoAAttribute<VEC>& x)
+{
+	cgogn_message_assert(y.container() == x.container(), "Attributes should belong to the same container");
+	for (uint32 c = 0u, nb = std::min(x.nb_chunks(), y.nb_chunks()); c < nb; ++c)
+		for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+			y.stream(c, k) += a * x.stream(c, k);
+}
+
+// x *= a
+template <typename VEC>
+void scale(SoAAttribute<VEC>& x, typename SoAAttribute<VEC>::Scalar a)
+{
+	for (uint32 c = 0u, nb = x.nb_chunks(); c < nb; ++c)
+		for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+			x.stream(c, k) *= a;
+}
+
+// normalizes every non-zero vector
+template <typename VEC>
+void normalize(SoAAttribute<VEC>& x)
+{
+	using Scalar = typename SoAAttribute<VEC>::Scalar;
+	using Array = Eigen::Array<Scalar, SoAAttribute<VEC>::CHUNK_SIZE, 1>;
+	for (uint32 c = 0u, nb = x.nb_chunks(); c < nb; ++c)
+	{
+		Array sq_norm = Array::Zero();
+		for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+			sq_norm += x.stream(c, k).square();
+		const Array inv_norm = (sq_norm > Scalar(0)).select(sq_norm.rsqrt(), Scalar(1));
+		for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+			x.stream(c, k) *= inv_norm;
+	}
+}
+
+// component-wise min & max over the used indices
+template <typename VEC>
+std::pair<VEC, VEC> bounding_box(const SoAAttribute<VEC>& x)
+{
+	using Scalar = typename SoAAttribute<VEC>::Scalar;
+	static const uint32 CHUNK_SIZE = SoAAttribute<VEC>::CHUNK_SIZE;
+
+	VEC bb_min, bb_max;
+	for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+	{
+		bb_min[k] = std::numeric_limits<Scalar>::max();
+		bb_max[k] = std::numeric_limits<Scalar>::lowest();
+	}
+
+	const AttributeContainerGen* container = x.container();
+	for (uint32 c = 0u, nb = x.nb_chunks(); c < nb; ++c)
+	{
+		if (container->all_used(c * CHUNK_SIZE, (c + 1u) * CHUNK_SIZE))
+		{
+			// full chunk: vectorized reduction on the streams
+			for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+			{
+				auto s = x.stream(c, k);
+				bb_min[k] = std::min(bb_min[k], s.minCoeff());
+				bb_max[k] = std::max(bb_max[k], s.maxCoeff());
+			}
+		}
+		else
+		{
+			for (uint32 i = c * CHUNK_SIZE, end = std::min((c + 1u) * CHUNK_SIZE, container->maximum_index()); i < end; ++i)
+			{
+				if (!container->is_used(i))
+					continue;
+				auto v = x[i];
+				for (uint32 k = 0u; k < SoAAttribute<VEC>::SIZE; ++k)
+				{
+					bb_min[k] = std::min(bb_min[k], v[k]);
+					bb_max[k] = std::max(bb_max[k], v[k]);
+				}
+			}
+		}
+	}
+
+	return { bb_min, bb_max };
+}
+
+} // namespace geometry
+
+} // namespace cgogn
+
+#endif // CGOGN_GEOMETRY_TYPES_SOA_ATTRIBUTE_H_
@@ -46,15 +46,15 @@ using Vec4d = Eigen::Vector4d;
 
 using Mat2i = Eigen::Matrix2i;
 using Mat3i = Eigen::Matrix3i;
-using Mat4i = Eigen::Matrix3i;
+using Mat4i = Eigen::Matrix4i;
 
 using Mat2f = Eigen::Matrix2f;
 using Mat3f = Eigen::Matrix3f;
-using Mat4f = Eigen::Matrix3f;
+using Mat4f = Eigen::Matrix4f;
 
 using Mat2d = Eigen::Matrix2d;
 using Mat3d = Eigen::Matrix3d;
-using Mat4d = Eigen::Matrix3d;
+using Mat4d = Eigen::Matrix4d;
 
 
 template <typename VEC, typename Enable = void>
@@ -93,15 +93,28 @@ struct vector_traits<Eigen::MatrixBase<V>, typename std::enable_if<is_eigen<Eige
 };
 
 
+// geometry stack precision: single precision halves the attributes memory
+// and allows the positions to be uploaded to the VBOs without conversion
+#ifdef CGOGN_USE_FLOAT32_GEOMETRY
+using Vec2 = Eigen::Vector2f;
+using Vec3 = Eigen::Vector3f;
+using Vec4 = Eigen::Vector4f;
+
+using Mat2 = Eigen::Matrix2f;
+using Mat3 = Eigen::Matrix3f;
+using Mat4 = Eigen::Matrix4f;
+#else
 using Vec2 = Eigen::Vector2d;
 using Vec3 = Eigen::Vector3d;
 using Vec4 = Eigen::Vector4d;
 
 using Mat2 = Eigen::Matrix2d;
 using Mat3 = Eigen::Matrix3d;
-using Mat4 = Eigen::Matrix3d;
+using Mat4 = Eigen::Matrix4d;
+#endif
 
 using Scalar = vector_traits<Vec3>::Scalar;
+using MatX = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
 
 } // namespace geometry
 
@@ -0,0 +1,212 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/types/cmap/cmap3.h>
+
+#include <cgogn/io/surface/off.h>
+#include <cgogn/io/volume/meshb.h>
+#include <cgogn/io/volume/tet.h>
+#include <cgogn/io/utils.h>
+
+#include <cgogn/core/utils/endian.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace cgogn;
+
+// generates a triangulated grid of n x n vertices with random coordinates
+void write_OFF(const std::string& filename, uint32 n)
+{
+	std::mt19937 gen(0u);
+	std::uniform_real_distribution<float64> dist(-1.0, 1.0);
+	std::ofstream fp(filename);
+	fp << std::setprecision(17);
+	fp << "OFF\n" << n * n << " " << 2u * (n - 1u) * (n - 1u) << " 0\n";
+	for (uint32 i = 0u; i < n * n; ++i)
+		fp << float64(i % n) + dist(gen) * 0.1 << " " << float64(i / n) + dist(gen) * 0.1 << " " << dist(gen) << "\n";
+	for (uint32 j = 0u; j + 1u < n; ++j)
+	{
+		for (uint32 i = 0u; i + 1u < n; ++i)
+		{
+			const uint32 v = j * n + i;
+			fp << "3 " << v << " " << v + 1u << " " << v + n + 1u << "\n";
+			fp << "3 " << v << " " << v + n + 1u << " " << v + n << "\n";
+		}
+	}
+}
+
+// generates the same grid in the binary OFF format of off_ascii2bin
+void write_OFF_binary(const std::string& filename, uint32 n)
+{
+	std::mt19937 gen(0u);
+	std::uniform_real_distribution<float64> dist(-1.0, 1.0);
+	std::ofstream fp(filename, std::ios::out | std::ios::binary);
+	auto write = [&] (auto x)
+	{
+		x = swap_endianness_native_big(x);
+		fp.write(reinterpret_cast<const char*>(&x), sizeof(x));
+	};
+	fp << "OFF BINARY\n";
+	write(n * n);
+	write(2u * (n - 1u) * (n - 1u));
+	write(0u);
+	for (uint32 i = 0u; i < n * n; ++i)
+	{
+		write(float32(float64(i % n) + dist(gen) * 0.1));
+		write(float32(float64(i / n) + dist(gen) * 0.1));
+		write(float32(dist(gen)));
+	}
+	for (uint32 j = 0u; j + 1u < n; ++j)
+	{
+		for (uint32 i = 0u; i + 1u < n; ++i)
+		{
+			const uint32 v = j * n + i;
+			for (uint32 x : { 3u, v, v + 1u, v + n + 1u, 3u, v, v + n + 1u, v + n })
+				write(x);
+		}
+	}
+}
+
+// generates a grid of n x n x n vertices cut in 6 tetrahedra per cube
+void write_TET(const std::string& filename, uint32 n)
+{
+	std::mt19937 gen(0u);
+	std::uniform_real_distribution<float64> dist(-1.0, 1.0);
+	std::ofstream fp(filename);
+	fp << std::setprecision(17);
+	const uint32 c = n - 1u;
+	fp << n * n * n << " vertices\n" << 6u * c * c * c << " tets\n";
+	for (uint32 i = 0u; i < n * n * n; ++i)
+		fp << float64(i % n) + dist(gen) * 0.1 << " " << float64((i / n) % n) << " " << float64(i / (n * n)) << "\n";
+	auto id = [&] (uint32 i, uint32 j, uint32 k) { return (k * n + j) * n + i; };
+	for (uint32 k = 0u; k < c; ++k)
+	{
+		for (uint32 j = 0u; j < c; ++j)
+		{
+			for (uint32 i = 0u; i < c; ++i)
+			{
+				const uint32 v[8] = {
+					id(i, j, k), id(i + 1u, j, k), id(i + 1u, j + 1u, k), id(i, j + 1u, k),
+					id(i, j, k + 1u), id(i + 1u, j, k + 1u), id(i + 1u, j + 1u, k + 1u), id(i, j + 1u, k + 1u)
+				};
+				const uint32 tets[6][4] = {
+					{ 0, 1, 2, 6 }, { 0, 2, 3, 6 }, { 0, 3, 7, 6 }, { 0, 7, 4, 6 }, { 0, 4, 5, 6 }, { 0, 5, 1, 6 }
+				};
+				for (const auto& t : tets)
+					fp << "4 " << v[t[0]] << " " << v[t[1]] << " " << v[t[2]] << " " << v[t[3]] << "\n";
+			}
+		}
+	}
+}
+
+template <typename FUNC>
+float64 measure(const FUNC& f)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	f();
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<float64>(end - start).count();
+}
+
+// parses all the tokens of the file as numbers, with the TextTokenizer and with the former istream based reader
+void benchmark_parsing(const std::string& filename, uint32 nb_header_lines)
+{
+	float64 sum = 0.0;
+	std::size_t size = 0u;
+	const float64 tokenizer_time = measure([&] ()
+	{
+		io::MappedFile file(filename);
+		size = file.size();
+		io::TextTokenizer tok(file.begin(), file.end());
+		for (uint32 i = 0u; i < nb_header_lines; ++i)
+			tok.next_line();
+		while (!tok.at_end() && tok.good())
+			sum += tok.read_double();
+	});
+
+	const float64 istream_time = measure([&] ()
+	{
+		io::Scoped_C_Locale loc;
+		std::ifstream fp(filename);
+		std::string line;
+		for (uint32 i = 0u; i < nb_header_lines; ++i)
+			io::getline_safe(fp, line);
+		while (fp >> std::ws && !fp.eof())
+			sum += io::read_double(fp, line);
+	});
+
+	const float64 mb = float64(size) / (1024.0 * 1024.0);
+	std::cout << std::setw(24) << filename << " | " << std::setw(8) << std::setprecision(4) << mb << " MB"
+			  << " | tokenizer: " << std::setw(8) << mb / tokenizer_time << " MB/s"
+			  << " | istream: " << std::setw(8) << mb / istream_time << " MB/s"
+			  << " (" << sum << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	const uint32 n = argc > 1 ? uint32(std::stoul(argv[1])) : 1000u;
+
+	const std::string off_filename("io_benchmark.off");
+	const std::string off_binary_filename("io_benchmark_binary.off");
+	const std::string tet_filename("io_benchmark.tet");
+	write_OFF(off_filename, n);
+	write_OFF_binary(off_binary_filename, n);
+	write_TET(tet_filename, uint32(std::cbrt(float64(n * n))));
+
+	benchmark_parsing(off_filename, 1u);
+	benchmark_parsing(tet_filename, 2u);
+
+	CMap2 m2;
+	const float64 off_time = measure([&] () { io::import_OFF(m2, off_filename); });
+	std::cout << "import_OFF: " << std::setprecision(4) << off_time << " s" << std::endl;
+
+	CMap2 m2b;
+	const float64 off_binary_time = measure([&] () { io::import_OFF(m2b, off_binary_filename); });
+	std::cout << "import_OFF (binary): " << std::setprecision(4) << off_binary_time << " s" << std::endl;
+
+	CMap3 m3;
+	const float64 tet_time = measure([&] () { io::import_TET(m3, tet_filename); });
+	std::cout << "import_TET: " << std::setprecision(4) << tet_time << " s" << std::endl;
+
+	// same mesh in a binary Gamma mesh file
+	const std::string meshb_filename("io_benchmark.meshb");
+	auto position = get_attribute<geometry::Vec3, CMap3::Vertex>(m3, "position");
+	io::export_MESHB(m3, position.get(), meshb_filename);
+	CMap3 m3b;
+	const float64 meshb_time = measure([&] () { io::import_MESHB(m3b, meshb_filename); });
+	std::cout << "import_MESHB: " << std::setprecision(4) << meshb_time << " s" << std::endl;
+
+	std::remove(off_filename.c_str());
+	std::remove(off_binary_filename.c_str());
+	std::remove(tet_filename.c_str());
+	std::remove(meshb_filename.c_str());
+
+	return 0;
+}
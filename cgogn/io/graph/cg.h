@@ -34,7 +34,7 @@
 #include <cgogn/geometry/types/vector_traits.h>
 
 #include <vector>
-#include <fstream>
+#include <sstream>
 
 namespace cgogn
 {
@@ -49,16 +49,17 @@ bool import_CG(MESH& m, const std::string& filename)
 
 	using Vertex = typename MESH::Vertex;
 
-	Scoped_C_Locale loc;
-
 	GraphImportData graph_data;
 
-	std::ifstream fp(filename.c_str(), std::ios::in);
-
-	std::string line;
-	line.reserve(512);
+	MappedFile file(filename);
+	if (!file.is_open())
+	{
+		std::cerr << "File \"" << filename << "\" could not be opened." << std::endl;
+		return false;
+	}
+	TextTokenizer tok(file.begin(), file.end());
 
-	getline_safe(fp, line);
+	std::string line(tok.next_line());
 	if (line.rfind("# D") == std::string::npos)
 	{
 		std::cerr << "File \"" << filename << "\" is not a valid cg file." << std::endl;
@@ -86,52 +87,67 @@ bool import_CG(MESH& m, const std::string& filename)
 		return false;
 	}
 
+	// the file is parsed in local buffers (with the vertex indices of the file in the edges):
+	// the map is only changed once the whole file is read
 	graph_data.reserve(nb_vertices);
-	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
+	std::vector<geometry::Vec3> positions;
+	positions.reserve(nb_vertices);
 
 	// read vertices
 	for (uint32 i = 0; i < nb_vertices; ++i)
 	{
-		getline_safe(fp, line);
-		std::stringstream iss(line);
-
-		std::string tag;
-		iss >> tag;
-
-		if (tag == std::string("v"))
+		TextTokenizer ltok(tok.next_line());
+		if (ltok.next_token() == "v")
 		{
-			float64 x, y, z;
-			iss >> x;
-			iss >> y;
-			iss >> z;
-
-			uint32 vertex_id = new_index<Vertex>(m);
-			(*position)[vertex_id] = { x, y, z };
-
-			graph_data.vertices_id_.push_back(vertex_id);
+			geometry::Scalar x = ltok.read_double();
+			geometry::Scalar y = ltok.read_double();
+			geometry::Scalar z = ltok.read_double();
+			if (!ltok.good())
+			{
+				tok.fail();
+				break;
+			}
+
+			positions.push_back({ x, y, z });
 		}
 	}
 
 	// read edges
-	for (uint32 i = 0; i < nb_edges; ++i)
+	for (uint32 i = 0; i < nb_edges && tok.good(); ++i)
 	{
-		getline_safe(fp, line);
-		std::stringstream iss(line);
-
-		std::string tag;
-		iss >> tag;
-
-		if (tag == std::string("e"))
+		TextTokenizer ltok(tok.next_line());
+		if (ltok.next_token() == "e")
 		{
-			uint32 a, b;
-			iss >> a;
-			iss >> b;
-
-			graph_data.edges_vertex_indices_.push_back(graph_data.vertices_id_[a]);
-			graph_data.edges_vertex_indices_.push_back(graph_data.vertices_id_[b]);
+			uint32 a = ltok.read_uint();
+			uint32 b = ltok.read_uint();
+			if (!ltok.good() || a >= positions.size() || b >= positions.size())
+			{
+				tok.fail();
+				break;
+			}
+
+			graph_data.edges_vertex_indices_.push_back(a);
+			graph_data.edges_vertex_indices_.push_back(b);
 		}
 	}
 
+	if (!tok.good())
+	{
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
+	}
+
+	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
+	const uint32 nb_read_vertices = uint32(positions.size());
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_read_vertices);
+	for (uint32 i = 0; i < nb_read_vertices; ++i)
+	{
+		(*position)[first_vertex_id + i] = positions[i];
+		graph_data.vertices_id_.push_back(first_vertex_id + i);
+	}
+	for (uint32& index : graph_data.edges_vertex_indices_)
+		index += first_vertex_id;
+
 	import_graph_data(m, graph_data);
 
 	return true;
@@ -34,7 +34,6 @@
 #include <cgogn/geometry/types/vector_traits.h>
 
 #include <vector>
-#include <fstream>
 #include <set>
 
 namespace cgogn
@@ -50,21 +49,18 @@ bool import_SKEL(MESH& m, const std::string& filename)
 
 	using Vertex = typename MESH::Vertex;
 
-	Scoped_C_Locale loc;
-
 	GraphImportData graph_data;
-	
-	std::ifstream fp(filename.c_str(), std::ios::in);
 
-	std::string line;
-	line.reserve(512);
-	getline_safe(fp, line); // Discard first line, it's useless
-	getline_safe(fp, line); // Number of vertices
+	MappedFile file(filename);
+	if (!file.is_open())
+	{
+		std::cerr << "File \"" << filename << "\" could not be opened." << std::endl;
+		return false;
+	}
+	TextTokenizer tok(file.begin(), file.end());
 
-	std::stringstream issl(line);
-	uint32 value;
-	issl >> value;
-	const uint32 nb_vertices = value;
+	tok.next_line(); // Discard first line, it's useless
+	const uint32 nb_vertices = TextTokenizer(tok.next_line()).read_uint(); // Number of vertices
 
 	if (nb_vertices == 0u)
 	{
@@ -72,40 +68,64 @@ bool import_SKEL(MESH& m, const std::string& filename)
 		return false;
 	}
 
+	// the file is parsed in local buffers (with the vertex indices of the file in the edges):
+	// the map is only changed once the whole file is read
 	graph_data.reserve(nb_vertices);
-	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
-	auto radius = add_attribute<geometry::Scalar, Vertex>(m, "radius");
+	std::vector<geometry::Vec3> positions(nb_vertices);
+	std::vector<geometry::Scalar> radii(nb_vertices);
 
 	for (uint32 i = 0; i < nb_vertices; ++i)
 	{
-		uint32 id;
-		float64 x, y, z, r;
-		uint32 nb_neighbors;
-
-		getline_safe(fp, line); 
-		std::stringstream iss(line);
-		iss >> id;
-		iss >> x >> y >> z;
-		iss >> r;
+		TextTokenizer ltok(tok.next_line());
+		uint32 id = ltok.read_uint();
+		geometry::Scalar x = ltok.read_double();
+		geometry::Scalar y = ltok.read_double();
+		geometry::Scalar z = ltok.read_double();
+		geometry::Scalar r = ltok.read_double();
+		if (!ltok.good() || id > i)
+		{
+			tok.fail();
+			break;
+		}
 
-		uint32 vertex_id = new_index<Vertex>(m);
-		(*position)[vertex_id] = { x, y, z };
-		(*radius)[vertex_id] = r;
-		graph_data.vertices_id_.push_back(vertex_id);
+		positions[i] = { x, y, z };
+		radii[i] = r;
 
-		iss >> nb_neighbors;
+		uint32 nb_neighbors = ltok.read_uint();
 
-		for (uint32 j = 0; j < nb_neighbors; ++j)
+		for (uint32 j = 0; j < nb_neighbors && ltok.good(); ++j)
 		{
-			uint32 neighbor_id;
-			iss >> neighbor_id;
+			uint32 neighbor_id = ltok.read_uint();
 			if (neighbor_id < id)
 			{
-				graph_data.edges_vertex_indices_.push_back(graph_data.vertices_id_[id]);
-				graph_data.edges_vertex_indices_.push_back(graph_data.vertices_id_[neighbor_id]);
+				graph_data.edges_vertex_indices_.push_back(id);
+				graph_data.edges_vertex_indices_.push_back(neighbor_id);
 			}
 		}
+		if (!ltok.good())
+		{
+			tok.fail();
+			break;
+		}
+	}
+
+	if (!tok.good())
+	{
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
+	}
+
+	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
+	auto radius = add_attribute<geometry::Scalar, Vertex>(m, "radius");
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	for (uint32 i = 0; i < nb_vertices; ++i)
+	{
+		(*position)[first_vertex_id + i] = positions[i];
+		(*radius)[first_vertex_id + i] = radii[i];
+		graph_data.vertices_id_.push_back(first_vertex_id + i);
 	}
+	for (uint32& index : graph_data.edges_vertex_indices_)
+		index += first_vertex_id;
 
 	import_graph_data(m, graph_data);
 
@@ -0,0 +1,265 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cgogn/io/meshb_data.h>
+
+#include <libmeshb.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+static const std::array<int, MESHB_NB_ELEMENT_TYPES> meshb_keywords = {
+	GmfTriangles, GmfQuadrilaterals, GmfTetrahedra, GmfPyramids, GmfPrisms, GmfHexahedra
+};
+
+static bool read_vertices(int64_t mesh, MeshbData& data)
+{
+	const int64_t nb = GmfStatKwd(mesh, GmfVertices);
+	if (nb == 0)
+		return true;
+	if (nb < 0 || nb > std::numeric_limits<int32>::max())
+		return false;
+
+	data.vertices_position_.assign(3u * nb, 0.0);
+	data.vertices_ref_.resize(nb);
+	float64* p = data.vertices_position_.data();
+	int32* r = data.vertices_ref_.data();
+	const int64_t last = nb - 1;
+
+	// the begin and end pointers give the stride of each component in the arrays
+	if (data.dimension_ == 3u)
+		return GmfGetBlock(mesh, GmfVertices, 1, nb, 0, nullptr, nullptr,
+						   GmfDouble, p, p + 3 * last,
+						   GmfDouble, p + 1, p + 3 * last + 1,
+						   GmfDouble, p + 2, p + 3 * last + 2,
+						   GmfInt, r, r + last) != 0;
+	return GmfGetBlock(mesh, GmfVertices, 1, nb, 0, nullptr, nullptr,
+					   GmfDouble, p, p + 3 * last,
+					   GmfDouble, p + 1, p + 3 * last + 1,
+					   GmfInt, r, r + last) != 0;
+}
+
+static bool read_elements(int64_t mesh, MeshbElementType type, uint32 nb_vertices, MeshbElements& elements)
+{
+	const int64_t nb = GmfStatKwd(mesh, meshb_keywords[type]);
+	if (nb == 0)
+		return true;
+	if (nb < 0 || nb > std::numeric_limits<int32>::max())
+		return false;
+
+	const int size = int(meshb_element_size(type));
+	elements.vertex_indices_.resize(size * nb);
+	elements.refs_.resize(nb);
+	int32* v = reinterpret_cast<int32*>(elements.vertex_indices_.data());
+	int32* r = elements.refs_.data();
+	const int64_t last = nb - 1;
+
+	if (GmfGetBlock(mesh, meshb_keywords[type], 1, nb, 0, nullptr, nullptr,
+					GmfIntTab, size, v, v + size * last,
+					GmfInt, r, r + last) == 0)
+		return false;
+
+	// indices from 1 in the file (0 and negative ones wrap around and fail the check)
+	bool valid = true;
+	for (uint32& i : elements.vertex_indices_)
+	{
+		i -= 1u;
+		valid &= i < nb_vertices;
+	}
+	return valid;
+}
+
+// libMeshb checks the position of each next keyword against the file size, but not the data of a last keyword
+// (with no next keyword) and exits the program on the short read of its block: the keywords of a binary file
+// are scanned here and the data of the vertices and of the elements must be in the file
+static bool check_binary_keywords(const std::string& filename, int version, int dimension)
+{
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+	if (!file.good())
+		return false;
+	const int64_t file_size = int64_t(file.tellg());
+	file.seekg(0);
+
+	bool swap = false;
+	auto read_word = [&] (uint32 nb_bytes) -> int64_t
+	{
+		std::array<unsigned char, 8> bytes{};
+		file.read(reinterpret_cast<char*>(bytes.data()), nb_bytes);
+		if (swap)
+			std::reverse(bytes.begin(), bytes.begin() + nb_bytes);
+		if (nb_bytes == 4u)
+		{
+			int32 w;
+			std::memcpy(&w, bytes.data(), 4u);
+			return w;
+		}
+		int64_t w;
+		std::memcpy(&w, bytes.data(), 8u);
+		return w;
+	};
+
+	// the code 1 is written in the endianness of the file
+	const int64_t code = read_word(4u);
+	if (code != 1)
+		swap = true;
+	read_word(4u); // version
+
+	const uint32 position_size = version >= 3 ? 8u : 4u;
+	const uint32 int_size = version >= 4 ? 8u : 4u;
+	const uint32 real_size = version >= 2 ? 8u : 4u;
+
+	int64_t position = file.tellg();
+	while (file.good())
+	{
+		const int64_t keyword = read_word(4u);
+		const int64_t next = read_word(position_size);
+		if (!file.good())
+			return false;
+
+		int64_t line_size = 0;
+		if (keyword == GmfVertices)
+			line_size = dimension * real_size + int_size;
+		for (uint32 t = 0u; t < MESHB_NB_ELEMENT_TYPES; ++t)
+		{
+			if (keyword == meshb_keywords[t])
+				line_size = (meshb_element_size(MeshbElementType(t)) + 1u) * int_size;
+		}
+		if (line_size > 0)
+		{
+			const int64_t nb = read_word(int_size);
+			if (!file.good() || nb < 0 || nb > (file_size - int64_t(file.tellg())) / line_size)
+				return false;
+		}
+
+		if (next == 0 || keyword == GmfEnd)
+			return true;
+		// the keywords follow each other in the file
+		if (next <= position || next > file_size)
+			return false;
+		position = next;
+		file.seekg(position);
+	}
+	return false;
+}
+
+bool read_MESHB(const std::string& filename, MeshbData& data)
+{
+	int version = 0;
+	int dimension = 0;
+	const int64_t mesh = GmfOpenMesh(filename.c_str(), GmfRead, &version, &dimension);
+	if (mesh == 0)
+		return false;
+
+	bool read = dimension == 2 || dimension == 3;
+	// (binary files have a .meshb extension, as for libMeshb)
+	if (read && filename.find(".meshb") != std::string::npos)
+		read = check_binary_keywords(filename, version, dimension);
+	if (read)
+	{
+		data.dimension_ = uint32(dimension);
+		read = read_vertices(mesh, data);
+	}
+	for (uint32 t = 0u; t < MESHB_NB_ELEMENT_TYPES && read; ++t)
+		read = read_elements(mesh, MeshbElementType(t), data.nb_vertices(), data.elements_[t]);
+
+	GmfCloseMesh(mesh);
+	return read;
+}
+
+static bool write_vertices(int64_t mesh, const MeshbData& data)
+{
+	const int64_t nb = data.nb_vertices();
+	if (nb == 0)
+		return true;
+
+	float64* p = const_cast<float64*>(data.vertices_position_.data());
+	int32* r = const_cast<int32*>(data.vertices_ref_.data());
+	const int64_t last = nb - 1;
+
+	if (GmfSetKwd(mesh, GmfVertices, nb) == 0)
+		return false;
+	if (data.dimension_ == 3u)
+		return GmfSetBlock(mesh, GmfVertices, 1, nb, 0, nullptr, nullptr,
+						   GmfDouble, p, p + 3 * last,
+						   GmfDouble, p + 1, p + 3 * last + 1,
+						   GmfDouble, p + 2, p + 3 * last + 2,
+						   GmfInt, r, r + last) != 0;
+	return GmfSetBlock(mesh, GmfVertices, 1, nb, 0, nullptr, nullptr,
+					   GmfDouble, p, p + 3 * last,
+					   GmfDouble, p + 1, p + 3 * last + 1,
+					   GmfInt, r, r + last) != 0;
+}
+
+static bool write_elements(int64_t mesh, MeshbElementType type, const MeshbElements& elements)
+{
+	const int64_t nb = elements.size();
+	if (nb == 0)
+		return true;
+
+	const int size = int(meshb_element_size(type));
+	// indices from 1 in the file
+	std::vector<int32> indices(elements.vertex_indices_.begin(), elements.vertex_indices_.end());
+	for (int32& i : indices)
+		++i;
+	int32* v = indices.data();
+	int32* r = const_cast<int32*>(elements.refs_.data());
+	const int64_t last = nb - 1;
+
+	if (GmfSetKwd(mesh, meshb_keywords[type], nb) == 0)
+		return false;
+	return GmfSetBlock(mesh, meshb_keywords[type], 1, nb, 0, nullptr, nullptr,
+					   GmfIntTab, size, v, v + size * last,
+					   GmfInt, r, r + last) != 0;
+}
+
+bool write_MESHB(const std::string& filename, const MeshbData& data)
+{
+	// version 2 (64 bits reals, 32 bits integers) or 3 (same with 64 bits file positions) for files over 2 GiB
+	uint64 file_size = uint64(data.nb_vertices()) * (8u * data.dimension_ + 4u);
+	for (uint32 t = 0u; t < MESHB_NB_ELEMENT_TYPES; ++t)
+		file_size += uint64(data.elements_[t].size()) * 4u * (meshb_element_size(MeshbElementType(t)) + 1u);
+	const int version = file_size < (uint64(1) << 31) ? 2 : 3;
+
+	const int64_t mesh = GmfOpenMesh(filename.c_str(), GmfWrite, version, int(data.dimension_));
+	if (mesh == 0)
+		return false;
+
+	bool written = write_vertices(mesh, data);
+	for (uint32 t = 0u; t < MESHB_NB_ELEMENT_TYPES && written; ++t)
+		written = write_elements(mesh, MeshbElementType(t), data.elements_[t]);
+
+	return GmfCloseMesh(mesh) != 0 && written;
+}
+
+} // namespace io
+
+} // namespace cgogn
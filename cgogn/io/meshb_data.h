@@ -0,0 +1,94 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_IO_MESHB_DATA_H_
+#define CGOGN_IO_MESHB_DATA_H_
+
+#include <cgogn/io/cgogn_io_export.h>
+
+#include <cgogn/core/utils/numerics.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+enum MeshbElementType : uint32
+{
+	MESHB_TRIANGLE = 0,
+	MESHB_QUAD,
+	MESHB_TETRA,
+	MESHB_PYRAMID,
+	MESHB_PRISM,
+	MESHB_HEXA,
+	MESHB_NB_ELEMENT_TYPES
+};
+
+inline uint32 meshb_element_size(MeshbElementType type)
+{
+	static const std::array<uint32, MESHB_NB_ELEMENT_TYPES> sizes = { 3u, 4u, 4u, 5u, 6u, 8u };
+	return sizes[type];
+}
+
+struct MeshbElements
+{
+	std::vector<uint32> vertex_indices_; // meshb_element_size() indices (from 0) per element
+	std::vector<int32> refs_;
+
+	inline uint32 size() const { return uint32(refs_.size()); }
+};
+
+struct MeshbData
+{
+	uint32 dimension_ = 3u;
+	std::vector<float64> vertices_position_; // 3 coordinates per vertex (z = 0 in dimension 2)
+	std::vector<int32> vertices_ref_;
+	std::array<MeshbElements, MESHB_NB_ELEMENT_TYPES> elements_;
+
+	inline uint32 nb_vertices() const { return uint32(vertices_ref_.size()); }
+};
+
+/**
+ * @brief reads the vertices and the linear elements of a Gamma mesh file (.mesh ASCII or .meshb binary)
+ * with the block reads of the vendored libMeshb library
+ * @return false if the file could not be opened or read or if an element has an invalid vertex index
+ */
+bool CGOGN_IO_EXPORT read_MESHB(const std::string& filename, MeshbData& data);
+
+/**
+ * @brief writes the vertices and the elements in a Gamma mesh file, in ASCII or binary after its extension
+ * (.mesh or .meshb) with the block writes of the vendored libMeshb library
+ */
+bool CGOGN_IO_EXPORT write_MESHB(const std::string& filename, const MeshbData& data);
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_MESHB_DATA_H_
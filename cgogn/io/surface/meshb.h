@@ -0,0 +1,188 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_IO_SURFACE_MESHB_H_
+#define CGOGN_IO_SURFACE_MESHB_H_
+
+#include <cgogn/io/meshb_data.h>
+#include <cgogn/io/surface/surface_import.h>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+/**
+ * @brief imports the triangles and the quadrilaterals of a Gamma mesh file (.mesh ASCII or .meshb binary),
+ * with the references of the vertices and of the faces in int32 "ref" attributes
+ */
+template <typename MESH,
+		  typename std::enable_if<mesh_traits<MESH>::dimension == 2>::type* = nullptr>
+bool import_MESHB(MESH& m, const std::string& filename)
+{
+	using Vertex = typename MESH::Vertex;
+	using Face = typename MESH::Face;
+	using Vec3 = geometry::Vec3;
+	using Scalar = geometry::Scalar;
+
+	MeshbData meshb;
+	if (!read_MESHB(filename, meshb))
+	{
+		std::cerr << "File \"" << filename << "\" could not be read." << std::endl;
+		return false;
+	}
+	const uint32 nb_vertices = meshb.nb_vertices();
+	if (nb_vertices == 0u)
+	{
+		std::cerr << "File \"" << filename << "\" has no vertices." << std::endl;
+		return false;
+	}
+
+	const MeshbElements& triangles = meshb.elements_[MESHB_TRIANGLE];
+	const MeshbElements& quads = meshb.elements_[MESHB_QUAD];
+	const uint32 nb_faces = triangles.size() + quads.size();
+
+	SurfaceImportData surface_data;
+	surface_data.reserve(nb_vertices, nb_faces);
+
+	auto position = add_attribute<Vec3, Vertex>(m, "position");
+	auto vertex_ref = add_attribute<int32, Vertex>(m, "ref");
+	auto face_ref = add_attribute<int32, Face>(m, "ref");
+
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+	{
+		const uint32 vertex_id = first_vertex_id + i;
+		surface_data.vertices_id_.push_back(vertex_id);
+		const float64* p = &meshb.vertices_position_[3u * i];
+		(*position)[vertex_id] = Vec3(Scalar(p[0]), Scalar(p[1]), Scalar(p[2]));
+		if (vertex_ref)
+			(*vertex_ref)[vertex_id] = meshb.vertices_ref_[i];
+	}
+
+	const uint32 first_face_id = face_ref ? new_indices<Face>(m, nb_faces) : 0u;
+	uint32 face_id = first_face_id;
+	for (const MeshbElements* faces : { &triangles, &quads })
+	{
+		const uint32 nbv = faces == &triangles ? 3u : 4u;
+		for (uint32 i = 0u, end = faces->size(); i < end; ++i)
+		{
+			surface_data.faces_nb_vertices_.push_back(nbv);
+			for (uint32 j = 0u; j < nbv; ++j)
+				surface_data.faces_vertex_indices_.push_back(surface_data.vertices_id_[faces->vertex_indices_[nbv * i + j]]);
+			if (face_ref)
+			{
+				surface_data.faces_id_.push_back(face_id);
+				(*face_ref)[face_id++] = faces->refs_[i];
+			}
+		}
+	}
+
+	import_surface_data(m, surface_data);
+
+	return true;
+}
+
+/**
+ * @brief exports the triangles and the quadrilaterals of a surface in a Gamma mesh file, in ASCII or binary
+ * after its extension (.mesh or .meshb), with the optional references of the vertices and of the faces
+ */
+template <typename MESH,
+		  typename std::enable_if<mesh_traits<MESH>::dimension == 2>::type* = nullptr>
+bool export_MESHB(MESH& m, const typename mesh_traits<MESH>::template Attribute<geometry::Vec3>* vertex_position,
+				  const std::string& filename,
+				  const typename mesh_traits<MESH>::template Attribute<int32>* vertex_ref = nullptr,
+				  const typename mesh_traits<MESH>::template Attribute<int32>* face_ref = nullptr)
+{
+	using Vertex = typename MESH::Vertex;
+	using Face = typename MESH::Face;
+	using Vec3 = geometry::Vec3;
+
+	MeshbData meshb;
+	meshb.dimension_ = 3u;
+
+	// contiguous numbering of the vertices
+	auto vertex_id = add_attribute<uint32, Vertex>(m, "__vertex_id");
+	uint32 nb_vertices = 0u;
+	foreach_cell(m, [&] (Vertex v) -> bool
+	{
+		value<uint32>(m, vertex_id, v) = nb_vertices++;
+		const Vec3& p = value<Vec3>(m, vertex_position, v);
+		meshb.vertices_position_.insert(meshb.vertices_position_.end(), { float64(p[0]), float64(p[1]), float64(p[2]) });
+		meshb.vertices_ref_.push_back(vertex_ref ? value<int32>(m, vertex_ref, v) : 0);
+		return true;
+	});
+
+	uint32 nb_ignored = 0u;
+	std::vector<uint32> face_vertices;
+	foreach_cell(m, [&] (Face f) -> bool
+	{
+		face_vertices.clear();
+		foreach_incident_vertex(m, f, [&] (Vertex v) -> bool
+		{
+			face_vertices.push_back(value<uint32>(m, vertex_id, v));
+			return true;
+		});
+		if (face_vertices.size() != 3u && face_vertices.size() != 4u)
+		{
+			++nb_ignored;
+			return true;
+		}
+		MeshbElements& faces = meshb.elements_[face_vertices.size() == 3u ? MESHB_TRIANGLE : MESHB_QUAD];
+		faces.vertex_indices_.insert(faces.vertex_indices_.end(), face_vertices.begin(), face_vertices.end());
+		faces.refs_.push_back(face_ref ? value<int32>(m, face_ref, f) : 0);
+		return true;
+	});
+
+	remove_attribute<Vertex>(m, vertex_id);
+
+	if (nb_ignored > 0u)
+		std::cout << "export_MESHB: " << nb_ignored << " faces that are not triangles or quadrilaterals were ignored." << std::endl;
+
+	if (!write_MESHB(filename, meshb))
+	{
+		std::cerr << "File \"" << filename << "\" could not be written." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_SURFACE_MESHB_H_
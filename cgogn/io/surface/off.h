@@ -27,14 +27,17 @@
 #include <cgogn/io/surface/surface_import.h>
 #include <cgogn/io/utils.h>
 
+#include <cgogn/core/utils/endian.h>
 #include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread.h>
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/functions/attributes.h>
 
 #include <cgogn/geometry/types/vector_traits.h>
 
+#include <atomic>
+#include <cstring>
 #include <vector>
-#include <fstream>
 
 namespace cgogn
 {
@@ -42,70 +45,278 @@ namespace cgogn
 namespace io
 {
 
+/**
+ * @brief reads the body of a binary OFF file (as written by off_ascii2bin), that follows the "OFF BINARY" line:
+ * numbers of vertices, faces and edges, vertices positions (3 float32 each) then for each face its number
+ * of vertices followed by its vertex indices (uint32), all in big endian
+ */
 template <typename MESH>
-bool import_OFF(MESH& m, const std::string& filename)
+bool import_OFF_binary(MESH& m, const std::string& filename, const char* begin, const char* end)
 {
 	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
 
 	using Vertex = typename MESH::Vertex;
 
-	Scoped_C_Locale loc;
+	auto read_uint = [] (const char* p) -> uint32
+	{
+		uint32 x;
+		std::memcpy(&x, p, sizeof(uint32));
+		return swap_endianness_native_big(x);
+	};
+
+	const std::size_t size = std::size_t(end - begin);
+	if (size < 3u * sizeof(uint32))
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid off file." << std::endl;
+		return false;
+	}
+
+	// read number of vertices, faces, edges
+	const uint32 nb_vertices = read_uint(begin);
+	const uint32 nb_faces = read_uint(begin + sizeof(uint32));
+	begin += 3u * sizeof(uint32);
+
+	if (nb_vertices == 0u)
+	{
+		std::cerr << "File \"" << filename << " has no vertices." << std::endl;
+		return false;
+	}
+	if (uint64(end - begin) < uint64(nb_vertices) * 3u * sizeof(float32) + uint64(nb_faces) * sizeof(uint32))
+	{
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
+	}
 
 	SurfaceImportData surface_data;
+	surface_data.reserve(nb_vertices, nb_faces);
+	const char* vertices = begin;
+	begin += std::size_t(nb_vertices) * 3u * sizeof(float32);
 
-	std::ifstream fp(filename.c_str(), std::ios::in);
+	// read faces: bulk copy of the vertex indices of each face
+	std::vector<uint32>& indices = surface_data.faces_vertex_indices_;
+	bool valid = true;
+	for (uint32 i = 0u; i < nb_faces; ++i)
+	{
+		if (std::size_t(end - begin) < sizeof(uint32))
+		{
+			valid = false;
+			break;
+		}
+		const uint32 n = read_uint(begin);
+		begin += sizeof(uint32);
+		if (std::size_t(end - begin) / sizeof(uint32) < n)
+		{
+			valid = false;
+			break;
+		}
+		// the faces with less than 3 vertices are skipped
+		if (n >= 3u)
+		{
+			const std::size_t first_index = indices.size();
+			indices.resize(first_index + n);
+			std::memcpy(indices.data() + first_index, begin, std::size_t(n) * sizeof(uint32));
+			surface_data.faces_nb_vertices_.push_back(n);
+		}
+		begin += std::size_t(n) * sizeof(uint32);
+	}
+
+	// check the vertex indices (the map is only changed once the whole file is read)
+	std::atomic<bool> valid_indices(true);
+	thread_pool()->parallel_for(0u, uint32(indices.size()), [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+		{
+			indices[i] = swap_endianness_native_big(indices[i]);
+			if (indices[i] >= nb_vertices)
+			{
+				valid_indices.store(false, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}, PARALLEL_BUFFER_SIZE);
+
+	if (!valid || !valid_indices.load())
+	{
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
+	}
 
-	std::string line;
-	line.reserve(512u);
+	// read vertices position and convert the vertex indices to vertex ids
+	auto position = add_attribute<geometry::Vec3, CMap2::Vertex>(m, "position");
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	surface_data.vertices_id_.resize(nb_vertices);
+	thread_pool()->parallel_for(0u, nb_vertices, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+		{
+			float32 p[3];
+			std::memcpy(p, vertices + std::size_t(i) * sizeof(p), sizeof(p));
+			(*position)[first_vertex_id + i] = {
+				swap_endianness_native_big(p[0]),
+				swap_endianness_native_big(p[1]),
+				swap_endianness_native_big(p[2])
+			};
+			surface_data.vertices_id_[i] = first_vertex_id + i;
+		}
+	}, PARALLEL_BUFFER_SIZE);
+	thread_pool()->parallel_for(0u, uint32(indices.size()), [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+			indices[i] += first_vertex_id;
+	}, PARALLEL_BUFFER_SIZE);
+
+	import_surface_data(m, surface_data);
+
+	return true;
+}
+
+template <typename MESH>
+bool import_OFF(MESH& m, const std::string& filename)
+{
+	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
+
+	using Vertex = typename MESH::Vertex;
+
+	SurfaceImportData surface_data;
+
+	MappedFile file(filename);
+	if (!file.is_open())
+	{
+		std::cerr << "File \"" << filename << "\" could not be opened." << std::endl;
+		return false;
+	}
+	TextTokenizer tok(file.begin(), file.end());
 
 	// read OFF header
-	getline_safe(fp, line);
-	if (line.rfind("OFF") == std::string::npos)
+	const std::string_view header = tok.next_line();
+	if (header.find("OFF") == std::string_view::npos)
 	{
 		std::cerr << "File \"" << filename << "\" is not a valid off file." << std::endl;
 		return false;
 	}
+	if (header.find("BINARY") != std::string_view::npos)
+		return import_OFF_binary(m, filename, tok.position(), file.end());
 
 	// read number of vertices, edges, faces
-	const uint32 nb_vertices = read_uint(fp, line);
-	const uint32 nb_faces = read_uint(fp, line);
-	/*const uint32 nb_edges_ =*/ read_uint(fp, line);
+	const uint32 nb_vertices = tok.read_uint();
+	const uint32 nb_faces = tok.read_uint();
+	/*const uint32 nb_edges_ =*/ tok.read_uint();
 
+	if (!tok.good())
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid off file." << std::endl;
+		return false;
+	}
 	if (nb_vertices == 0u)
 	{
 		std::cerr << "File \"" << filename << " has no vertices." << std::endl;
 		return false;
 	}
-	
+
+	// the file is parsed in local buffers (with the vertex indices of the file in the faces):
+	// the map is only changed once the whole file is read
 	surface_data.reserve(nb_vertices, nb_faces);
-	auto position = add_attribute<geometry::Vec3, CMap2::Vertex>(m, "position");
+	std::vector<geometry::Vec3> positions(nb_vertices);
 
-	// read vertices position
-	for (uint32 i = 0u; i < nb_vertices; ++i)
+	auto read_vertex = [&] (TextTokenizer& t, uint32 i) -> bool
 	{
-		float64 x = read_double(fp, line);
-		float64 y = read_double(fp, line);
-		float64 z = read_double(fp, line);
+		geometry::Scalar x = t.read_double();
+		geometry::Scalar y = t.read_double();
+		geometry::Scalar z = t.read_double();
+		positions[i] = { x, y, z };
+		return t.good();
+	};
+	auto read_face = [&] (TextTokenizer& t, SurfaceImportData& data) -> bool
+	{
+		uint32 n = t.read_uint();
+		for (uint32 j = 0u; j < n; ++j)
+		{
+			const uint32 k = t.read_uint();
+			if (k >= nb_vertices)
+				return false;
+			data.faces_vertex_indices_.push_back(k);
+		}
+		data.faces_nb_vertices_.push_back(n);
+		return t.good();
+	};
 
-		uint32 vertex_id = new_index<Vertex>(m);
-		(*position)[vertex_id] = { x, y, z };
+	// read vertices position and faces (vertex indices) with one record per line,
+	// on line aligned chunks of the file parsed in parallel
+	const TextChunks chunks = split_text(tok.position(), file.end());
+	std::vector<SurfaceImportData> chunks_data(chunks.nb_chunks());
+	bool parsed = parallel_foreach_record(chunks, 0u, nb_vertices, [&] (uint32, uint32 r, TextTokenizer& line) -> bool
+	{
+		return read_vertex(line, r);
+	});
+	parsed = parsed && parallel_foreach_record(chunks, nb_vertices, nb_vertices + nb_faces,
+		[&] (uint32 c, uint32, TextTokenizer& line) -> bool
+	{
+		return read_face(line, chunks_data[c]);
+	});
 
-		surface_data.vertices_id_.push_back(vertex_id);
+	if (parsed)
+	{
+		for (const SurfaceImportData& data : chunks_data)
+		{
+			surface_data.faces_nb_vertices_.insert(surface_data.faces_nb_vertices_.end(),
+				data.faces_nb_vertices_.begin(), data.faces_nb_vertices_.end());
+			surface_data.faces_vertex_indices_.insert(surface_data.faces_vertex_indices_.end(),
+				data.faces_vertex_indices_.begin(), data.faces_vertex_indices_.end());
+		}
 	}
-
-	// read faces (vertex indices)
-	for (uint32 i = 0u; i < nb_faces ; ++i)
+	else
 	{
-		uint32 n = read_uint(fp, line);
-		
-		std::vector<uint32> indices(n);
-		for (uint32 j = 0u; j < n; ++j)
-			indices[j] = surface_data.vertices_id_[read_uint(fp, line)];
+		// the records are not one per line: the tokens are parsed in sequence, first skipping the end
+		// of the line of each record (optional attributes, e.g. normal or color), then as a pure token
+		// stream (several records on a line, without optional attributes)
+		auto parse_tokens = [&] (bool skip_lines) -> bool
+		{
+			TextTokenizer t(tok.position(), file.end());
+			surface_data.faces_nb_vertices_.clear();
+			surface_data.faces_vertex_indices_.clear();
+			for (uint32 i = 0u; i < nb_vertices; ++i)
+			{
+				if (!read_vertex(t, i))
+					return false;
+				if (skip_lines)
+					t.skip_line();
+			}
+			for (uint32 i = 0u; i < nb_faces; ++i)
+			{
+				if (!read_face(t, surface_data))
+					return false;
+				if (skip_lines)
+					t.skip_line();
+			}
+			return t.good();
+		};
+		parsed = parse_tokens(true) || parse_tokens(false);
+	}
 
-		surface_data.faces_nb_vertices_.push_back(n);
-		surface_data.faces_vertex_indices_.insert(surface_data.faces_vertex_indices_.end(), indices.begin(), indices.end());
+	if (!parsed)
+	{
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
 	}
 
+	auto position = add_attribute<geometry::Vec3, CMap2::Vertex>(m, "position");
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	surface_data.vertices_id_.resize(nb_vertices);
+	thread_pool()->parallel_for(0u, nb_vertices, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+		{
+			(*position)[first_vertex_id + i] = positions[i];
+			surface_data.vertices_id_[i] = first_vertex_id + i;
+		}
+	}, PARALLEL_BUFFER_SIZE);
+	std::vector<uint32>& indices = surface_data.faces_vertex_indices_;
+	thread_pool()->parallel_for(0u, uint32(indices.size()), [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+			indices[i] += first_vertex_id;
+	}, PARALLEL_BUFFER_SIZE);
+
 	import_surface_data(m, surface_data);
 
 	return true;
@@ -0,0 +1,131 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cgogn/io/surface/ply.h>
+
+#include <ply.h>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+static_assert(PLY_TYPE_INT8 == PLY_Int8 && PLY_TYPE_UINT32 == PLY_Uint32 && PLY_TYPE_FLOAT64 == PLY_Float64,
+			  "PlyType codes should match the ply library ones");
+
+bool read_PLY_header(const std::string& filename, PlyHeader& header)
+{
+	FILE* fp = std::fopen(filename.c_str(), "rb");
+	if (fp == nullptr)
+		return false;
+
+	PlyFile* ply = read_ply(fp);
+	if (ply == nullptr)
+	{
+		std::fclose(fp);
+		return false;
+	}
+
+	const long data_offset = std::ftell(fp);
+
+	// the library does not check that the format is given nor that the header is complete
+	bool valid = data_offset > 0;
+	if (valid)
+	{
+		std::string text(std::size_t(data_offset), '\0');
+		std::rewind(fp);
+		valid = std::fread(&text[0], 1u, text.size(), fp) == text.size() &&
+				text.find("\nformat ") != std::string::npos && text.find("\nend_header") != std::string::npos;
+	}
+
+	if (valid)
+	{
+		header.format = ply->file_type == PLY_BINARY_LE ? PLY_FORMAT_BINARY_LITTLE_ENDIAN :
+						ply->file_type == PLY_BINARY_BE ? PLY_FORMAT_BINARY_BIG_ENDIAN : PLY_FORMAT_ASCII;
+		header.data_offset = std::size_t(data_offset);
+		header.elements.clear();
+		for (int i = 0; i < ply->num_elem_types && valid; ++i)
+		{
+			const PlyElement* elem = ply->elems[i];
+			valid = elem->num >= 0;
+			PlyElementInfo element{ elem->name, uint32(elem->num), {} };
+			for (int j = 0; j < elem->nprops && valid; ++j)
+			{
+				const PlyProperty* prop = elem->props[j];
+				const bool is_list = prop->is_list == PLY_LIST;
+				valid = prop->is_list != PLY_STRING &&
+						prop->external_type > PLY_StartType && prop->external_type < PLY_EndType &&
+						(!is_list || (prop->count_external > PLY_StartType && prop->count_external < PLY_EndType));
+				element.properties.push_back({
+					prop->name,
+					PlyType(prop->external_type),
+					is_list ? PlyType(prop->count_external) : PLY_TYPE_INVALID
+				});
+			}
+			header.elements.push_back(std::move(element));
+		}
+	}
+
+	free_ply(ply);
+	std::fclose(fp);
+	return valid;
+}
+
+bool write_PLY(const std::string& filename, const PlyHeader& header, const std::vector<char>& data)
+{
+	FILE* fp = std::fopen(filename.c_str(), "wb");
+	if (fp == nullptr)
+		return false;
+
+	std::vector<char*> element_names;
+	for (const PlyElementInfo& element : header.elements)
+		element_names.push_back(const_cast<char*>(element.name.c_str()));
+	const int file_type = header.format == PLY_FORMAT_ASCII ? PLY_ASCII :
+						  header.format == PLY_FORMAT_BINARY_BIG_ENDIAN ? PLY_BINARY_BE : PLY_BINARY_LE;
+	PlyFile* ply = write_ply(fp, int(element_names.size()), element_names.data(), file_type);
+
+	for (const PlyElementInfo& element : header.elements)
+	{
+		describe_element_ply(ply, const_cast<char*>(element.name.c_str()), int(element.nb));
+		for (const PlyPropertyInfo& property : element.properties)
+		{
+			PlyProperty prop{};
+			prop.name = const_cast<char*>(property.name.c_str());
+			prop.external_type = prop.internal_type = int(property.type);
+			prop.is_list = property.is_list() ? PLY_LIST : PLY_SCALAR;
+			prop.count_external = prop.count_internal = int(property.count_type);
+			describe_property_ply(ply, &prop);
+		}
+	}
+	header_complete_ply(ply);
+	free_ply(ply);
+
+	bool written = std::fwrite(data.data(), 1u, data.size(), fp) == data.size();
+	written &= std::fclose(fp) == 0;
+	return written;
+}
+
+} // namespace io
+
+} // namespace cgogn
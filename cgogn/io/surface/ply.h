@@ -0,0 +1,692 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef CGOGN_IO_SURFACE_PLY_H_
+#define CGOGN_IO_SURFACE_PLY_H_
+
+#include <cgogn/io/cgogn_io_export.h>
+#include <cgogn/io/surface/surface_import.h>
+#include <cgogn/io/utils.h>
+
+#include <cgogn/core/utils/endian.h>
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+// same codes as the vendored ply library
+enum PlyType : uint32
+{
+	PLY_TYPE_INVALID = 0,
+	PLY_TYPE_INT8,
+	PLY_TYPE_INT16,
+	PLY_TYPE_INT32,
+	PLY_TYPE_UINT8,
+	PLY_TYPE_UINT16,
+	PLY_TYPE_UINT32,
+	PLY_TYPE_FLOAT32,
+	PLY_TYPE_FLOAT64
+};
+
+enum PlyFormat : uint32
+{
+	PLY_FORMAT_ASCII = 0,
+	PLY_FORMAT_BINARY_LITTLE_ENDIAN,
+	PLY_FORMAT_BINARY_BIG_ENDIAN
+};
+
+inline uint32 ply_type_size(PlyType type)
+{
+	static const uint32 sizes[] = { 0u, 1u, 2u, 4u, 1u, 2u, 4u, 4u, 8u };
+	return sizes[type];
+}
+
+struct PlyPropertyInfo
+{
+	std::string name;
+	PlyType type; // type of the value (of the values for a list)
+	PlyType count_type; // type of the number of values of a list, PLY_TYPE_INVALID for a scalar
+
+	inline bool is_list() const { return count_type != PLY_TYPE_INVALID; }
+};
+
+struct PlyElementInfo
+{
+	std::string name;
+	uint32 nb;
+	std::vector<PlyPropertyInfo> properties;
+
+	// size in bytes of a binary record, 0 if the element has a list property
+	inline uint32 record_size() const
+	{
+		uint32 size = 0u;
+		for (const PlyPropertyInfo& p : properties)
+		{
+			if (p.is_list())
+				return 0u;
+			size += ply_type_size(p.type);
+		}
+		return size;
+	}
+};
+
+struct PlyHeader
+{
+	PlyFormat format;
+	std::vector<PlyElementInfo> elements;
+	std::size_t data_offset; // position of the first data byte in the file
+
+	inline const PlyElementInfo* element(const std::string& name) const
+	{
+		for (const PlyElementInfo& e : elements)
+		{
+			if (e.name == name)
+				return &e;
+		}
+		return nullptr;
+	}
+};
+
+/**
+ * @brief reads the header of a PLY file with the vendored ply library
+ * @return false if the file could not be opened or if the header is not valid or has string properties
+ */
+bool CGOGN_IO_EXPORT read_PLY_header(const std::string& filename, PlyHeader& header);
+
+/**
+ * @brief writes the header with the vendored ply library followed by the already encoded data
+ */
+bool CGOGN_IO_EXPORT write_PLY(const std::string& filename, const PlyHeader& header, const std::vector<char>& data);
+
+/**
+ * @brief reads the values of the elements in place, from the text or the binary data of a PLY file
+ */
+class PlyDataReader
+{
+public:
+
+	inline PlyDataReader(const char* begin, const char* end, PlyFormat format) :
+		tok_(begin, end), cur_(begin), end_(end), format_(format), good_(true)
+	{}
+
+	inline bool good() const { return format_ == PLY_FORMAT_ASCII ? tok_.good() : good_; }
+	inline bool binary() const { return format_ != PLY_FORMAT_ASCII; }
+	inline bool swap() const { return format_ == (cgogn_is_little_endian ? PLY_FORMAT_BINARY_BIG_ENDIAN : PLY_FORMAT_BINARY_LITTLE_ENDIAN); }
+
+	// binary data only
+	inline const char* position() const { return cur_; }
+	inline std::size_t remaining() const { return std::size_t(end_ - cur_); }
+	inline void advance(std::size_t size)
+	{
+		if (remaining() < size)
+		{
+			good_ = false;
+			cur_ = end_;
+		}
+		else
+			cur_ += size;
+	}
+
+	// decodes a binary value
+	static inline float64 decode(const char* p, PlyType type, bool swap)
+	{
+		switch (type)
+		{
+			case PLY_TYPE_INT8: return float64(decode<int8>(p, swap));
+			case PLY_TYPE_INT16: return float64(decode<int16>(p, swap));
+			case PLY_TYPE_INT32: return float64(decode<int32>(p, swap));
+			case PLY_TYPE_UINT8: return float64(decode<uint8>(p, swap));
+			case PLY_TYPE_UINT16: return float64(decode<uint16>(p, swap));
+			case PLY_TYPE_UINT32: return float64(decode<uint32>(p, swap));
+			case PLY_TYPE_FLOAT32: return float64(decode<float32>(p, swap));
+			case PLY_TYPE_FLOAT64: return decode<float64>(p, swap);
+			default: return 0.0;
+		}
+	}
+
+	inline float64 read(PlyType type)
+	{
+		if (!binary())
+			return tok_.read_double();
+		const uint32 size = ply_type_size(type);
+		if (remaining() < size)
+		{
+			good_ = false;
+			cur_ = end_;
+			return 0.0;
+		}
+		const float64 value = decode(cur_, type, swap());
+		cur_ += size;
+		return value;
+	}
+
+	inline uint32 read_uint(PlyType type)
+	{
+		if (!binary())
+			return tok_.read_uint();
+		const float64 value = read(type);
+		if (value < 0.0)
+			good_ = false;
+		return uint32(value);
+	}
+
+	inline void skip(const PlyPropertyInfo& p)
+	{
+		if (p.is_list())
+		{
+			const uint32 n = read_uint(p.count_type);
+			if (binary())
+				advance(std::size_t(n) * ply_type_size(p.type));
+			else
+			{
+				for (uint32 i = 0u; i < n; ++i)
+					tok_.next_token();
+			}
+		}
+		else if (binary())
+			advance(ply_type_size(p.type));
+		else
+			tok_.next_token();
+	}
+
+	inline void skip(const PlyElementInfo& e)
+	{
+		const uint32 size = e.record_size();
+		if (binary() && size > 0u)
+			advance(std::size_t(e.nb) * size);
+		else
+		{
+			for (uint32 i = 0u; i < e.nb && good(); ++i)
+			{
+				for (const PlyPropertyInfo& p : e.properties)
+					skip(p);
+			}
+		}
+	}
+
+private:
+
+	template <typename T>
+	static inline T decode(const char* p, bool swap)
+	{
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		return swap ? swap_endianness(value) : value;
+	}
+
+	TextTokenizer tok_;
+	const char* cur_;
+	const char* end_;
+	PlyFormat format_;
+	bool good_;
+};
+
+/**
+ * @brief encodes the values of the elements, as text or as little endian binary data
+ */
+class PlyDataWriter
+{
+public:
+
+	inline PlyDataWriter(bool binary) : binary_(binary)
+	{}
+
+	inline void write(float64 value, PlyType type)
+	{
+		switch (type)
+		{
+			case PLY_TYPE_INT8: write_value(int8(value)); break;
+			case PLY_TYPE_INT16: write_value(int16(value)); break;
+			case PLY_TYPE_INT32: write_value(int32(value)); break;
+			case PLY_TYPE_UINT8: write_value(uint8(value)); break;
+			case PLY_TYPE_UINT16: write_value(uint16(value)); break;
+			case PLY_TYPE_UINT32: write_value(uint32(value)); break;
+			case PLY_TYPE_FLOAT32: write_value(float32(value)); break;
+			case PLY_TYPE_FLOAT64: write_value(value); break;
+			default: break;
+		}
+	}
+
+	inline void end_record()
+	{
+		if (!binary_)
+			data_.back() = '\n';
+	}
+
+	inline const std::vector<char>& data() const { return data_; }
+
+private:
+
+	template <typename T>
+	inline void write_value(T value)
+	{
+		if (binary_)
+		{
+			value = swap_endianness_native_little(value);
+			const char* p = reinterpret_cast<const char*>(&value);
+			data_.insert(data_.end(), p, p + sizeof(T));
+			return;
+		}
+		char buffer[32];
+		int n;
+		if constexpr (std::is_same<T, float32>::value)
+			n = std::snprintf(buffer, sizeof(buffer), "%.9g ", value);
+		else if constexpr (std::is_same<T, float64>::value)
+			n = std::snprintf(buffer, sizeof(buffer), "%.17g ", value);
+		else if constexpr (std::is_signed<T>::value)
+			n = std::snprintf(buffer, sizeof(buffer), "%d ", int32(value));
+		else
+			n = std::snprintf(buffer, sizeof(buffer), "%u ", uint32(value));
+		data_.insert(data_.end(), buffer, buffer + n);
+	}
+
+	bool binary_;
+	std::vector<char> data_;
+};
+
+/**
+ * @brief imports a surface from an ASCII or binary PLY file:
+ * - the x, y, z properties of the "vertex" element go in the "position" attribute, nx, ny, nz in the "normal"
+ * attribute and red, green, blue in the "color" attribute (in [0, 1] when stored as 8 or 16 bits integers),
+ * - its other scalar properties go in Scalar vertex attributes of the same name,
+ * - the "vertex_indices" (or "vertex_index") list of the "face" element gives the faces.
+ * The fixed size records of the vertices of a binary file are decoded in parallel.
+ */
+template <typename MESH>
+bool import_PLY(MESH& m, const std::string& filename)
+{
+	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
+
+	using Vertex = typename MESH::Vertex;
+	using Vec3 = geometry::Vec3;
+	using Scalar = geometry::Scalar;
+	using AttributeVec3 = typename mesh_traits<MESH>::template Attribute<Vec3>;
+	using AttributeScalar = typename mesh_traits<MESH>::template Attribute<Scalar>;
+
+	SurfaceImportData surface_data;
+
+	MappedFile file(filename);
+	if (!file.is_open())
+	{
+		std::cerr << "File \"" << filename << "\" could not be opened." << std::endl;
+		return false;
+	}
+
+	PlyHeader header;
+	if (!read_PLY_header(filename, header) || header.data_offset > file.size())
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid ply file." << std::endl;
+		return false;
+	}
+
+	const PlyElementInfo* vertex_element = header.element("vertex");
+	if (vertex_element == nullptr || vertex_element->nb == 0u)
+	{
+		std::cerr << "File \"" << filename << "\" has no vertices." << std::endl;
+		return false;
+	}
+	const uint32 nb_vertices = vertex_element->nb;
+	const uint32 nb_vertex_properties = uint32(vertex_element->properties.size());
+
+	// the file is decoded in local buffers (with the vertex indices of the file in the faces):
+	// the map is only changed once the whole file is read
+	enum Vec3Buffer : uint32 { POSITION = 0, NORMAL, COLOR, NB_VEC3_BUFFERS };
+	const std::array<const char*, NB_VEC3_BUFFERS> vec3_names = { "position", "normal", "color" };
+	std::array<std::vector<Vec3>, NB_VEC3_BUFFERS> vec3_values;
+	std::array<uint32, NB_VEC3_BUFFERS> vec3_components = { 0u, 0u, 0u };
+	std::vector<std::string> scalar_names;
+	std::vector<std::vector<Scalar>> scalar_values;
+
+	// buffer (and component) of each property of the vertices, none for the lists
+	struct VertexProperty
+	{
+		int32 vec3 = -1;
+		int32 scalar = -1;
+		uint32 component = 0u;
+		float64 scale = 1.0;
+	};
+	std::vector<VertexProperty> vertex_properties(nb_vertex_properties);
+
+	auto vec3_component = [&] (const PlyPropertyInfo& p, Vec3Buffer b, const char* x, const char* y, const char* z,
+							   VertexProperty& vp) -> bool
+	{
+		const uint32 c = p.name == x ? 0u : p.name == y ? 1u : p.name == z ? 2u : 3u;
+		if (c == 3u)
+			return false;
+		if (vec3_values[b].empty())
+			vec3_values[b].assign(nb_vertices, Vec3(0, 0, 0));
+		vec3_components[b] |= 1u << c;
+		vp.vec3 = int32(b);
+		vp.component = c;
+		return true;
+	};
+
+	for (uint32 j = 0u; j < nb_vertex_properties; ++j)
+	{
+		const PlyPropertyInfo& p = vertex_element->properties[j];
+		VertexProperty& vp = vertex_properties[j];
+		if (p.is_list())
+			continue;
+		if (vec3_component(p, POSITION, "x", "y", "z", vp) || vec3_component(p, NORMAL, "nx", "ny", "nz", vp))
+			continue;
+		if (vec3_component(p, COLOR, "red", "green", "blue", vp))
+		{
+			if (p.type == PLY_TYPE_UINT8)
+				vp.scale = 1.0 / 255.0;
+			else if (p.type == PLY_TYPE_UINT16)
+				vp.scale = 1.0 / 65535.0;
+			continue;
+		}
+		// (the first property of a given name is kept)
+		if (std::find(scalar_names.begin(), scalar_names.end(), p.name) == scalar_names.end())
+		{
+			vp.scalar = int32(scalar_names.size());
+			scalar_names.push_back(p.name);
+			scalar_values.emplace_back(nb_vertices, Scalar(0));
+		}
+	}
+
+	if (vec3_components[POSITION] != 7u)
+	{
+		std::cerr << "File \"" << filename << "\" has no vertex position." << std::endl;
+		return false;
+	}
+
+	auto set_vertex_value = [&] (const VertexProperty& vp, uint32 i, float64 value)
+	{
+		if (vp.vec3 >= 0)
+			vec3_values[vp.vec3][i][vp.component] = Scalar(value * vp.scale);
+		else if (vp.scalar >= 0)
+			scalar_values[vp.scalar][i] = Scalar(value);
+	};
+
+	PlyDataReader reader(file.begin() + header.data_offset, file.end(), header.format);
+	bool valid = true;
+
+	for (const PlyElementInfo& e : header.elements)
+	{
+		if (&e == vertex_element)
+		{
+			const uint32 record_size = e.record_size();
+			if (reader.binary() && record_size > 0u)
+			{
+				// bulk decoding of the fixed size records
+				std::vector<uint32> offsets(nb_vertex_properties, 0u);
+				for (uint32 j = 1u; j < nb_vertex_properties; ++j)
+					offsets[j] = offsets[j - 1u] + ply_type_size(e.properties[j - 1u].type);
+				const char* records = reader.position();
+				const bool swap = reader.swap();
+				reader.advance(std::size_t(nb_vertices) * record_size);
+				if (!reader.good())
+					break;
+				thread_pool()->parallel_for(0u, nb_vertices, [&] (uint32 first, uint32 last)
+				{
+					for (uint32 i = first; i < last; ++i)
+					{
+						const char* record = records + std::size_t(i) * record_size;
+						for (uint32 j = 0u; j < nb_vertex_properties; ++j)
+							set_vertex_value(vertex_properties[j], i,
+								PlyDataReader::decode(record + offsets[j], e.properties[j].type, swap));
+					}
+				}, PARALLEL_BUFFER_SIZE);
+			}
+			else
+			{
+				for (uint32 i = 0u; i < nb_vertices && reader.good(); ++i)
+				{
+					for (uint32 j = 0u; j < nb_vertex_properties; ++j)
+					{
+						const PlyPropertyInfo& p = e.properties[j];
+						if (p.is_list())
+							reader.skip(p);
+						else
+							set_vertex_value(vertex_properties[j], i, reader.read(p.type));
+					}
+				}
+			}
+		}
+		else if (e.name == "face")
+		{
+			uint32 indices_property = uint32(e.properties.size());
+			for (uint32 j = 0u; j < e.properties.size(); ++j)
+			{
+				const PlyPropertyInfo& p = e.properties[j];
+				if (p.is_list() && (p.name == "vertex_indices" || p.name == "vertex_index"))
+					indices_property = j;
+			}
+			surface_data.faces_nb_vertices_.reserve(e.nb);
+			surface_data.faces_vertex_indices_.reserve(std::size_t(e.nb) * 3u);
+			for (uint32 i = 0u; i < e.nb && reader.good() && valid; ++i)
+			{
+				for (uint32 j = 0u; j < e.properties.size(); ++j)
+				{
+					const PlyPropertyInfo& p = e.properties[j];
+					if (j != indices_property)
+					{
+						reader.skip(p);
+						continue;
+					}
+					const uint32 n = reader.read_uint(p.count_type);
+					for (uint32 k = 0u; k < n && valid; ++k)
+					{
+						const uint32 index = reader.read_uint(p.type);
+						valid = index < nb_vertices;
+						if (valid)
+							surface_data.faces_vertex_indices_.push_back(index);
+					}
+					// the faces with less than 3 vertices are skipped
+					if (n >= 3u)
+						surface_data.faces_nb_vertices_.push_back(n);
+					else if (valid)
+						surface_data.faces_vertex_indices_.resize(surface_data.faces_vertex_indices_.size() - n);
+				}
+			}
+		}
+		else
+			reader.skip(e);
+
+		if (!reader.good() || !valid)
+			break;
+	}
+
+	if (!reader.good() || !valid)
+	{
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
+	}
+
+	// the attributes that already exist in the map (other than the position) are not filled
+	std::array<std::shared_ptr<AttributeVec3>, NB_VEC3_BUFFERS> vec3_attributes;
+	vec3_attributes[POSITION] = add_attribute<Vec3, Vertex>(m, vec3_names[POSITION]);
+	if (!vec3_attributes[POSITION])
+	{
+		std::cerr << "File \"" << filename << "\": the position attribute already exists." << std::endl;
+		return false;
+	}
+	for (uint32 b = NORMAL; b < NB_VEC3_BUFFERS; ++b)
+	{
+		if (!vec3_values[b].empty())
+			vec3_attributes[b] = add_attribute<Vec3, Vertex>(m, vec3_names[b]);
+	}
+	std::vector<std::shared_ptr<AttributeScalar>> scalar_attributes(scalar_names.size());
+	for (uint32 s = 0u; s < scalar_names.size(); ++s)
+		scalar_attributes[s] = add_attribute<Scalar, Vertex>(m, scalar_names[s]);
+
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	surface_data.vertices_id_.resize(nb_vertices);
+	thread_pool()->parallel_for(0u, nb_vertices, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+		{
+			for (uint32 b = 0u; b < NB_VEC3_BUFFERS; ++b)
+			{
+				if (vec3_attributes[b])
+					(*vec3_attributes[b])[first_vertex_id + i] = vec3_values[b][i];
+			}
+			for (uint32 s = 0u; s < scalar_attributes.size(); ++s)
+			{
+				if (scalar_attributes[s])
+					(*scalar_attributes[s])[first_vertex_id + i] = scalar_values[s][i];
+			}
+			surface_data.vertices_id_[i] = first_vertex_id + i;
+		}
+	}, PARALLEL_BUFFER_SIZE);
+	std::vector<uint32>& indices = surface_data.faces_vertex_indices_;
+	thread_pool()->parallel_for(0u, uint32(indices.size()), [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+			indices[i] += first_vertex_id;
+	}, PARALLEL_BUFFER_SIZE);
+
+	import_surface_data(m, surface_data);
+
+	return true;
+}
+
+/**
+ * @brief exports the faces of a surface in an ASCII or binary (little endian) PLY file, with the position and
+ * optionally the normal and the color (in [0, 1], written as 8 bits integers) of their vertices
+ */
+template <typename MESH>
+bool export_PLY(MESH& m, const typename mesh_traits<MESH>::template Attribute<geometry::Vec3>* vertex_position,
+				const std::string& filename, bool binary = true,
+				const typename mesh_traits<MESH>::template Attribute<geometry::Vec3>* vertex_normal = nullptr,
+				const typename mesh_traits<MESH>::template Attribute<geometry::Vec3>* vertex_color = nullptr)
+{
+	static_assert(mesh_traits<MESH>::dimension == 2, "MESH dimension should be 2");
+
+	using Vertex = typename MESH::Vertex;
+	using Face = typename MESH::Face;
+	using Vec3 = geometry::Vec3;
+
+	const PlyType scalar_type = sizeof(geometry::Scalar) == 4u ? PLY_TYPE_FLOAT32 : PLY_TYPE_FLOAT64;
+
+	// contiguous numbering of the vertices
+	auto vertex_id = add_attribute<uint32, Vertex>(m, "__vertex_id");
+	uint32 nb_vertices = 0u;
+	foreach_cell(m, [&] (Vertex v) -> bool
+	{
+		value<uint32>(m, vertex_id, v) = nb_vertices++;
+		return true;
+	});
+	uint32 nb_faces = 0u;
+	uint32 max_degree = 0u;
+	foreach_cell(m, [&] (Face f) -> bool
+	{
+		uint32 degree = 0u;
+		foreach_incident_vertex(m, f, [&] (Vertex) -> bool { ++degree; return true; });
+		max_degree = std::max(max_degree, degree);
+		++nb_faces;
+		return true;
+	});
+
+	PlyHeader header;
+	header.format = binary ? PLY_FORMAT_BINARY_LITTLE_ENDIAN : PLY_FORMAT_ASCII;
+	PlyElementInfo vertices{ "vertex", nb_vertices, {} };
+	for (const char* name : { "x", "y", "z" })
+		vertices.properties.push_back({ name, scalar_type, PLY_TYPE_INVALID });
+	if (vertex_normal)
+	{
+		for (const char* name : { "nx", "ny", "nz" })
+			vertices.properties.push_back({ name, scalar_type, PLY_TYPE_INVALID });
+	}
+	if (vertex_color)
+	{
+		for (const char* name : { "red", "green", "blue" })
+			vertices.properties.push_back({ name, PLY_TYPE_UINT8, PLY_TYPE_INVALID });
+	}
+	const PlyType count_type = max_degree < 256u ? PLY_TYPE_UINT8 : PLY_TYPE_UINT32;
+	PlyElementInfo faces{ "face", nb_faces, { { "vertex_indices", PLY_TYPE_INT32, count_type } } };
+	header.elements = { vertices, faces };
+
+	PlyDataWriter writer(binary);
+	foreach_cell(m, [&] (Vertex v) -> bool
+	{
+		const Vec3& p = value<Vec3>(m, vertex_position, v);
+		for (uint32 i = 0u; i < 3u; ++i)
+			writer.write(p[i], scalar_type);
+		if (vertex_normal)
+		{
+			const Vec3& n = value<Vec3>(m, vertex_normal, v);
+			for (uint32 i = 0u; i < 3u; ++i)
+				writer.write(n[i], scalar_type);
+		}
+		if (vertex_color)
+		{
+			const Vec3& c = value<Vec3>(m, vertex_color, v);
+			for (uint32 i = 0u; i < 3u; ++i)
+				writer.write(std::floor(std::clamp(float64(c[i]), 0.0, 1.0) * 255.0 + 0.5), PLY_TYPE_UINT8);
+		}
+		writer.end_record();
+		return true;
+	});
+	std::vector<uint32> face_vertices;
+	foreach_cell(m, [&] (Face f) -> bool
+	{
+		face_vertices.clear();
+		foreach_incident_vertex(m, f, [&] (Vertex v) -> bool
+		{
+			face_vertices.push_back(value<uint32>(m, vertex_id, v));
+			return true;
+		});
+		writer.write(face_vertices.size(), count_type);
+		for (uint32 id : face_vertices)
+			writer.write(id, PLY_TYPE_INT32);
+		writer.end_record();
+		return true;
+	});
+
+	remove_attribute<Vertex>(m, vertex_id);
+
+	if (!write_PLY(filename, header, writer.data()))
+	{
+		std::cerr << "File \"" << filename << "\" could not be written." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_SURFACE_PLY_H_
@@ -38,10 +38,17 @@ namespace io
 void import_surface_data(CMap2& m, const SurfaceImportData& surface_data)
 {
 	using Vertex = CMap2::Vertex;
+	using Face = CMap2::Face;
+
+	const bool set_face_indices = !surface_data.faces_id_.empty() && m.is_indexed<Face>();
+
+	// the imported faces are added to the ones of the map
+	const bool pure_simplicial = m.nb_darts() == 0u || m.is_pure_simplicial();
 
 	auto darts_per_vertex = add_attribute<std::vector<Dart>, Vertex>(m, "__darts_per_vertex");
 
 	uint32 faces_vertex_index = 0u;
+	bool triangles_only = true;
 	std::vector<uint32> vertices_buffer;
 	vertices_buffer.reserve(16u);
 
@@ -61,12 +68,13 @@ void import_surface_data(CMap2& m, const SurfaceImportData& surface_data)
 				vertices_buffer.push_back(idx);
 			}
 		}
-		if (vertices_buffer.front() == vertices_buffer.back())
+		if (vertices_buffer.size() > 1u && vertices_buffer.front() == vertices_buffer.back())
 			vertices_buffer.pop_back();
 
 		nbv = vertices_buffer.size();
 		if (nbv > 2u)
 		{
+			triangles_only &= nbv == 3u;
 			CMap1::Face f = add_face(static_cast<CMap1&>(m), nbv, false);
 			Dart d = f.dart;
 			for (uint32 j = 0u; j < nbv; ++j)
@@ -74,6 +82,8 @@ void import_surface_data(CMap2& m, const SurfaceImportData& surface_data)
 				const uint32 vertex_index = vertices_buffer[j];
 				m.set_index<Vertex>(d, vertex_index);
 				(*darts_per_vertex)[vertex_index].push_back(d);
+				if (set_face_indices)
+					m.set_index<Face>(d, surface_data.faces_id_[i]);
 				d = m.phi1(d);
 			}
 		}
@@ -131,6 +141,10 @@ void import_surface_data(CMap2& m, const SurfaceImportData& surface_data)
 	// }
 
 	remove_attribute<Vertex>(m, darts_per_vertex);
+
+	// set after the sewing of the faces (that resets the flag and the labels)
+	m.set_pure_simplicial(pure_simplicial && triangles_only);
+	m.label_volumes();
 }
 
 } // namespace io
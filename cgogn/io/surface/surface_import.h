@@ -41,6 +41,8 @@ struct SurfaceImportData
 	std::vector<uint32> vertices_id_;
 	std::vector<uint32> faces_nb_vertices_;
 	std::vector<uint32> faces_vertex_indices_;
+	// indices given to the faces (optional)
+	std::vector<uint32> faces_id_;
 
 	inline void reserve(uint32 nb_vertices, uint32 nb_faces)
 	{
@@ -0,0 +1,159 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/graph.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+
+#include <cgogn/io/graph/cg.h>
+#include <cgogn/io/graph/cgr.h>
+#include <cgogn/io/graph/skel.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+using Vec3 = geometry::Vec3;
+using Vertex = Graph::Vertex;
+using Edge = Graph::Edge;
+
+class GraphImportTest : public ::testing::Test
+{
+protected:
+
+	std::string filename_;
+
+	void SetUp() override
+	{
+		filename_ = (std::filesystem::temp_directory_path() / "cgogn_io_test_graph").string();
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(filename_);
+	}
+
+	void write(const std::string& content)
+	{
+		std::ofstream file(filename_, std::ios::binary);
+		file << content;
+	}
+
+	// the graph was not changed by a failed import
+	static void expect_unchanged(const Graph& g)
+	{
+		EXPECT_EQ(g.nb_darts(), 0u);
+		EXPECT_EQ(g.attribute_containers_[Vertex::ORBIT].nb_elements(), 0u);
+		EXPECT_EQ(g.attribute_containers_[Vertex::ORBIT].maximum_index(), 0u);
+		EXPECT_FALSE((get_attribute<Vec3, Vertex>(g, "position")));
+		EXPECT_FALSE((get_attribute<geometry::Scalar, Vertex>(g, "radius")));
+	}
+};
+
+TEST_F(GraphImportTest, cg)
+{
+	write("# D:3 NV:3 NE:2\nv 0 0 0\nv 1 0 0\nv 0 1 0\ne 0 1\ne 1 2\n");
+	Graph g;
+	ASSERT_TRUE(import_CG(g, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(g), 3u);
+	EXPECT_EQ(nb_cells<Edge>(g), 2u);
+
+	for (const char* content : {
+		"# D:3 NV:3 NE:2\nv 0 0 0\nv 1 x 0\nv 0 1 0\ne 0 1\ne 1 2\n", // malformed vertex
+		"# D:3 NV:3 NE:2\nv 0 0 0\nv 1 0 0\nv 0 1 0\ne 0 1\ne 1 3\n", // out of range vertex
+		"# D:3 NV:3 NE:2\nv 0 0 0\nv 1 0 0\nv 0 1 0\ne 0 1\ne 1\n" // truncated edge
+	})
+	{
+		write(content);
+		Graph h;
+		EXPECT_FALSE(import_CG(h, filename_)) << content;
+		expect_unchanged(h);
+		// a later import into the same graph does not collide with a leftover attribute
+		write("# D:3 NV:2 NE:1\nv 0 0 0\nv 1 0 0\ne 0 1\n");
+		EXPECT_TRUE(import_CG(h, filename_));
+		EXPECT_EQ(nb_cells<Vertex>(h), 2u);
+	}
+}
+
+TEST_F(GraphImportTest, cgr)
+{
+	write("# D:3 NV:3 NE:2\nv 0 0 0 1\nv 1 0 0 2\nv 0 1 0 3\ne 0 1\ne 1 2\n");
+	Graph g;
+	ASSERT_TRUE(import_CGR(g, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(g), 3u);
+	EXPECT_EQ(nb_cells<Edge>(g), 2u);
+	auto radius = get_attribute<geometry::Scalar, Vertex>(g, "radius");
+	ASSERT_TRUE(radius);
+	geometry::Scalar sum = 0;
+	foreach_cell(g, [&] (Vertex v) -> bool
+	{
+		sum += value<geometry::Scalar>(g, radius, v);
+		return true;
+	});
+	EXPECT_EQ(sum, geometry::Scalar(6));
+
+	for (const char* content : {
+		"# D:3 NV:3 NE:2\nv 0 0 0 1\nv 1 0 0\nv 0 1 0 3\ne 0 1\ne 1 2\n", // missing radius
+		"# D:3 NV:3 NE:2\nv 0 0 0 1\nv 1 0 0 2\nv 0 1 0 3\ne 0 1\ne 5 2\n" // out of range vertex
+	})
+	{
+		write(content);
+		Graph h;
+		EXPECT_FALSE(import_CGR(h, filename_)) << content;
+		expect_unchanged(h);
+	}
+}
+
+TEST_F(GraphImportTest, skel)
+{
+	write("skel\n3\n0 0 0 0 1 1 1\n1 1 0 0 2 2 0 2\n2 0 1 0 3 1 1\n");
+	Graph g;
+	ASSERT_TRUE(import_SKEL(g, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(g), 3u);
+	EXPECT_EQ(nb_cells<Edge>(g), 2u);
+
+	for (const char* content : {
+		"skel\n3\n0 0 0 0 1 1 1\n1 1 0 0 2 2 0 2\n", // missing vertex
+		"skel\n3\n0 0 0 0 1 1 1\n1 1 0 0 2 2 0 2\n3 0 1 0 3 1 1\n", // out of order vertex
+		"skel\n3\n0 0 0 0 1 1 1\n1 1 0 x 2 2 0 2\n2 0 1 0 3 1 1\n" // malformed number
+	})
+	{
+		write(content);
+		Graph h;
+		EXPECT_FALSE(import_SKEL(h, filename_)) << content;
+		expect_unchanged(h);
+	}
+}
+
+} // namespace io
+
+} // namespace cgogn
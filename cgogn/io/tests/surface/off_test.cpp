@@ -0,0 +1,340 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+#include <cgogn/core/utils/endian.h>
+
+#include <cgogn/io/surface/off.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+using Vec3 = geometry::Vec3;
+using Vertex = CMap2::Vertex;
+using Face = CMap2::Face;
+
+class OFFImportTest : public ::testing::Test
+{
+protected:
+
+	std::string filename_;
+
+	void SetUp() override
+	{
+		filename_ = (std::filesystem::temp_directory_path() / "cgogn_io_test_surface.off").string();
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(filename_);
+	}
+
+	void write(const std::string& content)
+	{
+		std::ofstream file(filename_, std::ios::binary);
+		file << content;
+	}
+
+	// the positions of the vertices of each face, the faces being sorted
+	static std::vector<std::vector<Vec3>> faces_positions(const CMap2& m)
+	{
+		auto position = get_attribute<Vec3, Vertex>(m, "position");
+		std::vector<std::vector<Vec3>> faces;
+		foreach_cell(m, [&] (Face f) -> bool
+		{
+			std::vector<Vec3>& face = faces.emplace_back();
+			foreach_incident_vertex(m, f, [&] (Vertex v) -> bool
+			{
+				face.push_back(value<Vec3>(m, position, v));
+				return true;
+			});
+			// start each face at its smallest position to compare the faces whatever their first dart
+			std::rotate(face.begin(), std::min_element(face.begin(), face.end(), less), face.end());
+			return true;
+		});
+		std::sort(faces.begin(), faces.end(), [] (const std::vector<Vec3>& a, const std::vector<Vec3>& b)
+		{
+			return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), less);
+		});
+		return faces;
+	}
+
+	static bool less(const Vec3& a, const Vec3& b)
+	{
+		return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+	}
+};
+
+// two triangles of the unit square
+static const std::vector<std::vector<Vec3>> square_faces = {
+	{ { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 } },
+	{ { 0, 1, 0 }, { 1, 0, 0 }, { 1, 1, 0 } }
+};
+
+TEST_F(OFFImportTest, extra_fields)
+{
+	// comments, colors of the vertices and of the faces, one record per line
+	write("OFF\n# comment\n4 2 0\n0 0 0 255 0 0\n1 0 0 0 255 0\n0 1 0 0 0 255\n1 1 0 1 1 1\n"
+		  "3 0 1 2 255 0 0\n3 2 1 3 0 255 0 # comment\n");
+	CMap2 m;
+	ASSERT_TRUE(import_OFF(m, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(m), 4u);
+	EXPECT_EQ(faces_positions(m), square_faces);
+}
+
+TEST_F(OFFImportTest, records_over_several_lines)
+{
+	// a face over two lines: the file is parsed token by token, the vertices normals are still skipped
+	write("OFF\n4 2 0\n0 0 0 0 0 1\n1 0 0 0 0 1\n0 1 0 0 0 1\n1 1 0 0 0 1\n3\n0 1 2\n3 2 1 3\n");
+	CMap2 m;
+	ASSERT_TRUE(import_OFF(m, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(m), 4u);
+	EXPECT_EQ(faces_positions(m), square_faces);
+}
+
+TEST_F(OFFImportTest, several_records_per_line)
+{
+	// the vertices and the faces given on one line each, as a pure token stream
+	write("OFF\n3 1 0\n0 0 0 1 0 0 0 1 0\n3 0 1 2\n");
+	CMap2 m;
+	ASSERT_TRUE(import_OFF(m, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(m), 3u);
+	EXPECT_EQ(faces_positions(m), (std::vector<std::vector<Vec3>>{ { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 } } }));
+
+	write("OFF\n4 2 0\n0 0 0 1 0 0\n0 1 0 1 1 0\n3 0 1 2 3 2 1 3\n");
+	CMap2 square;
+	ASSERT_TRUE(import_OFF(square, filename_));
+	EXPECT_EQ(faces_positions(square), square_faces);
+}
+
+TEST_F(OFFImportTest, invalid_files)
+{
+	for (const char* content : {
+		"OFF\n3 1 0\n0 0 0\n1 0 0\n0 1 0\n3 0 1 5\n", // out of range vertex
+		"OFF\n3 1 0\n0 0 0\n1 0 0\n0 1 0\n", // missing face
+		"OFF\n3 1 0\n0 0 0\n1 0 x\n0 1 0\n3 0 1 2\n", // malformed number
+		"3 1 0\n0 0 0\n1 0 0\n0 1 0\n3 0 1 2\n" // no header
+	})
+	{
+		write(content);
+		CMap2 m;
+		add_attribute<uint32, Vertex>(m, "vertex");
+		EXPECT_FALSE(import_OFF(m, filename_)) << content;
+		// the map is left unchanged
+		EXPECT_EQ(m.nb_darts(), 0u);
+		EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].nb_elements(), 0u);
+		EXPECT_FALSE((get_attribute<Vec3, Vertex>(m, "position")));
+	}
+	CMap2 m;
+	EXPECT_FALSE(import_OFF(m, filename_ + ".missing"));
+}
+
+TEST_F(OFFImportTest, chunks)
+{
+	// a grid large enough to be split in several chunks when there are workers
+	const uint32 n = 300u;
+	std::vector<Vec3> positions;
+	std::string content = "OFF\n" + std::to_string(n * n) + " " + std::to_string(2u * (n - 1u) * (n - 1u)) + " 0\n";
+	for (uint32 i = 0u; i < n * n; ++i)
+	{
+		positions.emplace_back(i % n, i / n, 0.25 * (i % 7u));
+		content += std::to_string(i % n) + " " + std::to_string(i / n) + " " + std::to_string(0.25 * (i % 7u)) + "\n";
+		if (i % 1000u == 0u)
+			content += "# comment\n\n";
+	}
+	std::vector<std::vector<Vec3>> expected;
+	auto add_triangle = [&] (uint32 a, uint32 b, uint32 c)
+	{
+		content += "3 " + std::to_string(a) + " " + std::to_string(b) + " " + std::to_string(c) + "\n";
+		std::vector<Vec3>& face = expected.emplace_back(std::vector<Vec3>{ positions[a], positions[b], positions[c] });
+		std::rotate(face.begin(), std::min_element(face.begin(), face.end(), less), face.end());
+	};
+	for (uint32 j = 0u; j + 1u < n; ++j)
+	{
+		for (uint32 i = 0u; i + 1u < n; ++i)
+		{
+			const uint32 v = j * n + i;
+			add_triangle(v, v + 1u, v + n + 1u);
+			add_triangle(v, v + n + 1u, v + n);
+		}
+	}
+	std::sort(expected.begin(), expected.end(), [] (const std::vector<Vec3>& a, const std::vector<Vec3>& b)
+	{
+		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), less);
+	});
+	write(content);
+
+	CMap2 m;
+	ASSERT_TRUE(import_OFF(m, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(m), n * n);
+	EXPECT_EQ(faces_positions(m), expected);
+}
+
+// the binary OFF format of off_ascii2bin (big endian numbers, float32 positions)
+class OFFBinaryTest : public OFFImportTest
+{
+protected:
+
+	std::string binary_;
+
+	void append(uint32 x)
+	{
+		x = swap_endianness_native_big(x);
+		binary_.append(reinterpret_cast<const char*>(&x), sizeof(x));
+	}
+
+	void append(float32 x)
+	{
+		x = swap_endianness_native_big(x);
+		binary_.append(reinterpret_cast<const char*>(&x), sizeof(x));
+	}
+
+	// the binary file of the faces of a map
+	void write_binary(CMap2& m)
+	{
+		auto position = get_attribute<Vec3, Vertex>(m, "position");
+		auto vertex_id = add_attribute<uint32, Vertex>(m, "__vertex_id");
+		binary_ = "OFF BINARY\n";
+		append(nb_cells<Vertex>(m));
+		append(nb_cells<Face>(m));
+		append(0u);
+		uint32 nb_vertices = 0u;
+		foreach_cell(m, [&] (Vertex v) -> bool
+		{
+			value<uint32>(m, vertex_id, v) = nb_vertices++;
+			const Vec3& p = value<Vec3>(m, position, v);
+			append(float32(p[0]));
+			append(float32(p[1]));
+			append(float32(p[2]));
+			return true;
+		});
+		foreach_cell(m, [&] (Face f) -> bool
+		{
+			append(codegree(m, f));
+			foreach_incident_vertex(m, f, [&] (Vertex v) -> bool
+			{
+				append(value<uint32>(m, vertex_id, v));
+				return true;
+			});
+			return true;
+		});
+		remove_attribute<Vertex>(m, vertex_id);
+		write(binary_);
+	}
+};
+
+TEST_F(OFFBinaryTest, round_trip)
+{
+	// triangles and quads with positions exactly represented in float32
+	const uint32 n = 40u;
+	std::string content = "OFF\n" + std::to_string(n * n) + " " + std::to_string((n - 1u) * (n - 1u)) + " 0\n";
+	for (uint32 i = 0u; i < n * n; ++i)
+		content += std::to_string(i % n) + " " + std::to_string(i / n) + " " + std::to_string(0.125 * (i % 5u)) + "\n";
+	for (uint32 j = 0u; j + 1u < n; ++j)
+	{
+		for (uint32 i = 0u; i + 1u < n; ++i)
+		{
+			const uint32 v = j * n + i;
+			content += "4 " + std::to_string(v) + " " + std::to_string(v + 1u) + " " + std::to_string(v + n + 1u) + " " +
+					   std::to_string(v + n) + "\n";
+		}
+	}
+	write(content);
+	CMap2 ascii;
+	ASSERT_TRUE(import_OFF(ascii, filename_));
+	Dart d = ascii.begin();
+	while (ascii.is_boundary(d))
+		d = ascii.next(d);
+	cut_face(ascii, Vertex(d), Vertex(ascii.phi1(ascii.phi1(d))));
+
+	write_binary(ascii);
+	CMap2 binary;
+	ASSERT_TRUE(import_OFF(binary, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(binary), n * n);
+	EXPECT_EQ(nb_cells<Face>(binary), (n - 1u) * (n - 1u) + 1u);
+	EXPECT_EQ(faces_positions(binary), faces_positions(ascii));
+}
+
+TEST_F(OFFBinaryTest, degenerate_faces)
+{
+	// the faces with less than 3 vertices are skipped
+	binary_ = "OFF BINARY\n";
+	for (uint32 x : { 3u, 3u, 0u })
+		append(x);
+	for (float32 x : { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f })
+		append(x);
+	for (uint32 x : { 0u, 2u, 0u, 1u, 3u, 0u, 1u, 2u })
+		append(x);
+	write(binary_);
+	CMap2 m;
+	ASSERT_TRUE(import_OFF(m, filename_));
+	EXPECT_EQ(nb_cells<Face>(m), 1u);
+	EXPECT_EQ(nb_cells<Vertex>(m), 3u);
+}
+
+TEST_F(OFFBinaryTest, invalid_files)
+{
+	write("OFF\n3 1 0\n0 0 0\n1 0 0\n0 1 0\n3 0 1 2\n");
+	CMap2 triangle;
+	ASSERT_TRUE(import_OFF(triangle, filename_));
+	write_binary(triangle);
+	const std::string valid = binary_;
+
+	// truncated positions or faces, out of range vertex
+	std::string out_of_range = valid;
+	const uint32 k = swap_endianness_native_big(7u);
+	std::memcpy(&out_of_range[out_of_range.size() - sizeof(uint32)], &k, sizeof(uint32));
+	for (const std::string& content : { valid.substr(0u, 20u), valid.substr(0u, valid.size() - 1u), out_of_range })
+	{
+		write(content);
+		CMap2 m;
+		add_attribute<uint32, Vertex>(m, "vertex");
+		EXPECT_FALSE(import_OFF(m, filename_));
+		// the map is left unchanged
+		EXPECT_EQ(m.nb_darts(), 0u);
+		EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].nb_elements(), 0u);
+		EXPECT_FALSE((get_attribute<Vec3, Vertex>(m, "position")));
+	}
+}
+
+} // namespace io
+
+} // namespace cgogn
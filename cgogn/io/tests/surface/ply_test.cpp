@@ -0,0 +1,253 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/face.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/vertex.h>
+
+#include <cgogn/io/surface/ply.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+using Vec3 = geometry::Vec3;
+using Scalar = geometry::Scalar;
+using Vertex = CMap2::Vertex;
+using Face = CMap2::Face;
+
+static bool less(const Vec3& a, const Vec3& b)
+{
+	return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+}
+
+class PLYTest : public ::testing::Test
+{
+protected:
+
+	CMap2 map_;
+	std::shared_ptr<CMap2::Attribute<Vec3>> position_, normal_, color_;
+	std::string filename_;
+
+	void SetUp() override
+	{
+		filename_ = (std::filesystem::temp_directory_path() / "cgogn_io_test_surface.ply").string();
+
+		// closed surfaces with faces of different degrees, random positions and normals and 8 bits colors
+		position_ = add_attribute<Vec3, Vertex>(map_, "position");
+		normal_ = add_attribute<Vec3, Vertex>(map_, "normal");
+		color_ = add_attribute<Vec3, Vertex>(map_, "color");
+		for (uint32 i = 0u; i < 50u; ++i)
+		{
+			CMap2::Volume v = add_prism(map_, 3u + i % 5u);
+			if (i % 3u == 0u && i % 5u != 0u) // (not the triangles)
+				cut_face(map_, Vertex(v.dart), Vertex(map_.phi1(map_.phi1(v.dart))));
+		}
+		std::mt19937 generator(1u);
+		std::uniform_real_distribution<Scalar> distribution(-10.0, 10.0);
+		foreach_cell(map_, [&] (Vertex v) -> bool
+		{
+			value<Vec3>(map_, position_, v) = Vec3(distribution(generator), distribution(generator), distribution(generator));
+			value<Vec3>(map_, normal_, v) = Vec3(distribution(generator), distribution(generator), distribution(generator));
+			value<Vec3>(map_, color_, v) = Vec3(generator() % 256u, generator() % 256u, generator() % 256u) / 255.0;
+			return true;
+		});
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(filename_);
+	}
+
+	// the positions of the vertices of each face, the faces being sorted
+	static std::vector<std::vector<Vec3>> faces_positions(const CMap2& m)
+	{
+		auto position = get_attribute<Vec3, Vertex>(m, "position");
+		std::vector<std::vector<Vec3>> faces;
+		foreach_cell(m, [&] (Face f) -> bool
+		{
+			std::vector<Vec3>& face = faces.emplace_back();
+			foreach_incident_vertex(m, f, [&] (Vertex v) -> bool
+			{
+				face.push_back(value<Vec3>(m, position, v));
+				return true;
+			});
+			std::rotate(face.begin(), std::min_element(face.begin(), face.end(), less), face.end());
+			return true;
+		});
+		std::sort(faces.begin(), faces.end(), [] (const std::vector<Vec3>& a, const std::vector<Vec3>& b)
+		{
+			return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), less);
+		});
+		return faces;
+	}
+
+	void check_round_trip(bool binary)
+	{
+		ASSERT_TRUE(export_PLY(map_, position_.get(), filename_, binary, normal_.get(), color_.get()));
+		CMap2 m;
+		ASSERT_TRUE(import_PLY(m, filename_));
+		EXPECT_EQ(nb_cells<Vertex>(m), nb_cells<Vertex>(map_));
+		EXPECT_EQ(nb_cells<Face>(m), nb_cells<Face>(map_));
+		EXPECT_EQ(faces_positions(m), faces_positions(map_));
+
+		// the normal and the color of the vertex at each (distinct) position
+		std::map<Vec3, std::pair<Vec3, Vec3>, bool (*)(const Vec3&, const Vec3&)> vertices(less);
+		foreach_cell(map_, [&] (Vertex v) -> bool
+		{
+			vertices[value<Vec3>(map_, position_, v)] = { value<Vec3>(map_, normal_, v), value<Vec3>(map_, color_, v) };
+			return true;
+		});
+		auto position = get_attribute<Vec3, Vertex>(m, "position");
+		auto normal = get_attribute<Vec3, Vertex>(m, "normal");
+		auto color = get_attribute<Vec3, Vertex>(m, "color");
+		ASSERT_TRUE(normal && color);
+		uint32 nb_errors = 0u;
+		foreach_cell(m, [&] (Vertex v) -> bool
+		{
+			auto it = vertices.find(value<Vec3>(m, position, v));
+			if (it == vertices.end() || value<Vec3>(m, normal, v) != it->second.first ||
+				(value<Vec3>(m, color, v) - it->second.second).norm() > 1e-6)
+				++nb_errors;
+			return true;
+		});
+		EXPECT_EQ(nb_errors, 0u);
+	}
+
+	void write(const std::string& content)
+	{
+		std::ofstream file(filename_, std::ios::binary);
+		file << content;
+	}
+};
+
+TEST_F(PLYTest, ascii_round_trip)
+{
+	check_round_trip(false);
+}
+
+TEST_F(PLYTest, binary_round_trip)
+{
+	check_round_trip(true);
+}
+
+TEST_F(PLYTest, other_properties)
+{
+	// a scalar vertex property, a vertex list, face properties around the indices and an ignored element
+	write("ply\nformat ascii 1.0\ncomment a square\n"
+		  "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+		  "property list uchar int tags\nproperty double quality\n"
+		  "element face 2\nproperty uchar flags\nproperty list uchar uint vertex_index\nproperty float weight\n"
+		  "element edge 1\nproperty int vertex1\nproperty int vertex2\nend_header\n"
+		  "0 0 0 0 0.5\n1 0 0 2 7 8 1.5\n0 1 0 1 3 2.5\n1 1 0 0 3.5\n"
+		  "1 3 0 1 2 0.25\n0 3 2 1 3 0.75\n0 1\n");
+	CMap2 m;
+	ASSERT_TRUE(import_PLY(m, filename_));
+	EXPECT_EQ(nb_cells<Vertex>(m), 4u);
+	EXPECT_EQ(nb_cells<Face>(m), 2u);
+	auto position = get_attribute<Vec3, Vertex>(m, "position");
+	auto quality = get_attribute<Scalar, Vertex>(m, "quality");
+	ASSERT_TRUE(quality);
+	uint32 nb_errors = 0u;
+	foreach_cell(m, [&] (Vertex v) -> bool
+	{
+		const Vec3& p = value<Vec3>(m, position, v);
+		if (value<Scalar>(m, quality, v) != 0.5 + p[0] + 2.0 * p[1])
+			++nb_errors;
+		return true;
+	});
+	EXPECT_EQ(nb_errors, 0u);
+}
+
+TEST_F(PLYTest, degenerate_faces)
+{
+	// the faces with less than 3 vertices are skipped
+	write("ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+		  "element face 3\nproperty list uchar int vertex_indices\nend_header\n0 0 0\n1 0 0\n0 1 0\n"
+		  "0\n2 0 1\n3 0 1 2\n");
+	CMap2 m;
+	ASSERT_TRUE(import_PLY(m, filename_));
+	EXPECT_EQ(nb_cells<Face>(m), 1u);
+	EXPECT_EQ(nb_cells<Vertex>(m), 3u);
+}
+
+TEST_F(PLYTest, invalid_files)
+{
+	for (const char* content : {
+		"ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+		"element face 1\nproperty list uchar int vertex_indices\nend_header\n0 0 0\n1 0 0\n0 1 0\n3 0 1 3\n",
+		"ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+		"element face 1\nproperty list uchar int vertex_indices\nend_header\n0 0 0\n1 0 0\n0 1 0\n3 0 1\n",
+		"ply\nformat binary_little_endian 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+		"end_header\n0123456789",
+		"ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\nend_header\n0 0\n",
+		"ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+		"property float nx\nproperty float ny\nproperty float nz\nproperty uchar red\nproperty uchar green\n"
+		"property uchar blue\nproperty double quality\nelement face 1\nproperty list uchar int vertex_indices\n"
+		"end_header\n0 0 0 0 0 1 255 0 0 1\n1 0 0 0 0 1 0 255 0 1\n0 1 0 0 0 1 0 0 255 1\n3 0 1 7\n"
+	})
+	{
+		write(content);
+		CMap2 m;
+		add_attribute<uint32, Vertex>(m, "vertex");
+		EXPECT_FALSE(import_PLY(m, filename_)) << content;
+		// the map is left unchanged
+		EXPECT_EQ(m.nb_darts(), 0u);
+		EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].nb_elements(), 0u);
+		for (const char* name : { "position", "normal", "color" })
+			EXPECT_FALSE((get_attribute<Vec3, Vertex>(m, name))) << name;
+		EXPECT_FALSE((get_attribute<Scalar, Vertex>(m, "quality")));
+	}
+
+	// a valid file in a map that already has a position attribute
+	write("ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+		  "property double quality\nelement face 1\nproperty list uchar int vertex_indices\nend_header\n"
+		  "0 0 0 1\n1 0 0 1\n0 1 0 1\n3 0 1 2\n");
+	CMap2 m;
+	add_attribute<Vec3, Vertex>(m, "position");
+	EXPECT_FALSE(import_PLY(m, filename_));
+	EXPECT_EQ(m.nb_darts(), 0u);
+	EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].nb_elements(), 0u);
+	EXPECT_FALSE((get_attribute<Scalar, Vertex>(m, "quality")));
+}
+
+} // namespace io
+
+} // namespace cgogn
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap2.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/mesh_info.h>
+
+#include <cgogn/io/surface/surface_import.h>
+
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+using Vertex = CMap2::Vertex;
+using Face = CMap2::Face;
+
+// imports a copy of the given faces (over the same new vertices) in the map
+static void import_faces(CMap2& m, uint32 nb_vertices, const std::vector<std::vector<uint32>>& faces)
+{
+	SurfaceImportData surface_data;
+	const uint32 first_vertex_index = new_indices<Vertex>(m, nb_vertices);
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+		surface_data.vertices_id_.push_back(first_vertex_index + i);
+	for (const std::vector<uint32>& face : faces)
+	{
+		surface_data.faces_nb_vertices_.push_back(uint32(face.size()));
+		for (uint32 i : face)
+			surface_data.faces_vertex_indices_.push_back(first_vertex_index + i);
+	}
+	import_surface_data(m, surface_data);
+}
+
+TEST(SurfaceImportTest, pure_simplicial)
+{
+	CMap2 m;
+	add_attribute<uint32, Vertex>(m, "vertex");
+	const std::vector<std::vector<uint32>> triangles = { { 0, 1, 2 }, { 2, 1, 3 } };
+	const std::vector<std::vector<uint32>> quad = { { 0, 1, 2, 3 } };
+
+	// the flag covers the faces already in the map
+	import_faces(m, 4u, triangles);
+	EXPECT_TRUE(m.is_pure_simplicial());
+	import_faces(m, 4u, triangles);
+	EXPECT_TRUE(m.is_pure_simplicial());
+	import_faces(m, 4u, quad);
+	EXPECT_FALSE(m.is_pure_simplicial());
+	import_faces(m, 4u, triangles);
+	EXPECT_FALSE(m.is_pure_simplicial());
+	EXPECT_EQ(nb_cells<Vertex>(m), 16u);
+}
+
+} // namespace io
+
+} // namespace cgogn
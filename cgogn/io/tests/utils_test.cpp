@@ -0,0 +1,255 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/io/utils.h>
+
+#include <cgogn/core/utils/thread.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+// the numbers written in various formats are read as strtod reads them: the short decimals take
+// the fast path (exact mantissa and power of ten) and the others the correctly rounded fallback
+TEST(TextTokenizerTest, read_double)
+{
+	std::mt19937_64 generator(1u);
+	std::string text;
+	std::vector<float64> expected;
+	char buffer[64];
+	for (uint32 i = 0u; i < 20000u; ++i)
+	{
+		switch (i % 5u)
+		{
+			case 0u: {
+				// any finite double with all its digits (beyond the fast path)
+				const uint64 bits = generator();
+				float64 x;
+				std::memcpy(&x, &bits, sizeof(x));
+				std::snprintf(buffer, sizeof(buffer), "%.17g", std::isfinite(x) ? x : 1.0);
+				break;
+			}
+			case 1u:
+				std::snprintf(buffer, sizeof(buffer), "%.6f", std::uniform_real_distribution<float64>(-100.0, 100.0)(generator));
+				break;
+			case 2u:
+				std::snprintf(buffer, sizeof(buffer), "%.17g", std::uniform_real_distribution<float64>(-1.0, 1.0)(generator));
+				break;
+			case 3u:
+				std::snprintf(buffer, sizeof(buffer), "%g", float64(generator() % 100000u));
+				break;
+			default:
+				std::snprintf(buffer, sizeof(buffer), "%.9e", std::uniform_real_distribution<float64>(-1e-5, 1e-5)(generator));
+				break;
+		}
+		expected.push_back(std::strtod(buffer, nullptr));
+		text += buffer;
+		text += i % 3u == 0u ? "\n" : " ";
+	}
+
+	TextTokenizer tok(text);
+	uint32 nb_errors = 0u;
+	for (float64 x : expected)
+	{
+		if (tok.read_double() != x)
+			++nb_errors;
+	}
+	EXPECT_EQ(nb_errors, 0u);
+	EXPECT_TRUE(tok.good());
+	EXPECT_TRUE(tok.at_end());
+}
+
+TEST(TextTokenizerTest, special_numbers)
+{
+	TextTokenizer tok("# comment 1 2 3\n 0.5 +3 -0 00012.50 1e400 -1e-400 "
+					  "0.000000000000000000000000123456789012345678901 123456789012345678901234567890 inf -NaN");
+	EXPECT_EQ(tok.read_double(), 0.5);
+	EXPECT_EQ(tok.read_double(), 3.0);
+	const float64 zero = tok.read_double();
+	EXPECT_EQ(zero, 0.0);
+	EXPECT_TRUE(std::signbit(zero));
+	EXPECT_EQ(tok.read_double(), 12.5);
+	EXPECT_EQ(tok.read_double(), std::numeric_limits<float64>::infinity());
+	EXPECT_EQ(tok.read_double(), 0.0);
+	EXPECT_EQ(tok.read_double(), std::strtod("1.23456789012345678901e-25", nullptr));
+	EXPECT_EQ(tok.read_double(), std::strtod("123456789012345678901234567890", nullptr));
+	EXPECT_EQ(tok.read_double(), std::numeric_limits<float64>::infinity());
+	EXPECT_TRUE(std::isnan(tok.read_double()));
+	EXPECT_TRUE(tok.good());
+	EXPECT_TRUE(tok.at_end());
+}
+
+TEST(TextTokenizerTest, read_uint)
+{
+	TextTokenizer tok("0 +12 4294967295 #comment 5\n 7");
+	EXPECT_EQ(tok.read_uint(), 0u);
+	EXPECT_EQ(tok.read_uint(), 12u);
+	EXPECT_EQ(tok.read_uint(), 4294967295u);
+	EXPECT_EQ(tok.read_uint(), 7u);
+	EXPECT_TRUE(tok.good());
+	EXPECT_TRUE(tok.at_end());
+}
+
+TEST(TextTokenizerTest, malformed_numbers)
+{
+	for (const char* text : { "1.5x", "abc", "1e", "-", "" })
+	{
+		TextTokenizer tok(text);
+		tok.read_double();
+		EXPECT_FALSE(tok.good()) << text;
+	}
+	for (const char* text : { "-3", "4294967296", "1.5", "12a", "" })
+	{
+		TextTokenizer tok(text);
+		tok.read_uint();
+		EXPECT_FALSE(tok.good()) << text;
+	}
+}
+
+TEST(TextTokenizerTest, lines)
+{
+	TextTokenizer tok("a b\r\n\nc # d\n  e");
+	EXPECT_EQ(tok.next_line(), "a b");
+	EXPECT_EQ(tok.next_line(), "");
+	EXPECT_EQ(tok.next_token(), "c");
+	tok.skip_line();
+	EXPECT_EQ(tok.next_line(), "  e");
+	EXPECT_TRUE(tok.at_end());
+	EXPECT_TRUE(tok.next_line().empty());
+}
+
+// a text of more than the minimum size of a chunk, whose line i holds the record i (if it is one), and the records positions
+static std::string records_text(std::vector<std::size_t>& records)
+{
+	std::string text;
+	uint32 r = 0u;
+	for (uint32 i = 0u; text.size() < 6u * 1024u * 1024u; ++i)
+	{
+		if (i % 97u == 0u)
+			text += "# comment 1 2\n";
+		else if (i % 89u == 0u)
+			text += " \t\n";
+		else
+		{
+			records.push_back(text.size());
+			text += std::to_string(r++) + " 0.5 -1e-3" + (i % 2u == 0u ? "\r\n" : "\n");
+		}
+	}
+	// last record without end of line
+	records.push_back(text.size());
+	text += std::to_string(r) + " 0.5 -1e-3";
+	return text;
+}
+
+TEST(TextChunksTest, split_text)
+{
+	std::vector<std::size_t> records;
+	const std::string text = records_text(records);
+	const char* begin = text.data();
+	const char* end = begin + text.size();
+
+	const TextChunks chunks = split_text(begin, end);
+	if (thread_pool()->nb_workers() > 0u)
+		EXPECT_GT(chunks.nb_chunks(), 1u);
+	else
+		EXPECT_EQ(chunks.nb_chunks(), 1u);
+	EXPECT_EQ(chunks.nb_records(), uint32(records.size()));
+	EXPECT_EQ(chunks.begins.front(), begin);
+	EXPECT_EQ(chunks.begins.back(), end);
+	EXPECT_EQ(chunks.first_records.front(), 0u);
+
+	// the chunks start at the beginning of a line, with the index of their first record
+	for (uint32 c = 1u; c < chunks.nb_chunks(); ++c)
+	{
+		const char* p = chunks.begins[c];
+		EXPECT_LE(chunks.begins[c - 1u], p);
+		EXPECT_EQ(*(p - 1), '\n');
+		const std::size_t offset = std::size_t(p - begin);
+		const uint32 first_record = uint32(std::lower_bound(records.begin(), records.end(), offset) - records.begin());
+		EXPECT_EQ(chunks.first_records[c], first_record);
+	}
+}
+
+TEST(TextChunksTest, parallel_foreach_record)
+{
+	std::vector<std::size_t> records;
+	const std::string text = records_text(records);
+	const TextChunks chunks = split_text(text.data(), text.data() + text.size());
+	const uint32 nb_records = chunks.nb_records();
+
+	// ranges of records around each chunk boundary, and all the records
+	std::vector<std::pair<uint32, uint32>> ranges = { { 0u, nb_records }, { nb_records - 1u, nb_records } };
+	for (uint32 c = 1u; c < chunks.nb_chunks(); ++c)
+		ranges.emplace_back(chunks.first_records[c] - 3u, chunks.first_records[c] + 3u);
+
+	for (const auto& [first, last] : ranges)
+	{
+		std::vector<uint32> visits(nb_records, 0u);
+		uint32 nb_errors = 0u;
+		std::mutex mutex;
+		const bool valid = parallel_foreach_record(chunks, first, last, [&] (uint32 c, uint32 r, TextTokenizer& line) -> bool
+		{
+			// the record is read in its chunk, on its line only
+			const uint32 value = line.read_uint();
+			const float64 x = line.read_double();
+			const float64 y = line.read_double();
+			const bool error = r < chunks.first_records[c] || r >= chunks.first_records[c + 1u] ||
+				value != r || x != 0.5 || y != -1e-3 || !line.good() || !line.at_end();
+			std::lock_guard<std::mutex> lock(mutex);
+			++visits[r];
+			if (error)
+				++nb_errors;
+			return true;
+		});
+		EXPECT_TRUE(valid);
+		EXPECT_EQ(nb_errors, 0u);
+		for (uint32 r = 0u; r < nb_records; ++r)
+			EXPECT_EQ(visits[r], r >= first && r < last ? 1u : 0u) << r;
+	}
+
+	// more records than the text holds or an invalid record
+	EXPECT_FALSE(parallel_foreach_record(chunks, 0u, nb_records + 1u, [] (uint32, uint32, TextTokenizer&) { return true; }));
+	EXPECT_FALSE(parallel_foreach_record(chunks, 0u, nb_records, [&] (uint32, uint32 r, TextTokenizer&)
+	{
+		return r != nb_records / 2u;
+	}));
+}
+
+} // namespace io
+
+} // namespace cgogn
@@ -0,0 +1,213 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap3.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/mesh_info.h>
+
+#include <cgogn/io/volume/meshb.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+using Vec3 = geometry::Vec3;
+using Scalar = geometry::Scalar;
+using Vertex = CMap3::Vertex;
+using Face = CMap3::Face;
+using Volume = CMap3::Volume;
+
+// an hexahedron [0,1]^3, two prisms on its side, a pyramid on its top and a tetrahedron on the top of a prism
+static const char* hybrid_mesh = R"(MeshVersionFormatted 2
+Dimension 3
+Vertices
+14
+0 0 0 1
+1 0 0 2
+1 1 0 3
+0 1 0 4
+0 0 1 5
+1 0 1 6
+1 1 1 7
+0 1 1 8
+2 0 0 9
+2 1 0 10
+2 0 1 11
+2 1 1 12
+0.5 0.5 1.5 13
+1.8 0.3 1.6 14
+Tetrahedra
+1
+6 11 12 14 40
+Pyramids
+1
+5 6 7 8 13 50
+Prisms
+2
+2 9 10 6 11 12 60
+2 10 3 6 12 7 61
+Hexahedra
+1
+1 4 3 2 5 8 7 6 80
+End
+)";
+
+class MESHBTest : public ::testing::Test
+{
+protected:
+
+	CMap3 map_;
+	std::string input_filename_;
+
+	void SetUp() override
+	{
+		input_filename_ = (std::filesystem::temp_directory_path() / "cgogn_io_test_hybrid.mesh").string();
+		std::ofstream file(input_filename_);
+		file << hybrid_mesh;
+		file.close();
+		ASSERT_TRUE(import_MESHB(map_, input_filename_));
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(input_filename_);
+	}
+
+	// the (codegree, ref) of the volumes and the (ref, position) of the vertices, sorted
+	static std::vector<std::pair<uint32, int32>> volumes(const CMap3& m)
+	{
+		auto ref = get_attribute<int32, Volume>(m, "ref");
+		std::vector<std::pair<uint32, int32>> r;
+		foreach_cell(m, [&] (Volume v) -> bool { r.emplace_back(codegree(m, v), value<int32>(m, ref, v)); return true; });
+		std::sort(r.begin(), r.end());
+		return r;
+	}
+
+	static std::vector<std::pair<int32, std::vector<Scalar>>> vertices(const CMap3& m)
+	{
+		auto ref = get_attribute<int32, Vertex>(m, "ref");
+		auto position = get_attribute<Vec3, Vertex>(m, "position");
+		std::vector<std::pair<int32, std::vector<Scalar>>> r;
+		foreach_cell(m, [&] (Vertex v) -> bool
+		{
+			const Vec3& p = value<Vec3>(m, position, v);
+			r.emplace_back(value<int32>(m, ref, v), std::vector<Scalar>{ p[0], p[1], p[2] });
+			return true;
+		});
+		std::sort(r.begin(), r.end());
+		return r;
+	}
+
+	void check_round_trip(const std::string& filename)
+	{
+		EXPECT_TRUE(export_MESHB(map_, get_attribute<Vec3, Vertex>(map_, "position").get(), filename,
+								 get_attribute<int32, Vertex>(map_, "ref").get(),
+								 get_attribute<int32, Volume>(map_, "ref").get()));
+		CMap3 m;
+		EXPECT_TRUE(import_MESHB(m, filename));
+		std::filesystem::remove(filename);
+
+		EXPECT_EQ(nb_cells<Vertex>(m), 14u);
+		EXPECT_EQ(nb_cells<Face>(m), 21u);
+		EXPECT_EQ(volumes(m), volumes(map_));
+		EXPECT_EQ(vertices(m), vertices(map_));
+	}
+};
+
+TEST_F(MESHBTest, import)
+{
+	EXPECT_EQ(nb_cells<Vertex>(map_), 14u);
+	EXPECT_EQ(nb_cells<Face>(map_), 21u);
+	EXPECT_EQ(volumes(map_),
+			  (std::vector<std::pair<uint32, int32>>{ { 4u, 40 }, { 5u, 50 }, { 5u, 60 }, { 5u, 61 }, { 6u, 80 } }));
+	// the refs of the vertices are their numbers in the file
+	const std::vector<std::pair<int32, std::vector<Scalar>>> v = vertices(map_);
+	ASSERT_EQ(v.size(), 14u);
+	EXPECT_EQ(v[12], (std::pair<int32, std::vector<Scalar>>{ 13, { Scalar(0.5), Scalar(0.5), Scalar(1.5) } }));
+	EXPECT_EQ(v[13], (std::pair<int32, std::vector<Scalar>>{ 14, { Scalar(1.8), Scalar(0.3), Scalar(1.6) } }));
+}
+
+TEST_F(MESHBTest, ascii_round_trip)
+{
+	check_round_trip((std::filesystem::temp_directory_path() / "cgogn_io_test_volumes.mesh").string());
+}
+
+TEST_F(MESHBTest, binary_round_trip)
+{
+	check_round_trip((std::filesystem::temp_directory_path() / "cgogn_io_test_volumes.meshb").string());
+}
+
+TEST_F(MESHBTest, invalid_files)
+{
+	const std::string filename = (std::filesystem::temp_directory_path() / "cgogn_io_test_invalid.meshb").string();
+	CMap3 m;
+
+	// a vertex index out of range
+	std::string mesh = hybrid_mesh;
+	mesh.replace(mesh.find("6 11 12 14 40"), 13u, "6 11 12 15 40");
+	{
+		std::ofstream file(input_filename_);
+		file << mesh;
+	}
+	EXPECT_FALSE(import_MESHB(m, input_filename_));
+
+	// truncated binary files: in the block of a keyword followed by another one and in the block of the last keyword
+	ASSERT_TRUE(export_MESHB(map_, get_attribute<Vec3, Vertex>(map_, "position").get(), filename));
+	std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 20u);
+	EXPECT_FALSE(import_MESHB(m, filename));
+	{
+		// version 2 (int32 positions and integers), no End keyword after the 4 announced vertices of which 2 are given
+		std::ofstream file(filename, std::ios::binary);
+		const std::vector<int32> header = { 1, 2, 3, 20, 3, 4, 0, 4 };
+		file.write(reinterpret_cast<const char*>(header.data()), header.size() * sizeof(int32));
+		const float64 p[3] = { 0.0, 0.0, 0.0 };
+		const int32 ref = 0;
+		for (uint32 i = 0u; i < 2u; ++i)
+		{
+			file.write(reinterpret_cast<const char*>(p), sizeof(p));
+			file.write(reinterpret_cast<const char*>(&ref), sizeof(ref));
+		}
+	}
+	MeshbData data;
+	EXPECT_FALSE(read_MESHB(filename, data));
+	EXPECT_FALSE(import_MESHB(m, filename));
+
+	EXPECT_EQ(nb_cells<Vertex>(m), 0u);
+	EXPECT_EQ(nb_cells<Volume>(m), 0u);
+	std::filesystem::remove(filename);
+}
+
+} // namespace io
+
+} // namespace cgogn
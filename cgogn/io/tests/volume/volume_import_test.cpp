@@ -0,0 +1,271 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cgogn/core/types/cmap/cmap3.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/mesh_ops/volume.h>
+
+#include <cgogn/io/volume/volume_import.h>
+#include <cgogn/io/volume/tet.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+using Vec3 = geometry::Vec3;
+using Vertex = CMap3::Vertex;
+using Face = CMap3::Face;
+using Volume = CMap3::Volume;
+
+// an hexahedron [0,1]^3, a triangular prism lying on its top face and a separate tetrahedron
+static const std::vector<Vec3> positions = {
+	{ 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+	{ 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 },
+	{ 0.5, 0, 2 }, { 0.5, 1, 2 },
+	{ 3, 0, 0 }, { 4, 0, 0 }, { 3, 1, 0 }, { 3, 0, 1 }
+};
+// the prism and the tetrahedron are given in the opposite orientation of the hexahedron
+static const std::vector<std::vector<uint32>> volumes = {
+	{ 4, 8, 5, 7, 9, 6 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7 },
+	{ 10, 12, 11, 13 }
+};
+
+static std::vector<uint32> sorted_vertices(const CMap3& m, Volume v)
+{
+	std::vector<uint32> vertices;
+	foreach_incident_vertex(m, v, [&] (Vertex iv) -> bool { vertices.push_back(index_of(m, iv)); return true; });
+	std::sort(vertices.begin(), vertices.end());
+	return vertices;
+}
+
+static void check_volumes(const CMap3& m, uint32 first_vertex_index)
+{
+	EXPECT_EQ(nb_cells<Vertex>(m), 14u);
+	EXPECT_EQ(nb_cells<Volume>(m), 3u);
+
+	// only the quad shared by the hexahedron and the prism is incident to two volumes
+	uint32 nb_faces = 0u;
+	uint32 nb_inner_faces = 0u;
+	foreach_cell(m, [&] (Face f) -> bool
+	{
+		++nb_faces;
+		if (degree(m, f) == 2u)
+			++nb_inner_faces;
+		return true;
+	});
+	EXPECT_EQ(nb_faces, 14u);
+	EXPECT_EQ(nb_inner_faces, 1u);
+
+	std::vector<std::vector<uint32>> expected;
+	for (const std::vector<uint32>& vertices : volumes)
+	{
+		std::vector<uint32> vol;
+		for (uint32 i : vertices)
+			vol.push_back(first_vertex_index + i);
+		std::sort(vol.begin(), vol.end());
+		expected.push_back(vol);
+	}
+	std::vector<std::vector<uint32>> imported;
+	foreach_cell(m, [&] (Volume v) -> bool { imported.push_back(sorted_vertices(m, v)); return true; });
+	std::sort(expected.begin(), expected.end());
+	std::sort(imported.begin(), imported.end());
+	EXPECT_EQ(imported, expected);
+}
+
+TEST(VolumeImportTest, prism_and_hexa)
+{
+	CMap3 m;
+	auto position = add_attribute<Vec3, Vertex>(m, "position");
+	add_attribute<uint32, Volume>(m, "volume");
+
+	VolumeImportData volume_data;
+	const uint32 first_vertex_index = new_indices<Vertex>(m, uint32(positions.size()));
+	for (uint32 i = 0u; i < uint32(positions.size()); ++i)
+	{
+		(*position)[first_vertex_index + i] = positions[i];
+		volume_data.vertices_id_.push_back(first_vertex_index + i);
+	}
+	for (const std::vector<uint32>& vertices : volumes)
+	{
+		std::array<uint32, 8> ids;
+		for (uint32 j = 0u; j < uint32(vertices.size()); ++j)
+			ids[j] = first_vertex_index + vertices[j];
+		EXPECT_TRUE(append_volume(volume_data, ids, uint32(vertices.size()), *position));
+	}
+	std::array<uint32, 8> ids{};
+	EXPECT_FALSE(append_volume(volume_data, ids, 7u, *position));
+	ASSERT_EQ(volume_data.volumes_types_.size(), 3u);
+	EXPECT_EQ(volume_data.volumes_types_[0], VolumeType::TriangularPrism);
+	EXPECT_EQ(volume_data.volumes_types_[1], VolumeType::Hexa);
+	EXPECT_EQ(volume_data.volumes_types_[2], VolumeType::Tetra);
+
+	const uint32 first_volume_index = new_indices<Volume>(m, 3u);
+	for (uint32 i = 0u; i < 3u; ++i)
+		volume_data.volumes_id_.push_back(first_volume_index + 2u - i);
+
+	import_volume_data(m, volume_data);
+	check_volumes(m, first_vertex_index);
+
+	// the volumes got the given indices
+	std::vector<bool> found(3u, false);
+	foreach_cell(m, [&] (Volume v) -> bool
+	{
+		const uint32 i = first_volume_index + 2u - index_of(m, v);
+		EXPECT_LT(i, 3u);
+		if (i < 3u)
+		{
+			found[i] = true;
+			EXPECT_EQ(sorted_vertices(m, v).size(), volumes[i].size());
+		}
+		return true;
+	});
+	EXPECT_EQ(found, std::vector<bool>(3u, true));
+}
+
+TEST(VolumeImportTest, pure_simplicial)
+{
+	CMap3 m;
+	auto position = add_attribute<Vec3, Vertex>(m, "position");
+
+	// imports a copy of the given volume in the map
+	auto import_volume = [&] (const std::vector<uint32>& vertices)
+	{
+		VolumeImportData volume_data;
+		std::array<uint32, 8> ids;
+		const uint32 first_vertex_index = new_indices<Vertex>(m, uint32(vertices.size()));
+		for (uint32 j = 0u; j < uint32(vertices.size()); ++j)
+		{
+			ids[j] = first_vertex_index + j;
+			(*position)[ids[j]] = positions[vertices[j]];
+			volume_data.vertices_id_.push_back(ids[j]);
+		}
+		EXPECT_TRUE(append_volume(volume_data, ids, uint32(vertices.size()), *position));
+		import_volume_data(m, volume_data);
+	};
+
+	// the flag covers the volumes already in the map
+	import_volume(volumes[2]);
+	EXPECT_TRUE(m.is_pure_simplicial());
+	import_volume(volumes[2]);
+	EXPECT_TRUE(m.is_pure_simplicial());
+	import_volume(volumes[1]);
+	EXPECT_FALSE(m.is_pure_simplicial());
+	import_volume(volumes[2]);
+	EXPECT_FALSE(m.is_pure_simplicial());
+	EXPECT_EQ(nb_cells<Volume>(m), 4u);
+}
+
+static bool same_vertex(const CMap3& m, Dart d, Dart e)
+{
+	bool same = false;
+	static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Vertex(d), [&] (Dart vd) -> bool
+	{
+		same = vd == e;
+		return !same;
+	});
+	return same;
+}
+
+TEST(VolumeImportTest, volume_vertices_darts)
+{
+	CMap3 m;
+	CMap3::Volume hexa = add_prism(static_cast<CMap2&>(m), 4u, false);
+
+	std::array<Dart, 8> vertices_darts;
+	ASSERT_EQ(volume_vertices_darts(m, hexa.dart, VolumeType::Hexa, vertices_darts), 8u);
+
+	// the 4 first vertices are the ones of the base and the 4 last ones are above them, in the same order
+	for (uint32 i = 0u; i < 8u; ++i)
+		for (uint32 j = i + 1u; j < 8u; ++j)
+			EXPECT_FALSE(same_vertex(m, vertices_darts[i], vertices_darts[j]));
+	for (uint32 i = 0u; i < 4u; ++i)
+	{
+		EXPECT_EQ(m.phi1(vertices_darts[i]), vertices_darts[(i + 1u) % 4u]);
+		bool linked = false;
+		static_cast<const CMap2&>(m).foreach_dart_of_orbit(CMap2::Vertex(vertices_darts[i]), [&] (Dart d) -> bool
+		{
+			linked = same_vertex(m, m.phi1(d), vertices_darts[4u + i]);
+			return !linked;
+		});
+		EXPECT_TRUE(linked);
+	}
+}
+
+TEST(VolumeImportTest, import_TET)
+{
+	const std::string filename = (std::filesystem::temp_directory_path() / "cgogn_io_test_volumes.tet").string();
+	{
+		std::ofstream file(filename);
+		file << positions.size() << " vertices\n" << volumes.size() << " volumes\n";
+		for (const Vec3& p : positions)
+			file << p[0] << " " << p[1] << " " << p[2] << "\n";
+		for (const std::vector<uint32>& vertices : volumes)
+		{
+			file << vertices.size();
+			for (uint32 i : vertices)
+				file << " " << i;
+			file << "\n";
+		}
+	}
+
+	CMap3 m;
+	add_attribute<uint32, Volume>(m, "volume");
+	EXPECT_TRUE(import_TET(m, filename));
+	check_volumes(m, 0u);
+	std::filesystem::remove(filename);
+}
+
+TEST(VolumeImportTest, import_TET_invalid)
+{
+	const std::string filename = (std::filesystem::temp_directory_path() / "cgogn_io_test_invalid.tet").string();
+	{
+		std::ofstream file(filename);
+		file << "4 vertices\n1 volumes\n0 0 0\n1 0 0\n0 1 0\n0 0 1\n4 0 1 2 4\n";
+	}
+
+	CMap3 m;
+	add_attribute<uint32, Vertex>(m, "vertex");
+	EXPECT_FALSE(import_TET(m, filename));
+	// the map is left unchanged
+	EXPECT_EQ(m.nb_darts(), 0u);
+	EXPECT_EQ(m.attribute_containers_[Vertex::ORBIT].nb_elements(), 0u);
+	EXPECT_FALSE((get_attribute<Vec3, Vertex>(m, "position")));
+	std::filesystem::remove(filename);
+}
+
+} // namespace io
+
+} // namespace cgogn
@@ -0,0 +1,164 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cgogn/io/utils.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cgogn
+{
+
+namespace io
+{
+
+MappedFile::MappedFile(const std::string& filename) : data_(nullptr), size_(0u), open_(false), mapped_(false)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		{
+			// the view keeps the mapping alive after the handles are closed
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping)
+			{
+				const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				if (view)
+				{
+					data_ = static_cast<const char*>(view);
+					size_ = std::size_t(size.QuadPart);
+					open_ = mapped_ = true;
+				}
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+	}
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		struct stat st;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+		{
+			void* addr = mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr != MAP_FAILED)
+			{
+				madvise(addr, std::size_t(st.st_size), MADV_SEQUENTIAL);
+				data_ = static_cast<const char*>(addr);
+				size_ = std::size_t(st.st_size);
+				open_ = mapped_ = true;
+			}
+		}
+		::close(fd);
+	}
+#endif
+
+	if (!open_)
+	{
+		// empty files and files that cannot be mapped are read in a buffer
+		std::ifstream fp(filename, std::ios::in | std::ios::binary);
+		if (fp.good())
+		{
+			buffer_.assign(std::istreambuf_iterator<char>(fp), std::istreambuf_iterator<char>());
+			data_ = buffer_.data();
+			size_ = buffer_.size();
+			open_ = true;
+		}
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	if (mapped_)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(data_);
+#else
+		munmap(const_cast<char*>(data_), size_);
+#endif
+	}
+}
+
+TextChunks split_text(const char* begin, const char* end)
+{
+	// chunks of at least 1MB, a few per worker to balance the load
+	const std::size_t min_chunk_size = 1024u * 1024u;
+	const std::size_t size = std::size_t(end - begin);
+	const uint32 nb_workers = thread_pool()->nb_workers();
+	const uint32 nb_chunks = nb_workers == 0u ? 1u : uint32(std::max<std::size_t>(1u, std::min<std::size_t>(size / min_chunk_size, 4u * nb_workers)));
+
+	TextChunks chunks;
+	chunks.begins.resize(nb_chunks + 1u);
+	chunks.first_records.resize(nb_chunks + 1u, 0u);
+	chunks.begins[0] = begin;
+	for (uint32 c = 1u; c < nb_chunks; ++c)
+	{
+		const char* p = std::max(chunks.begins[c - 1u], begin + size / nb_chunks * c);
+		while (p != end && p != begin && *(p - 1) != '\n')
+			++p;
+		chunks.begins[c] = p;
+	}
+	chunks.begins[nb_chunks] = end;
+
+	thread_pool()->parallel_for(0u, nb_chunks, [&] (uint32 first_chunk, uint32 last_chunk)
+	{
+		for (uint32 c = first_chunk; c < last_chunk; ++c)
+		{
+			uint32 nb_records = 0u;
+			TextTokenizer tok(chunks.begins[c], chunks.begins[c + 1u]);
+			while (!tok.at_end())
+			{
+				tok.next_line();
+				++nb_records;
+			}
+			chunks.first_records[c + 1u] = nb_records;
+		}
+	}, 1u);
+	for (uint32 c = 0u; c < nb_chunks; ++c)
+		chunks.first_records[c + 1u] += chunks.first_records[c];
+
+	return chunks;
+}
+
+} // namespace io
+
+} // namespace cgogn
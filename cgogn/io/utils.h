@@ -24,10 +24,20 @@
 #ifndef CGOGN_IO_UTILS_H_
 #define CGOGN_IO_UTILS_H_
 
+#include <cgogn/io/cgogn_io_export.h>
+
 #include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread_pool.h>
 
+#include <atomic>
 #include <iostream>
 #include <clocale>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace cgogn
 {
@@ -105,6 +115,359 @@ inline uint32 read_uint(std::istream& fp, std::string& line)
 	return uint32((std::stoul(line)));
 }
 
+/**
+ * @brief read only view of the content of a file, memory mapped when possible (read in a buffer otherwise)
+ */
+class CGOGN_IO_EXPORT MappedFile
+{
+public:
+
+	MappedFile(const std::string& filename);
+	~MappedFile();
+	CGOGN_NOT_COPYABLE_NOR_MOVABLE(MappedFile);
+
+	inline bool is_open() const { return open_; }
+	inline const char* begin() const { return data_; }
+	inline const char* end() const { return data_ + size_; }
+	inline std::size_t size() const { return size_; }
+
+private:
+
+	const char* data_;
+	std::size_t size_;
+	bool open_;
+	bool mapped_;
+	std::vector<char> buffer_;
+};
+
+/**
+ * @brief parses in place the tokens of a range of characters (e.g. a MappedFile):
+ * the tokens are separated by blanks and a '#' at the beginning of a token starts a comment until the end of the line.
+ * The numbers are read without locale nor copy of the tokens.
+ * A read that fails (missing or malformed number) puts the tokenizer in a failed state (see good).
+ */
+class TextTokenizer
+{
+public:
+
+	inline TextTokenizer(const char* begin, const char* end) : cur_(begin), end_(end), good_(true)
+	{}
+
+	inline TextTokenizer(std::string_view str) : TextTokenizer(str.data(), str.data() + str.size())
+	{}
+
+	inline bool good() const { return good_; }
+	inline void fail() { good_ = false; }
+	inline const char* position() const { return cur_; }
+
+	inline bool at_end()
+	{
+		skip_blanks();
+		return cur_ == end_;
+	}
+
+	inline void skip_blanks()
+	{
+		while (cur_ != end_)
+		{
+			if (*cur_ == '#')
+				skip_line();
+			else if (is_blank(*cur_))
+				++cur_;
+			else
+				return;
+		}
+	}
+
+	// skips the rest of the current line, including its end of line
+	inline void skip_line()
+	{
+		while (cur_ != end_ && *cur_ != '\n')
+			++cur_;
+		if (cur_ != end_)
+			++cur_;
+	}
+
+	// returns the rest of the current line (without its end of line) and goes to the next one
+	inline std::string_view next_line()
+	{
+		const char* begin = cur_;
+		while (cur_ != end_ && *cur_ != '\n')
+			++cur_;
+		const char* end = cur_;
+		if (cur_ != end_)
+			++cur_;
+		if (end != begin && *(end - 1) == '\r')
+			--end;
+		return std::string_view(begin, std::size_t(end - begin));
+	}
+
+	inline std::string_view next_token()
+	{
+		skip_blanks();
+		const char* begin = cur_;
+		while (cur_ != end_ && !is_blank(*cur_))
+			++cur_;
+		if (cur_ == begin)
+			good_ = false;
+		return std::string_view(begin, std::size_t(cur_ - begin));
+	}
+
+	inline uint32 read_uint()
+	{
+		skip_blanks();
+		const char* p = cur_;
+		if (p != end_ && *p == '+')
+			++p;
+		const char* digits = p;
+		uint64 value = 0u;
+		for (; p != end_ && is_digit(*p); ++p)
+		{
+			value = value * 10u + uint64(*p - '0');
+			if (value > std::numeric_limits<uint32>::max())
+				break;
+		}
+		if (p == digits || value > std::numeric_limits<uint32>::max() || !is_delimiter(p))
+		{
+			good_ = false;
+			return 0u;
+		}
+		cur_ = p;
+		return uint32(value);
+	}
+
+	inline float64 read_double()
+	{
+		skip_blanks();
+		const char* begin = cur_;
+		const char* p = cur_;
+		bool negative = false;
+		if (p != end_ && (*p == '-' || *p == '+'))
+		{
+			negative = *p == '-';
+			++p;
+		}
+		const char* number = p;
+
+		// decimal mantissa (up to 19 significant digits) and exponent
+		uint64 mantissa = 0u;
+		int32 exponent = 0;
+		uint32 nb_digits = 0u;
+		bool has_digits = false;
+		bool truncated = false;
+		for (; p != end_ && is_digit(*p); ++p)
+		{
+			has_digits = true;
+			if (nb_digits < 19u)
+			{
+				mantissa = mantissa * 10u + uint64(*p - '0');
+				if (mantissa != 0u)
+					++nb_digits;
+			}
+			else
+			{
+				++exponent;
+				truncated |= *p != '0';
+			}
+		}
+		if (p != end_ && *p == '.')
+		{
+			++p;
+			for (; p != end_ && is_digit(*p); ++p)
+			{
+				has_digits = true;
+				if (nb_digits < 19u)
+				{
+					mantissa = mantissa * 10u + uint64(*p - '0');
+					--exponent;
+					if (mantissa != 0u)
+						++nb_digits;
+				}
+				else
+					truncated |= *p != '0';
+			}
+		}
+		if (!has_digits)
+			return read_special(begin);
+		if (p != end_ && (*p == 'e' || *p == 'E'))
+		{
+			++p;
+			bool negative_exponent = false;
+			if (p != end_ && (*p == '-' || *p == '+'))
+			{
+				negative_exponent = *p == '-';
+				++p;
+			}
+			if (p == end_ || !is_digit(*p))
+			{
+				good_ = false;
+				return 0.0;
+			}
+			int32 e = 0;
+			for (; p != end_ && is_digit(*p); ++p)
+			{
+				if (e < 100000)
+					e = e * 10 + int32(*p - '0');
+			}
+			exponent += negative_exponent ? -e : e;
+		}
+		if (!is_delimiter(p))
+		{
+			good_ = false;
+			return 0.0;
+		}
+		cur_ = p;
+
+		float64 value;
+		// exact when the mantissa and the power of ten are exactly represented (Clinger's fast path)
+		if (!truncated && mantissa <= (uint64(1u) << 53) && exponent >= -22 && exponent <= 22)
+			value = exponent < 0 ? float64(mantissa) / pow10(-exponent) : float64(mantissa) * pow10(exponent);
+		else
+			value = read_slow(number, p, mantissa, exponent);
+		return negative ? -value : value;
+	}
+
+private:
+
+	static inline bool is_blank(char c)
+	{
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+	}
+
+	static inline bool is_digit(char c)
+	{
+		return uint32(c - '0') < 10u;
+	}
+
+	inline bool is_delimiter(const char* p) const
+	{
+		return p == end_ || is_blank(*p) || *p == '#';
+	}
+
+	static inline float64 pow10(int32 e)
+	{
+		static const float64 powers[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		return powers[e];
+	}
+
+	// absolute value of the number in [begin, end[ (without sign) when the fast path cannot be used
+	inline float64 read_slow(const char* begin, const char* end, uint64 mantissa, int32 exponent)
+	{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		unused_parameters(mantissa);
+		float64 value = 0.0;
+		auto [ptr, ec] = std::from_chars(begin, end, value);
+		if (ec == std::errc::result_out_of_range)
+			value = exponent > 0 ? std::numeric_limits<float64>::infinity() : 0.0;
+		else if (ec != std::errc() || ptr != end)
+			good_ = false;
+		return value;
+#else
+		// correctly rounded in most cases only
+		unused_parameters(begin, end);
+		return float64(static_cast<long double>(mantissa) * std::pow(10.0L, exponent));
+#endif
+	}
+
+	// inf and nan
+	inline float64 read_special(const char* begin)
+	{
+		const char* p = begin;
+		bool negative = false;
+		if (p != end_ && (*p == '-' || *p == '+'))
+		{
+			negative = *p == '-';
+			++p;
+		}
+		const char* word = p;
+		while (p != end_ && !is_blank(*p))
+			++p;
+		const std::string_view w(word, std::size_t(p - word));
+		auto equals = [&] (const char* s) -> bool
+		{
+			const std::string_view v(s);
+			if (v.size() != w.size())
+				return false;
+			for (std::size_t i = 0u; i < v.size(); ++i)
+			{
+				if ((w[i] | 0x20) != v[i])
+					return false;
+			}
+			return true;
+		};
+		float64 value;
+		if (equals("inf") || equals("infinity"))
+			value = std::numeric_limits<float64>::infinity();
+		else if (equals("nan"))
+			value = std::numeric_limits<float64>::quiet_NaN();
+		else
+		{
+			good_ = false;
+			return 0.0;
+		}
+		cur_ = p;
+		return negative ? -value : value;
+	}
+
+	const char* cur_;
+	const char* end_;
+	bool good_;
+};
+
+/**
+ * @brief line aligned chunks of a range of characters, with the index of the first record of each chunk.
+ * A record is a line that contains a token (i.e. that is neither blank nor a comment).
+ */
+struct TextChunks
+{
+	std::vector<const char*> begins; // nb_chunks + 1 (the last one is the end of the range)
+	std::vector<uint32> first_records; // nb_chunks + 1 (the last one is the number of records)
+
+	inline uint32 nb_chunks() const { return uint32(begins.size()) - 1u; }
+	inline uint32 nb_records() const { return first_records.back(); }
+};
+
+/**
+ * @brief splits [begin, end[ in line aligned chunks to be parsed in parallel (a single chunk if the range is small
+ * or if there is no worker in the thread pool) and counts their records in parallel
+ */
+TextChunks CGOGN_IO_EXPORT split_text(const char* begin, const char* end);
+
+/**
+ * @brief calls f(chunk, record, line) on the records [first, last[ of the chunks, the chunks being processed in parallel
+ * @param f the function called on each record, with a tokenizer on its line, that returns false if the record is invalid
+ * @return false if there are less than last records or if f failed on a record
+ */
+template <typename FUNC>
+bool parallel_foreach_record(const TextChunks& chunks, uint32 first, uint32 last, const FUNC& f)
+{
+	if (chunks.nb_records() < last)
+		return false;
+
+	std::atomic<bool> valid(true);
+	thread_pool()->parallel_for(0u, chunks.nb_chunks(), [&] (uint32 first_chunk, uint32 last_chunk)
+	{
+		for (uint32 c = first_chunk; c < last_chunk; ++c)
+		{
+			uint32 r = chunks.first_records[c];
+			if (r >= last || chunks.first_records[c + 1u] <= first)
+				continue;
+			TextTokenizer tok(chunks.begins[c], chunks.begins[c + 1u]);
+			while (r < last && !tok.at_end() && valid.load(std::memory_order_relaxed))
+			{
+				TextTokenizer line(tok.next_line());
+				if (r >= first && !f(c, r, line))
+					valid.store(false, std::memory_order_relaxed);
+				++r;
+			}
+		}
+	}, 1u);
+	return valid.load();
+}
+
 } // namespace io
 
 } // namespace cgogn
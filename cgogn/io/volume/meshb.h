@@ -0,0 +1,250 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* Copyright (C) 2015, IGG Group, ICube, University of Strasbourg, France       *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef CGOGN_IO_VOLUME_MESHB_H_
+#define CGOGN_IO_VOLUME_MESHB_H_
+
+#include <cgogn/io/meshb_data.h>
+#include <cgogn/io/volume/volume_import.h>
+
+#include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/types/mesh_traits.h>
+#include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/mesh_info.h>
+#include <cgogn/core/functions/traversals/global.h>
+#include <cgogn/core/functions/traversals/face.h>
+
+#include <cgogn/geometry/types/vector_traits.h>
+
+#include <array>
+#include <string>
+
+namespace cgogn
+{
+
+namespace io
+{
+
+/**
+ * @brief imports the tetrahedra, pyramids, prisms and hexahedra of a Gamma mesh file (.mesh ASCII or .meshb binary),
+ * with the references of the vertices and of the volumes in int32 "ref" attributes
+ * (the boundary triangles and quadrilaterals of the file and their references are not kept)
+ */
+template <typename MESH,
+		  typename std::enable_if<mesh_traits<MESH>::dimension == 3>::type* = nullptr>
+bool import_MESHB(MESH& m, const std::string& filename)
+{
+	using Vertex = typename MESH::Vertex;
+	using Volume = typename MESH::Volume;
+	using Vec3 = geometry::Vec3;
+	using Scalar = geometry::Scalar;
+
+	MeshbData meshb;
+	if (!read_MESHB(filename, meshb))
+	{
+		std::cerr << "File \"" << filename << "\" could not be read." << std::endl;
+		return false;
+	}
+	const uint32 nb_vertices = meshb.nb_vertices();
+	if (nb_vertices == 0u)
+	{
+		std::cerr << "File \"" << filename << "\" has no vertices." << std::endl;
+		return false;
+	}
+
+	const std::array<MeshbElementType, 4> volume_types = { MESHB_TETRA, MESHB_PYRAMID, MESHB_PRISM, MESHB_HEXA };
+	uint32 nb_volumes = 0u;
+	for (MeshbElementType t : volume_types)
+		nb_volumes += meshb.elements_[t].size();
+	if (nb_volumes == 0u)
+	{
+		std::cerr << "File \"" << filename << "\" has no volumes." << std::endl;
+		return false;
+	}
+
+	VolumeImportData volume_data;
+	volume_data.reserve(nb_vertices, nb_volumes);
+
+	auto position = add_attribute<Vec3, Vertex>(m, "position");
+	auto vertex_ref = add_attribute<int32, Vertex>(m, "ref");
+	auto volume_ref = add_attribute<int32, Volume>(m, "ref");
+
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	for (uint32 i = 0u; i < nb_vertices; ++i)
+	{
+		const uint32 vertex_id = first_vertex_id + i;
+		volume_data.vertices_id_.push_back(vertex_id);
+		const float64* p = &meshb.vertices_position_[3u * i];
+		(*position)[vertex_id] = Vec3(Scalar(p[0]), Scalar(p[1]), Scalar(p[2]));
+		if (vertex_ref)
+			(*vertex_ref)[vertex_id] = meshb.vertices_ref_[i];
+	}
+
+	const uint32 first_volume_id = volume_ref ? new_indices<Volume>(m, nb_volumes) : 0u;
+	uint32 volume_id = first_volume_id;
+	std::array<uint32, 8> ids;
+	for (MeshbElementType t : volume_types)
+	{
+		const MeshbElements& volumes = meshb.elements_[t];
+		const uint32 nbv = meshb_element_size(t);
+		for (uint32 i = 0u, end = volumes.size(); i < end; ++i)
+		{
+			for (uint32 j = 0u; j < nbv; ++j)
+				ids[j] = volume_data.vertices_id_[volumes.vertex_indices_[nbv * i + j]];
+			append_volume(volume_data, ids, nbv, *position);
+			if (volume_ref)
+			{
+				volume_data.volumes_id_.push_back(volume_id);
+				(*volume_ref)[volume_id++] = volumes.refs_[i];
+			}
+		}
+	}
+
+	import_volume_data(m, volume_data);
+
+	return true;
+}
+
+/**
+ * @brief exports the tetrahedra, pyramids, prisms and hexahedra of a volume mesh in a Gamma mesh file, in ASCII
+ * or binary after its extension (.mesh or .meshb), with the optional references of the vertices and of the volumes
+ * (the vertices of the volumes are written in the orientation of the format, opposite to the one of import_MESHB)
+ */
+template <typename MESH,
+		  typename std::enable_if<mesh_traits<MESH>::dimension == 3>::type* = nullptr>
+bool export_MESHB(MESH& m, const typename mesh_traits<MESH>::template Attribute<geometry::Vec3>* vertex_position,
+				  const std::string& filename,
+				  const typename mesh_traits<MESH>::template Attribute<int32>* vertex_ref = nullptr,
+				  const typename mesh_traits<MESH>::template Attribute<int32>* volume_ref = nullptr)
+{
+	using Vertex = typename MESH::Vertex;
+	using Face = typename MESH::Face;
+	using Volume = typename MESH::Volume;
+	using Vec3 = geometry::Vec3;
+
+	MeshbData meshb;
+	meshb.dimension_ = 3u;
+
+	// contiguous numbering of the vertices
+	auto vertex_id = add_attribute<uint32, Vertex>(m, "__vertex_id");
+	uint32 nb_vertices = 0u;
+	foreach_cell(m, [&] (Vertex v) -> bool
+	{
+		value<uint32>(m, vertex_id, v) = nb_vertices++;
+		const Vec3& p = value<Vec3>(m, vertex_position, v);
+		meshb.vertices_position_.insert(meshb.vertices_position_.end(), { float64(p[0]), float64(p[1]), float64(p[2]) });
+		meshb.vertices_ref_.push_back(vertex_ref ? value<int32>(m, vertex_ref, v) : 0);
+		return true;
+	});
+
+	uint32 nb_ignored = 0u;
+	std::array<Dart, 8> darts;
+	foreach_cell(m, [&] (Volume v) -> bool
+	{
+		// type of the volume after the degree of its faces
+		uint32 nb_faces = 0u, nb_triangles = 0u, nb_quads = 0u;
+		Dart triangle, quad;
+		foreach_incident_face(m, v, [&] (Face f) -> bool
+		{
+			++nb_faces;
+			const uint32 degree = codegree(m, f);
+			if (degree == 3u)
+			{
+				++nb_triangles;
+				triangle = f.dart;
+			}
+			else if (degree == 4u)
+			{
+				++nb_quads;
+				quad = f.dart;
+			}
+			return true;
+		});
+
+		VolumeType type;
+		MeshbElementType element;
+		Dart base;
+		if (nb_faces == 4u && nb_triangles == 4u)
+		{
+			type = VolumeType::Tetra;
+			element = MESHB_TETRA;
+			base = triangle;
+		}
+		else if (nb_faces == 5u && nb_triangles == 4u && nb_quads == 1u)
+		{
+			type = VolumeType::Pyramid;
+			element = MESHB_PYRAMID;
+			base = quad;
+		}
+		else if (nb_faces == 5u && nb_triangles == 2u && nb_quads == 3u)
+		{
+			type = VolumeType::TriangularPrism;
+			element = MESHB_PRISM;
+			base = triangle;
+		}
+		else if (nb_faces == 6u && nb_quads == 6u)
+		{
+			type = VolumeType::Hexa;
+			element = MESHB_HEXA;
+			base = quad;
+		}
+		else
+		{
+			++nb_ignored;
+			return true;
+		}
+
+		const uint32 nbv = volume_vertices_darts(m, base, type, darts);
+		// reverse the order of the first face (and of the opposite one of prisms and hexahedra)
+		const uint32 base_size = type == VolumeType::Tetra || type == VolumeType::TriangularPrism ? 3u : 4u;
+		std::swap(darts[1], darts[base_size - 1u]);
+		if (nbv == 2u * base_size)
+			std::swap(darts[base_size + 1u], darts[2u * base_size - 1u]);
+
+		MeshbElements& volumes = meshb.elements_[element];
+		for (uint32 j = 0u; j < nbv; ++j)
+			volumes.vertex_indices_.push_back(value<uint32>(m, vertex_id, Vertex(darts[j])));
+		volumes.refs_.push_back(volume_ref ? value<int32>(m, volume_ref, v) : 0);
+		return true;
+	});
+
+	remove_attribute<Vertex>(m, vertex_id);
+
+	if (nb_ignored > 0u)
+		std::cout << "export_MESHB: " << nb_ignored << " volumes that are not tetrahedra, pyramids, prisms or hexahedra were ignored." << std::endl;
+
+	if (!write_MESHB(filename, meshb))
+	{
+		std::cerr << "File \"" << filename << "\" could not be written." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace io
+
+} // namespace cgogn
+
+#endif // CGOGN_IO_VOLUME_MESHB_H_
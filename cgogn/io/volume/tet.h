@@ -28,14 +28,15 @@
 #include <cgogn/io/utils.h>
 
 #include <cgogn/core/utils/numerics.h>
+#include <cgogn/core/utils/thread.h>
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/functions/attributes.h>
 
 #include <cgogn/geometry/types/vector_traits.h>
-#include <cgogn/geometry/functions/orientation.h>
 
+#include <array>
+#include <atomic>
 #include <vector>
-#include <fstream>
 
 namespace cgogn
 {
@@ -50,98 +51,139 @@ bool import_TET(MESH& m, const std::string& filename)
 
 	using Vertex = typename MESH::Vertex;
 
-	Scoped_C_Locale loc;
-
 	VolumeImportData volume_data;
-	
-	std::ifstream fp(filename, std::ios::in);
 
-	std::string line;
-	line.reserve(512u);
+	MappedFile file(filename);
+	if (!file.is_open())
+	{
+		std::cerr << "File \"" << filename << "\" could not be opened." << std::endl;
+		return false;
+	}
+	TextTokenizer tok(file.begin(), file.end());
 
 	// read number of vertices
-	uint32 nb_vertices = read_uint(fp, line);
-	getline_safe(fp, line);
+	uint32 nb_vertices = tok.read_uint();
+	tok.skip_line();
 
-	uint32 nb_volumes = read_uint(fp, line);
-	getline_safe(fp, line);
+	uint32 nb_volumes = tok.read_uint();
+	tok.skip_line();
 
+	if (!tok.good())
+	{
+		std::cerr << "File \"" << filename << "\" is not a valid tet file." << std::endl;
+		return false;
+	}
 	if (nb_vertices == 0u)
 	{
 		std::cerr << "File \"" << filename << " has no vertices." << std::endl;
 		return false;
 	}
 
+	// the file is parsed in local buffers (with the vertex indices of the file in the volumes):
+	// the map is only changed once the whole file is read
 	volume_data.reserve(nb_vertices, nb_volumes);
-	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
+	std::vector<geometry::Vec3> positions(nb_vertices);
 
-	// read vertices position
-	for (uint32 i = 0u; i < nb_vertices; ++i)
+	auto read_vertex = [&] (TextTokenizer& t, uint32 i) -> bool
 	{
-		float64 x = read_double(fp, line);
-		float64 y = read_double(fp, line);
-		float64 z = read_double(fp, line);
-
-		uint32 vertex_id = new_index<Vertex>(m);
-		(*position)[vertex_id] = { x, y, z };
+		geometry::Scalar x = t.read_double();
+		geometry::Scalar y = t.read_double();
+		geometry::Scalar z = t.read_double();
+		positions[i] = { x, y, z };
+		return t.good();
+	};
+	std::atomic<uint32> nb_ignored(0u);
+	auto read_volume = [&] (TextTokenizer& t, VolumeImportData& data) -> bool
+	{
+		uint32 n = t.read_uint();
+		std::array<uint32, 8> ids;
+		for (uint32 j = 0u; j < n; ++j)
+		{
+			const uint32 k = t.read_uint();
+			if (k >= nb_vertices)
+				return false;
+			if (j < 8u)
+				ids[j] = k;
+		}
+		if (!t.good())
+			return false;
+
+		if (!append_volume(data, ids, n, positions))
+			++nb_ignored;
+		return true;
+	};
+
+	// read vertices position and volumes (vertex indices) with one record per line,
+	// on line aligned chunks of the file parsed in parallel (the volumes orientation needs all the positions)
+	const TextChunks chunks = split_text(tok.position(), file.end());
+	std::vector<VolumeImportData> chunks_data(chunks.nb_chunks());
+	bool parsed = parallel_foreach_record(chunks, 0u, nb_vertices, [&] (uint32, uint32 r, TextTokenizer& line) -> bool
+	{
+		return read_vertex(line, r);
+	});
+	parsed = parsed && parallel_foreach_record(chunks, nb_vertices, nb_vertices + nb_volumes,
+		[&] (uint32 c, uint32, TextTokenizer& line) -> bool
+	{
+		return read_volume(line, chunks_data[c]);
+	});
 
-		volume_data.vertices_id_.push_back(vertex_id);
+	if (parsed)
+	{
+		for (const VolumeImportData& data : chunks_data)
+		{
+			volume_data.volumes_types_.insert(volume_data.volumes_types_.end(),
+				data.volumes_types_.begin(), data.volumes_types_.end());
+			volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(),
+				data.volumes_vertex_indices_.begin(), data.volumes_vertex_indices_.end());
+		}
+	}
+	else
+	{
+		// the records are not one per line: sequential parsing of the tokens
+		volume_data.volumes_types_.clear();
+		volume_data.volumes_vertex_indices_.clear();
+		nb_ignored = 0u;
+		for (uint32 i = 0u; i < nb_vertices && tok.good(); ++i)
+		{
+			if (!read_vertex(tok, i))
+				tok.fail();
+		}
+		for (uint32 i = 0u; i < nb_volumes && tok.good(); ++i)
+		{
+			if (!read_volume(tok, volume_data))
+				tok.fail();
+		}
 	}
 
-	// read volumes
-	for (uint32 i = 0u; i < nb_volumes; ++i)
+	if (nb_ignored > 0u)
+		std::cout << "import_TET: " << nb_ignored << " elements with an unhandled number of vertices were ignored." << std::endl;
+
+	if (!tok.good())
 	{
-		uint32 n = read_uint(fp, line);
-		std::vector<uint32> ids(n);
-		for (uint32 j = 0u; j < n; ++j)
-			ids[j] = volume_data.vertices_id_[read_uint(fp, line)];
+		std::cerr << "File \"" << filename << "\" could not be parsed." << std::endl;
+		return false;
+	}
 
-		switch (n)
+	auto position = add_attribute<geometry::Vec3, Vertex>(m, "position");
+	const uint32 first_vertex_id = new_indices<Vertex>(m, nb_vertices);
+	volume_data.vertices_id_.resize(nb_vertices);
+	thread_pool()->parallel_for(0u, nb_vertices, [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
 		{
-			case 4: {
-				if (geometry::test_orientation_3D((*position)[ids[0]], (*position)[ids[1]], (*position)[ids[2]], (*position)[ids[3]]) == geometry::Orientation3D::UNDER)
-					std::swap(ids[1], ids[2]);
-				volume_data.volumes_types_.push_back(VolumeType::Tetra);
-				volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(), ids.end());
-				break;
-			}
-			case 5: {
-				if (geometry::test_orientation_3D((*position)[ids[4]], (*position)[ids[0]], (*position)[ids[1]], (*position)[ids[2]]) == geometry::Orientation3D::OVER)
-					std::swap(ids[1], ids[3]);
-				volume_data.volumes_types_.push_back(VolumeType::Pyramid);
-				volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(), ids.end());
-				break;
-			}
-			case 6: {
-				if (geometry::test_orientation_3D((*position)[ids[3]], (*position)[ids[0]], (*position)[ids[1]], (*position)[ids[2]]) == geometry::Orientation3D::OVER)
-				{
-					std::swap(ids[1], ids[2]);
-					std::swap(ids[4], ids[5]);
-				}
-				volume_data.volumes_types_.push_back(VolumeType::TriangularPrism);
-				volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(), ids.end());
-				break;
-			}
-			case 8: {
-				if (geometry::test_orientation_3D((*position)[ids[4]], (*position)[ids[0]], (*position)[ids[1]], (*position)[ids[2]]) == geometry::Orientation3D::OVER)
-				{
-					std::swap(ids[0], ids[3]);
-					std::swap(ids[1], ids[2]);
-					std::swap(ids[4], ids[7]);
-					std::swap(ids[5], ids[6]);
-				}
-				volume_data.volumes_types_.push_back(VolumeType::Hexa);
-				volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(), ids.end());
-				break;
-			}
-			default:
-				std::cout << "import_TET: Elements with " << n << " vertices are not handled. Ignoring.";
-				break;
+			(*position)[first_vertex_id + i] = positions[i];
+			volume_data.vertices_id_[i] = first_vertex_id + i;
 		}
-	}
+	}, PARALLEL_BUFFER_SIZE);
+	std::vector<uint32>& indices = volume_data.volumes_vertex_indices_;
+	thread_pool()->parallel_for(0u, uint32(indices.size()), [&] (uint32 first, uint32 last)
+	{
+		for (uint32 i = first; i < last; ++i)
+			indices[i] += first_vertex_id;
+	}, PARALLEL_BUFFER_SIZE);
 
 	import_volume_data(m, volume_data);
-	
+
 	return true;
 }
 
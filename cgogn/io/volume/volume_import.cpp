@@ -25,9 +25,12 @@
 
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/functions/attributes.h>
+#include <cgogn/core/functions/cells.h>
 #include <cgogn/core/functions/mesh_info.h>
 #include <cgogn/core/functions/mesh_ops/volume.h>
 
+#include <algorithm>
+#include <array>
 #include <vector>
 
 namespace cgogn
@@ -36,16 +39,59 @@ namespace cgogn
 namespace io
 {
 
+uint32 volume_vertices_darts(const CMap3& m, Dart d, VolumeType type, std::array<Dart, 8>& darts)
+{
+	switch (type)
+	{
+		case VolumeType::Tetra:
+			darts[0] = d;
+			darts[1] = m.phi1(d);
+			darts[2] = m.phi_1(d);
+			darts[3] = m.phi_1(m.phi2(m.phi_1(d)));
+			return 4u;
+		case VolumeType::Pyramid:
+			darts[0] = d;
+			darts[1] = m.phi1(d);
+			darts[2] = m.phi1(m.phi1(d));
+			darts[3] = m.phi_1(d);
+			darts[4] = m.phi_1(m.phi2(m.phi_1(d)));
+			return 5u;
+		case VolumeType::TriangularPrism:
+			darts[0] = d;
+			darts[1] = m.phi1(d);
+			darts[2] = m.phi_1(d);
+			darts[3] = m.phi2(m.phi1(m.phi1(m.phi2(m.phi_1(d)))));
+			darts[4] = m.phi2(m.phi1(m.phi1(m.phi2(d))));
+			darts[5] = m.phi2(m.phi1(m.phi1(m.phi2(m.phi1(d)))));
+			return 6u;
+		case VolumeType::Hexa:
+			darts[0] = d;
+			darts[1] = m.phi1(d);
+			darts[2] = m.phi1(m.phi1(d));
+			darts[3] = m.phi_1(d);
+			darts[4] = m.phi2(m.phi1(m.phi1(m.phi2(m.phi_1(d)))));
+			darts[5] = m.phi2(m.phi1(m.phi1(m.phi2(d))));
+			darts[6] = m.phi2(m.phi1(m.phi1(m.phi2(m.phi1(d)))));
+			darts[7] = m.phi2(m.phi1(m.phi1(m.phi2(m.phi1(m.phi1(d))))));
+			return 8u;
+		default:
+			return 0u;
+	}
+}
+
 void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 {
 	using Vertex = CMap3::Vertex;
 	using Volume = CMap3::Volume;
 
+	// the imported volumes are added to the ones of the map
+	const bool pure_simplicial = m.nb_darts() == 0u || m.is_pure_simplicial();
+
 	auto darts_per_vertex = add_attribute<std::vector<Dart>, Vertex>(m, "__darts_per_vertex");
 	
 	uint32 index = 0u;
 	DartMarker dart_marker(m);
-	uint32 vol_emb = 0u;
+	std::array<Dart, 8> vertices_of_volume;
 
 	// for each volume of table
 	for (uint32 i = 0u, end = volume_data.volumes_types_.size(); i < end; ++i)
@@ -54,137 +100,41 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 		const VolumeType vol_type = volume_data.volumes_types_[i];
 
 		if (vol_type == VolumeType::Tetra) // tetrahedral case
-		{
 			vol = add_pyramid(static_cast<CMap2&>(m), 3u, false);
-
-			const std::array<Dart, 4> vertices_of_tetra = {
-				vol.dart,
-				m.phi1(vol.dart),
-				m.phi_1(vol.dart),
-				m.phi_1(m.phi2(m.phi_1(vol.dart)))
-			};
-
-			for (Dart dv : vertices_of_tetra)
-			{
-				const uint32 vertex_index = volume_data.volumes_vertex_indices_[index++];
-				static_cast<CMap2&>(m).foreach_dart_of_orbit(CMap2::Vertex(dv), [&] (Dart d) -> bool
-				{
-					m.set_index<Vertex>(d, vertex_index);
-					return true;
-				});
-
-				Dart dd = dv;
-				do
-				{
-					dart_marker.mark(dd);
-					(*darts_per_vertex)[vertex_index].push_back(dd);
-					dd = m.phi1(m.phi2(dd));
-				} while (dd != dv);
-			}
-		}
 		else if (vol_type == VolumeType::Pyramid) // pyramidal case
-		{
 			vol = add_pyramid(static_cast<CMap2&>(m), 4u, false);
-
-			const std::array<Dart, 5> vertices_of_pyramid = {
-				vol.dart,
-				m.phi1(vol.dart),
-				m.phi1(m.phi1(vol.dart)),
-				m.phi_1(vol.dart),
-				m.phi_1(m.phi2(m.phi_1(vol.dart)))
-			};
-
-			for (Dart dv : vertices_of_pyramid)
+		else if (vol_type == VolumeType::TriangularPrism) // prism case
+			vol = add_prism(static_cast<CMap2&>(m), 3u, false);
+		else if (vol_type == VolumeType::Hexa) // hexahedral case
+			vol = add_prism(static_cast<CMap2&>(m), 4u, false);
+		else
+			continue;
+
+		// the darts of the volume are all visited around its vertices
+		const uint32 volume_index = !m.is_indexed<Volume>() ? INVALID_INDEX :
+			volume_data.volumes_id_.empty() ? new_index<Volume>(m) : volume_data.volumes_id_[i];
+
+		const uint32 nb_vertices = volume_vertices_darts(m, vol.dart, vol_type, vertices_of_volume);
+		for (uint32 j = 0u; j < nb_vertices; ++j)
+		{
+			const Dart dv = vertices_of_volume[j];
+			const uint32 vertex_index = volume_data.volumes_vertex_indices_[index++];
+			static_cast<CMap2&>(m).foreach_dart_of_orbit(CMap2::Vertex(dv), [&] (Dart d) -> bool
 			{
-				const uint32 vertex_index = volume_data.volumes_vertex_indices_[index++];
-				static_cast<CMap2&>(m).foreach_dart_of_orbit(CMap2::Vertex(dv), [&] (Dart d) -> bool
-				{
-					m.set_index<Vertex>(d, vertex_index);
-					return true;
-				});
+				m.set_index<Vertex>(d, vertex_index);
+				return true;
+			});
 
-				Dart dd = dv;
-				do
-				{
-					dart_marker.mark(dd);
-					(*darts_per_vertex)[vertex_index].push_back(dd);
-					dd = m.phi1(m.phi2(dd));
-				} while (dd != dv);
-			}
+			Dart dd = dv;
+			do
+			{
+				dart_marker.mark(dd);
+				(*darts_per_vertex)[vertex_index].push_back(dd);
+				if (volume_index != INVALID_INDEX)
+					m.set_index<Volume>(dd, volume_index);
+				dd = m.phi1(m.phi2(dd));
+			} while (dd != dv);
 		}
-		// else if (vol_type == VolumeType::TriangularPrism) // prism case
-		// {
-		// 	d = mbuild_.add_prism_topo_fp(3u);
-
-		// 	// check if add ok (special maps)
-		// 	if (d.is_nil()) break;
-
-		// 	const std::array<Dart, 6> vertices_of_prism = {
-		// 		d,
-		// 		m.phi1(d),
-		// 		m.phi_1(d),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(m.phi_1(d))))),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(d)))),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(m.phi1(d)))))
-		// 	};
-
-		// 	for (Dart dv : vertices_of_prism)
-		// 	{
-		// 		const uint32 vertex_index = this->volumes_vertex_indices_[index++];
-		// 		mbuild_.template set_orbit_embedding<Vertex>(Vertex2(dv), vertex_index);
-
-		// 		Dart dd = dv;
-		// 		do
-		// 		{
-		// 			dart_marker.mark(dd);
-		// 			(*darts_per_vertex)[vertex_index].push_back(dd);
-		// 			dd = m.phi1(m.phi2(dd));
-		// 		} while (dd != dv);
-		// 	}
-		// }
-		// else if (vol_type == VolumeType::Hexa) // hexahedral case
-		// {
-		// 	d = mbuild_.add_prism_topo_fp(4u);
-
-		// 	// check if add ok (special maps)
-		// 	if (d.is_nil()) break;
-
-		// 	const std::array<Dart, 8> vertices_of_hexa = {
-		// 		d,
-		// 		m.phi1(d),
-		// 		m.phi1(m.phi1(d)),
-		// 		m.phi_1(d),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(m.phi_1(d))))),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(d)))),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(m.phi1(d))))),
-		// 		m.phi2(m.phi1(m.phi1(m.phi2(m.phi1(m.phi1(d))))))
-		// 	};
-
-		// 	for (Dart dv : vertices_of_hexa)
-		// 	{
-		// 		const uint32 vertex_index = this->volumes_vertex_indices_[index++];
-		// 		mbuild_.template set_orbit_embedding<Vertex>(Vertex2(dv), vertex_index);
-
-		// 		Dart dd = dv;
-		// 		do
-		// 		{
-		// 			dart_marker.mark(dd);
-		// 			(*darts_per_vertex)[vertex_index].push_back(dd);
-		// 			dd = m.phi1(m.phi2(dd));
-		// 		} while (dd != dv);
-		// 	}
-		// }
-		// else //end of hexa
-		// {
-		// 	if (vol_type == VolumeType::Connector)
-		// 	{
-		// 		index += 4u;
-		// 		// The second part of the code generates connectors automatically. We don't have to do anything here.
-		// 	}
-		// }
-
-		if (m.is_indexed<Volume>())
-			set_index(m, vol, vol_emb++);
 	}
 
 	// reconstruct neighbourhood
@@ -250,6 +200,12 @@ void import_volume_data(CMap3& m, const VolumeImportData& volume_data)
 	}
 	
 	remove_attribute<Vertex>(m, darts_per_vertex);
+
+	// set after the sewing of the volumes (that resets the flag and the labels)
+	m.set_pure_simplicial(pure_simplicial &&
+		std::all_of(volume_data.volumes_types_.begin(), volume_data.volumes_types_.end(),
+			[] (VolumeType t) { return t == VolumeType::Tetra; }));
+	m.label_volumes();
 }
 
 } // namespace io
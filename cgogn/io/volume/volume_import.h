@@ -28,6 +28,10 @@
 
 #include <cgogn/core/types/mesh_traits.h>
 
+#include <cgogn/geometry/types/vector_traits.h>
+#include <cgogn/geometry/functions/orientation.h>
+
+#include <array>
 #include <vector>
 
 namespace cgogn
@@ -50,6 +54,8 @@ struct VolumeImportData
 	std::vector<uint32> vertices_id_;
 	std::vector<VolumeType> volumes_types_;
 	std::vector<uint32> volumes_vertex_indices_;
+	// indices given to the volumes (optional)
+	std::vector<uint32> volumes_id_;
 
 	inline void reserve(uint32 nb_vertices, uint32 nb_volumes)
 	{
@@ -59,6 +65,68 @@ struct VolumeImportData
 	}
 };
 
+/**
+ * @brief appends to volume_data the volume of the nb_vertices given vertices (4: tetrahedron, 5: square pyramid,
+ * 6: triangular prism, 8: hexahedron), reordered after the position of its vertices to be well oriented
+ * @return false if nb_vertices does not match one of these volumes
+ */
+template <typename POSITION>
+bool append_volume(VolumeImportData& volume_data, std::array<uint32, 8> ids, uint32 nb_vertices,
+				   const POSITION& position)
+{
+	using geometry::Orientation3D;
+	using geometry::test_orientation_3D;
+
+	switch (nb_vertices)
+	{
+		case 4: {
+			if (test_orientation_3D(position[ids[0]], position[ids[1]], position[ids[2]], position[ids[3]]) == Orientation3D::UNDER)
+				std::swap(ids[1], ids[2]);
+			volume_data.volumes_types_.push_back(VolumeType::Tetra);
+			break;
+		}
+		case 5: {
+			if (test_orientation_3D(position[ids[4]], position[ids[0]], position[ids[1]], position[ids[2]]) == Orientation3D::OVER)
+				std::swap(ids[1], ids[3]);
+			volume_data.volumes_types_.push_back(VolumeType::Pyramid);
+			break;
+		}
+		case 6: {
+			if (test_orientation_3D(position[ids[3]], position[ids[0]], position[ids[1]], position[ids[2]]) == Orientation3D::OVER)
+			{
+				std::swap(ids[1], ids[2]);
+				std::swap(ids[4], ids[5]);
+			}
+			volume_data.volumes_types_.push_back(VolumeType::TriangularPrism);
+			break;
+		}
+		case 8: {
+			if (test_orientation_3D(position[ids[4]], position[ids[0]], position[ids[1]], position[ids[2]]) == Orientation3D::OVER)
+			{
+				std::swap(ids[0], ids[3]);
+				std::swap(ids[1], ids[2]);
+				std::swap(ids[4], ids[7]);
+				std::swap(ids[5], ids[6]);
+			}
+			volume_data.volumes_types_.push_back(VolumeType::Hexa);
+			break;
+		}
+		default:
+			return false;
+	}
+	volume_data.volumes_vertex_indices_.insert(volume_data.volumes_vertex_indices_.end(), ids.begin(), ids.begin() + nb_vertices);
+	return true;
+}
+
+/**
+ * @brief gets in darts the darts of the vertices of a volume of the given type built by import_volume_data,
+ * in the order of its vertex indices, from a dart d of its first face
+ * (any face of a tetrahedron or an hexahedron, the square of a pyramid or a triangle of a prism)
+ * @return the number of vertices of the volume
+ */
+uint32
+CGOGN_IO_EXPORT volume_vertices_darts(const CMap3& m, Dart d, VolumeType type, std::array<Dart, 8>& darts);
+
 void
 CGOGN_IO_EXPORT import_volume_data(CMap3& m, const VolumeImportData& volume_data);
 
@@ -88,7 +88,7 @@ void subdivide(MESH& m, typename mesh_traits<MESH>::template Attribute<Vec3>* ve
 
 	foreach_cell(cache, [&] (Edge e) -> bool
 	{
-		std::vector<Vertex> vertices = incident_vertices(m, e);
+		auto vertices = incident_vertices(m, e);
 		Vertex v = cut_edge(m, e);
 		value<Vec3>(m, vertex_position, v) =
 			0.5 * (value<Vec3>(m, vertex_position, vertices[0]) + value<Vec3>(m, vertex_position, vertices[1]));
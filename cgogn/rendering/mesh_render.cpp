@@ -36,6 +36,8 @@ MeshRender::MeshRender()
 		indices_buffers_[i] = std::make_unique<EBO>();
 		indices_buffers_uptodate_[i] = false;
 		nb_indices_[i] = 0;
+		indices_buffers_versions_[i] = 0;
+		journal_epochs_[i] = 0;
 	}
 }
 
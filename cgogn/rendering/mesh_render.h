@@ -61,6 +61,13 @@ protected:
 	std::array<std::unique_ptr<EBO>, SIZE_BUFFER> indices_buffers_;
 	std::array<bool, SIZE_BUFFER> indices_buffers_uptodate_;
 	std::array<uint32, SIZE_BUFFER> nb_indices_;
+	// versions of the vertices of the mesh the indices buffers were built from
+	std::array<uint64, SIZE_BUFFER> indices_buffers_versions_;
+	// copies of the indices buffers and darts of the cells of their primitives,
+	// kept for the incremental updates when the mesh has a journal (see update_primitives)
+	std::array<std::vector<uint32>, SIZE_BUFFER> tables_;
+	std::array<std::vector<Dart>, SIZE_BUFFER> keys_;
+	std::array<uint64, SIZE_BUFFER> journal_epochs_;
 
 public:
 
@@ -71,85 +78,142 @@ public:
 	inline bool is_primitive_uptodate(DrawingType prim) { return indices_buffers_uptodate_[prim]; }
 	inline void set_primitive_dirty(DrawingType prim) { indices_buffers_uptodate_[prim] = false; }
 
+	// also checks that the mesh vertices did not change since the buffer was built
+	template <typename MESH>
+	inline bool is_primitive_uptodate(const MESH& m, DrawingType prim)
+	{
+		if constexpr (std::is_base_of<CMapBase, MESH>::value)
+		{
+			using Vertex = typename mesh_traits<MESH>::Vertex;
+			if (indices_buffers_versions_[prim] != m.cells_version(Vertex::ORBIT))
+				return false;
+		}
+		return indices_buffers_uptodate_[prim];
+	}
+
 protected:
 
+	// appends the indices of the primitives of the given cell to table_indices
+
 	template <typename MESH>
-	inline void init_points(const MESH& m, std::vector<uint32>& table_indices)
+	inline void add_point(const MESH& m, typename mesh_traits<MESH>::Vertex v, std::vector<uint32>& table_indices)
 	{
-		using Vertex = typename mesh_traits<MESH>::Vertex;
-		foreach_cell(m, [&] (Vertex v) -> bool
-		{
-			table_indices.push_back(index_of(m, v));
-			return true;
-		});
+		table_indices.push_back(index_of(m, v));
 	}
 
 	template <typename MESH>
-	inline void init_lines(const MESH& m, std::vector<uint32>& table_indices)
+	inline void add_line(const MESH& m, typename mesh_traits<MESH>::Edge e, std::vector<uint32>& table_indices)
 	{
-		if constexpr (mesh_traits<MESH>::dimension > 0)
-		{
-			using Vertex = typename mesh_traits<MESH>::Vertex;
-			using Edge = typename mesh_traits<MESH>::Edge;
-			foreach_cell(m, [&] (Edge e) -> bool
-			{
-				foreach_incident_vertex(m, e, [&] (Vertex v) -> bool { table_indices.push_back(index_of(m, v)); return true; });
-				return true;
-			});
-		}
+		using Vertex = typename mesh_traits<MESH>::Vertex;
+		foreach_incident_vertex(m, e, [&] (Vertex v) -> bool { table_indices.push_back(index_of(m, v)); return true; });
 	}
 
 	template <typename MESH>
-	inline void init_triangles(const MESH& m, std::vector<uint32>& table_indices)
+	inline void add_triangles(const MESH& m, typename mesh_traits<MESH>::Face f, std::vector<uint32>& table_indices)
 	{
-		if constexpr (mesh_traits<MESH>::dimension > 1)
+		using Vertex = typename mesh_traits<MESH>::Vertex;
+		if constexpr (std::is_base_of<CMapBase, MESH>::value)
 		{
-			using Vertex = typename mesh_traits<MESH>::Vertex;
-			using Face = typename mesh_traits<MESH>::Face;
-			foreach_cell(m, [&] (Face f) -> bool
+			if (m.is_pure_simplicial())
 			{
-				std::vector<Vertex> vertices = incident_vertices(m, f);
-				for (uint32 i = 1; i < vertices.size() - 1; ++i)
-				{
-					table_indices.push_back(index_of(m, vertices[0]));
-					table_indices.push_back(index_of(m, vertices[i]));
-					table_indices.push_back(index_of(m, vertices[i+1]));
-				}
-				return true;
-			});
+				// the traversed faces are not boundary: they are all triangles
+				const Dart d1 = m.phi1(f.dart);
+				table_indices.push_back(index_of(m, Vertex(f.dart)));
+				table_indices.push_back(index_of(m, Vertex(d1)));
+				table_indices.push_back(index_of(m, Vertex(m.phi1(d1))));
+				return;
+			}
+		}
+		auto vertices = incident_vertices(m, f);
+		for (uint32 i = 1; i < vertices.size() - 1; ++i)
+		{
+			table_indices.push_back(index_of(m, vertices[0]));
+			table_indices.push_back(index_of(m, vertices[i]));
+			table_indices.push_back(index_of(m, vertices[i+1]));
 		}
 	}
 
-public:
-
-	inline uint32 nb_indices(DrawingType prim) const
+	// calls f on each cell of the mesh that produces the primitives prim (f(cell, arity of the primitives))
+	template <typename MESH, typename FUNC>
+	inline void foreach_primitive_cell(const MESH& m, DrawingType prim, const FUNC& f)
 	{
-		return nb_indices_[prim];
+		switch (prim)
+		{
+			case POINTS:
+				foreach_cell(m, [&] (typename mesh_traits<MESH>::Vertex v) -> bool { f(v, 1u); return true; });
+				break;
+			case LINES:
+				if constexpr (mesh_traits<MESH>::dimension > 0)
+					foreach_cell(m, [&] (typename mesh_traits<MESH>::Edge e) -> bool { f(e, 2u); return true; });
+				break;
+			case TRIANGLES:
+				if constexpr (mesh_traits<MESH>::dimension > 1)
+					foreach_cell(m, [&] (typename mesh_traits<MESH>::Face fa) -> bool { f(fa, 3u); return true; });
+				break;
+			default:
+				break;
+		}
 	}
 
 	template <typename MESH>
-	inline void init_primitives(const MESH& m, DrawingType prim)
+	inline void add_primitives(const MESH& m, DrawingType prim, Dart d, std::vector<uint32>& table_indices)
 	{
-		std::vector<uint32> table_indices;
-		table_indices.reserve(1024u);
-
 		switch (prim)
 		{
 			case POINTS:
-				init_points(m, table_indices);
+				add_point(m, typename mesh_traits<MESH>::Vertex(d), table_indices);
 				break;
 			case LINES:
-				init_lines(m, table_indices);
+				if constexpr (mesh_traits<MESH>::dimension > 0)
+					add_line(m, typename mesh_traits<MESH>::Edge(d), table_indices);
 				break;
 			case TRIANGLES:
-				init_triangles(m, table_indices);
-				break;
-			case BOUNDARY:
+				if constexpr (mesh_traits<MESH>::dimension > 1)
+					add_triangles(m, typename mesh_traits<MESH>::Face(d), table_indices);
 				break;
 			default:
 				break;
 		}
+	}
+
+	// rebuilds the primitives of the cells that contain a dart recorded in the journal of m
+	// and keeps the other ones (the cells are identified by the dart they were built from)
+	template <typename CELL, typename MESH>
+	inline void update_cells(const MESH& m, DrawingType prim, uint32 arity)
+	{
+		std::vector<uint32>& table_indices = tables_[prim];
+		std::vector<Dart>& keys = keys_[prim];
+
+		DartMarkerStore dm(m);
+		for (Dart d : m.journal()->darts)
+		{
+			if (m.is_live_dart(d) && !dm.is_marked(d))
+				m.foreach_dart_of_orbit(CELL(d), [&] (Dart e) -> bool { dm.mark(e); return true; });
+		}
+
+		uint32 nb_kept = 0u;
+		for (uint32 i = 0u, end = uint32(keys.size()); i < end; ++i)
+		{
+			if (!m.is_live_dart(keys[i]) || dm.is_marked(keys[i]))
+				continue;
+			keys[nb_kept] = keys[i];
+			for (uint32 j = 0u; j < arity; ++j)
+				table_indices[nb_kept * arity + j] = table_indices[i * arity + j];
+			++nb_kept;
+		}
+		keys.resize(nb_kept);
+		table_indices.resize(nb_kept * arity);
+
+		foreach_journaled_cell(m, [&] (CELL c) -> bool
+		{
+			add_primitives(m, prim, c.dart, table_indices);
+			keys.resize(table_indices.size() / arity, c.dart);
+			return true;
+		});
+	}
 
+	inline void upload(DrawingType prim, std::vector<uint32>& table_indices)
+	{
 		indices_buffers_uptodate_[prim] = true;
 		nb_indices_[prim] = uint32(table_indices.size());
 
@@ -158,12 +222,97 @@ public:
 
 		if (!indices_buffers_[prim]->is_created())
 			indices_buffers_[prim]->create();
-		
+
 		indices_buffers_[prim]->bind();
 		indices_buffers_[prim]->allocate(table_indices.data(), nb_indices_[prim]);
 		indices_buffers_[prim]->release();
 	}
 
+public:
+
+	inline uint32 nb_indices(DrawingType prim) const
+	{
+		return nb_indices_[prim];
+	}
+
+	template <typename MESH>
+	inline void init_primitives(const MESH& m, DrawingType prim)
+	{
+		std::vector<uint32> table_indices;
+		table_indices.reserve(1024u);
+
+		bool journaled = false;
+		if constexpr (std::is_base_of<CMapBase, MESH>::value)
+		{
+			using Vertex = typename mesh_traits<MESH>::Vertex;
+			indices_buffers_versions_[prim] = m.cells_version(Vertex::ORBIT);
+			// the tables are kept for the incremental updates only when the changes of the mesh are recorded
+			journaled = m.journal() != nullptr;
+			journal_epochs_[prim] = journaled ? m.journal()->epoch : 0u;
+		}
+
+		std::vector<Dart>& keys = keys_[prim];
+		keys.clear();
+		foreach_primitive_cell(m, prim, [&] (auto c, uint32 arity)
+		{
+			add_primitives(m, prim, c.dart, table_indices);
+			if (journaled)
+				keys.resize(table_indices.size() / arity, c.dart);
+		});
+
+		upload(prim, table_indices);
+
+		if (journaled)
+			tables_[prim].swap(table_indices);
+		else
+		{
+			std::vector<uint32>().swap(tables_[prim]);
+			std::vector<Dart>().swap(keys);
+		}
+	}
+
+	/**
+	 * @brief updates the indices buffer of prim if the mesh changed since it was built.
+	 * If the changes of the mesh were recorded in its journal since the buffer was built (same checkpoint),
+	 * only the primitives of the modified cells are rebuilt, otherwise all of them are (see init_primitives)
+	 */
+	template <typename MESH>
+	inline void update_primitives(const MESH& m, DrawingType prim)
+	{
+		if (is_primitive_uptodate(m, prim))
+			return;
+
+		if constexpr (std::is_base_of<CMapBase, MESH>::value)
+		{
+			const CellsJournal* journal = m.journal();
+			if (indices_buffers_uptodate_[prim] && journal && journal->complete && journal_epochs_[prim] == journal->epoch)
+			{
+				using Vertex = typename mesh_traits<MESH>::Vertex;
+				switch (prim)
+				{
+					case POINTS:
+						update_cells<Vertex>(m, prim, 1u);
+						break;
+					case LINES:
+						if constexpr (mesh_traits<MESH>::dimension > 0)
+							update_cells<typename mesh_traits<MESH>::Edge>(m, prim, 2u);
+						break;
+					case TRIANGLES:
+						if constexpr (mesh_traits<MESH>::dimension > 1)
+							update_cells<typename mesh_traits<MESH>::Face>(m, prim, 3u);
+						break;
+					default:
+						break;
+				}
+				indices_buffers_versions_[prim] = m.cells_version(Vertex::ORBIT);
+				upload(prim, tables_[prim]);
+				return;
+			}
+		}
+
+		init_primitives(m, prim);
+	}
+
 	void draw(DrawingType prim);
 };
 
@@ -216,14 +216,14 @@ void update_vbo(const Vector<VEC>* attribute, VBO* vbo)
 // ChunkArray //
 ////////////////
 
-template <typename VEC,
+template <typename VEC, uint32 CHUNK_SIZE,
 		  typename std::enable_if<std::is_same<typename geometry::vector_traits<VEC>::Scalar, float32>::value>::type* = nullptr>
-void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo)
+void update_vbo(const ChunkArrayT<VEC, CHUNK_SIZE>* attribute, VBO* vbo)
 {
 	vbo->set_name(attribute->name());
 
 	static const std::size_t element_size = geometry::vector_traits<VEC>::SIZE;
-	static const uint32 chunk_size = ChunkArray<VEC>::CHUNK_SIZE;
+	const uint32 chunk_size = attribute->chunk_size();
 	uint32 nb_chunks = attribute->nb_chunks();
 
 	vbo->bind();
@@ -241,8 +241,8 @@ void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo)
  * @param vbo vbo to update
  * @param convert the conversion function
  */
-template <typename VEC, typename FUNC>
-void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo, const FUNC& convert)
+template <typename VEC, uint32 CHUNK_SIZE, typename FUNC>
+void update_vbo(const ChunkArrayT<VEC, CHUNK_SIZE>* attribute, VBO* vbo, const FUNC& convert)
 {
 	static_assert(is_func_parameter_same<FUNC, const VEC&>::value, "Wrong conversion function parameter type");
 	
@@ -250,7 +250,7 @@ void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo, const FUNC& convert)
 
 	using OutputType = func_return_type<FUNC>;
 	static const std::size_t output_type_size = geometry::vector_traits<OutputType>::SIZE;
-	static const uint32 chunk_size = ChunkArray<VEC>::CHUNK_SIZE;
+	const uint32 chunk_size = attribute->chunk_size();
 	uint32 nb_elements = attribute->maximum_index();
 
 	vbo->bind();
@@ -267,9 +267,9 @@ void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo, const FUNC& convert)
 	vbo->release();
 }
 
-template <typename VEC,
+template <typename VEC, uint32 CHUNK_SIZE,
 		  typename std::enable_if<std::is_same<typename geometry::vector_traits<VEC>::Scalar, float64>::value>::type* = nullptr>
-void update_vbo(const ChunkArray<VEC>* attribute, VBO* vbo)
+void update_vbo(const ChunkArrayT<VEC, CHUNK_SIZE>* attribute, VBO* vbo)
 {
 	static const std::size_t element_size = geometry::vector_traits<VEC>::SIZE;
 	if constexpr (element_size == 1)
@@ -27,6 +27,7 @@
 #include <cgogn/core/types/mesh_traits.h>
 #include <cgogn/core/types/cells_set.h>
 #include <cgogn/geometry/types/vector_traits.h>
+#include <cgogn/geometry/algos/bounding_box.h>
 
 #include <cgogn/core/functions/mesh_info.h>
 
@@ -35,6 +36,7 @@
 
 #include <unordered_map>
 #include <list>
+#include <tuple>
 
 namespace cgogn
 {
@@ -50,6 +52,7 @@ struct MeshData
     using AttributeGen = typename mesh_traits<MESH>::AttributeGen;
 
     using Vec3 = geometry::Vec3;
+    using Scalar = geometry::Scalar;
 
 	MeshData() : mesh_(nullptr)
 	{}
@@ -64,8 +67,7 @@ struct MeshData
 	
 	void draw(rendering::DrawingType primitive)
 	{
-		if (!render_.is_primitive_uptodate(primitive))
-			render_.init_primitives(*mesh_, primitive);
+		render_.update_primitives(*mesh_, primitive);
 		render_.draw(primitive);
 	}
 
@@ -111,21 +113,7 @@ public:
 			return;
 		}
 
-		for (uint32 i = 0; i < 3; ++i)
-		{
-			bb_min_[i] = std::numeric_limits<float64>::max();
-			bb_max_[i] = std::numeric_limits<float64>::lowest();
-		}
-		for (const Vec3& v : *bb_vertex_position_)
-		{
-			for (uint32 i = 0; i < 3; ++i)
-			{
-				if (v[i] < bb_min_[i])
-					bb_min_[i] = v[i];
-				if (v[i] > bb_max_[i])
-					bb_max_[i] = v[i];
-			}
-		}
+		std::tie(bb_min_, bb_max_) = geometry::bounding_box(*mesh_, bb_vertex_position_.get());
 	}
 
 	rendering::VBO* vbo(AttributeGen* attribute)
@@ -146,7 +134,18 @@ public:
 			v = it->second.get();
 		}
 		if (v)
-			rendering::update_vbo<T>(attribute, v);
+		{
+			// the VBO is only filled again if the attribute version changed since its last update:
+			// the values written through value<T>() or operator[] have to be signaled with set_modified
+			// (as done by MeshProvider::emit_attribute_changed)
+			auto [it, inserted] = vbos_versions_.emplace(attribute, 0u);
+			const uint64 version = attribute->version();
+			if (inserted || it->second != version)
+			{
+				rendering::update_vbo<T>(attribute, v);
+				it->second = version;
+			}
+		}
 	}
 
 	template <typename CELL, typename FUNC>
@@ -212,6 +211,7 @@ private:
 
 	rendering::MeshRender render_;
 	std::unordered_map<AttributeGen*, std::unique_ptr<rendering::VBO>> vbos_;
+	std::unordered_map<AttributeGen*, uint64> vbos_versions_;
 	CellsSets cells_sets_;
 };
 
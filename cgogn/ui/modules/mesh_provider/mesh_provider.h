@@ -37,6 +37,9 @@
 #include <cgogn/io/graph/cgr.h>
 #include <cgogn/io/graph/skel.h>
 #include <cgogn/io/surface/off.h>
+#include <cgogn/io/surface/meshb.h>
+#include <cgogn/io/surface/ply.h>
+#include <cgogn/io/volume/meshb.h>
 #include <cgogn/io/volume/tet.h>
 
 #include <boost/synapse/emit.hpp>
@@ -133,7 +136,15 @@ public:
 			std::string name = filename_from_path(filename);
 			const auto [it, inserted] = meshes_.emplace(name, std::make_unique<MESH>());
 			MESH* m = it->second.get();
-			bool imported = cgogn::io::import_OFF(*m, filename);
+
+			std::string ext = extension(filename);
+			bool imported;
+			if (ext.compare("ply") == 0)
+				imported = cgogn::io::import_PLY(*m, filename);
+			else if (ext.compare("mesh") == 0 || ext.compare("meshb") == 0)
+				imported = cgogn::io::import_MESHB(*m, filename);
+			else
+				imported = cgogn::io::import_OFF(*m, filename);
 			if (imported)
 			{
 				MeshData<MESH>& md = mesh_data_[m];
@@ -161,7 +172,12 @@ public:
 			std::string name = filename_from_path(filename);
 			const auto [it, inserted] = meshes_.emplace(name, std::make_unique<MESH>());
 			MESH* m = it->second.get();
-			bool imported = cgogn::io::import_TET(*m, filename);
+			std::string ext = extension(filename);
+			bool imported;
+			if (ext.compare("mesh") == 0 || ext.compare("meshb") == 0)
+				imported = cgogn::io::import_MESHB(*m, filename);
+			else
+				imported = cgogn::io::import_TET(*m, filename);
 			if (imported)
 			{
 				MeshData<MESH>& md = mesh_data_[m];
@@ -223,8 +239,8 @@ private:
 	{
 		for (uint32 i = 0; i < 3; ++i)
 		{
-			bb_min_[i] = std::numeric_limits<float64>::max();
-			bb_max_[i] = std::numeric_limits<float64>::lowest();
+			bb_min_[i] = std::numeric_limits<Scalar>::max();
+			bb_max_[i] = std::numeric_limits<Scalar>::lowest();
 		}
 		for (auto& [m, md] : mesh_data_)
 		{
@@ -264,6 +280,7 @@ public:
 	void emit_attribute_changed(const MESH* m, Attribute<T>* attribute)
 	{
 		MeshData<MESH>& md = mesh_data_[m];
+		attribute->set_modified();
 		md.update_vbo(attribute);
 		if (static_cast<AttributeGen*>(md.bb_vertex_position_.get()) == static_cast<AttributeGen*>(attribute))
 		{
@@ -383,8 +400,8 @@ protected:
 private:
 
 	std::vector<std::string> supported_graph_files = { "Graph", "*.cg *.skel" };
-	std::vector<std::string> supported_surface_files = { "Surface", "*.off" };
-	std::vector<std::string> supported_volume_files = { "Volume", "*.tet" };
+	std::vector<std::string> supported_surface_files = { "Surface", "*.off *.ply *.mesh *.meshb" };
+	std::vector<std::string> supported_volume_files = { "Volume", "*.tet *.mesh *.meshb" };
 
 	bool show_mesh_inspector_;
 	const MESH* selected_mesh_;
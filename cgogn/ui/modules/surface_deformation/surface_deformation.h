@@ -56,6 +56,7 @@ class SurfaceDeformation : public ViewModule
     using Vec3 = geometry::Vec3;
     using Mat3 = geometry::Mat3;
     using Scalar = geometry::Scalar;
+    using MatX = geometry::MatX;
 
 	struct Parameters
 	{
@@ -65,6 +66,7 @@ class SurfaceDeformation : public ViewModule
 			selected_handle_vertices_set_(nullptr),
 			initialized_(false),
 			solver_ready_(false),
+			vertices_version_(0u),
 			vertex_position_init_(nullptr),
 			vertex_diff_coord_(nullptr),
 			vertex_bi_diff_coord_(nullptr),
@@ -90,6 +92,7 @@ class SurfaceDeformation : public ViewModule
 
 		bool initialized_;
 		bool solver_ready_;
+		uint64 vertices_version_; // version of the mesh vertices the data were initialized with
 
 		std::shared_ptr<Attribute<Vec3>> vertex_position_init_;
 		std::shared_ptr<Attribute<Vec3>> vertex_diff_coord_;
@@ -201,7 +204,7 @@ private:
 			return true;
 		});
 		LAPL.setFromTriplets(LAPLcoeffs.begin(), LAPLcoeffs.end());
-		Eigen::MatrixXd vpos(nb_vertices, 3);
+		MatX vpos(nb_vertices, 3);
 		parallel_foreach_cell(*m, [&] (Vertex v) -> bool
 		{
 			const Vec3& pv = value<Vec3>(*m, p.vertex_position_, v);
@@ -211,7 +214,7 @@ private:
 			vpos(vidx, 2) = pv[2];
 			return true;
 		});
-		Eigen::MatrixXd lapl(nb_vertices, 3);
+		MatX lapl(nb_vertices, 3);
 		lapl = LAPL * vpos;
 		parallel_foreach_cell(*m, [&] (Vertex v) -> bool
 		{
@@ -226,7 +229,7 @@ private:
 		// compute vertices bi-laplacian
 		Eigen::SparseMatrix<Scalar, Eigen::ColMajor> BILAPL(nb_vertices, nb_vertices);
 		BILAPL = LAPL * LAPL;
-		Eigen::MatrixXd bilapl(nb_vertices, 3);
+		MatX bilapl(nb_vertices, 3);
 		bilapl = BILAPL * vpos;
 		parallel_foreach_cell(*m, [&] (Vertex v) -> bool
 		{
@@ -240,6 +243,7 @@ private:
 
 		p.initialized_ = true;
 		p.solver_ready_ = false;
+		p.vertices_version_ = m->cells_version(Vertex::ORBIT);
 	}
 
 	void build_solver(MESH* m)
@@ -393,6 +397,14 @@ private:
 
 		if (!p.initialized_)
 			return;
+
+		// the differential coordinates and the solver are outdated by a change of the mesh vertices
+		if (p.vertices_version_ != m->cells_version(Vertex::ORBIT))
+		{
+			p.initialized_ = false;
+			p.solver_ready_ = false;
+			return;
+		}
 		
 		if (!p.solver_ready_)
 			build_solver(m);
@@ -447,7 +459,7 @@ private:
 
 		uint32 nb_vertices = p.working_cells_->template size<Vertex>();
 
-		Eigen::MatrixXd rdiff(nb_vertices, 3);
+		MatX rdiff(nb_vertices, 3);
 		parallel_foreach_cell(*p.working_cells_, [&] (Vertex v) -> bool
 		{
 			const Vec3& rdcv = value<Vec3>(*m, p.vertex_rotated_diff_coord_, v);
@@ -457,7 +469,7 @@ private:
 			rdiff(vidx, 2) = rdcv[2];
 			return true;
 		});
-		Eigen::MatrixXd rbdiff(nb_vertices, 3);
+		MatX rbdiff(nb_vertices, 3);
 		rbdiff = p.working_LAPL_ * rdiff;
 		parallel_foreach_cell(*p.working_cells_, [&] (Vertex v) -> bool
 		{
@@ -469,8 +481,8 @@ private:
 			return true;
 		});
 
-		Eigen::MatrixXd x(nb_vertices, 3);
-		Eigen::MatrixXd b(nb_vertices, 3);
+		MatX x(nb_vertices, 3);
+		MatX b(nb_vertices, 3);
 
 		parallel_foreach_cell(*p.working_cells_, [&] (Vertex v) -> bool
 		{
@@ -577,7 +589,7 @@ protected:
 			Parameters& p = parameters_[selected_mesh_];
 			
 			rendering::GLVec3d drag_pos = view->unproject(x, y, drag_z_);
-			Vec3 t = drag_pos - previous_drag_pos_;
+			Vec3 t = (drag_pos - previous_drag_pos_).cast<Scalar>();
 			p.selected_handle_vertices_set_->foreach_cell([&] (Vertex v)
 			{
 				value<Vec3>(*selected_mesh_, p.vertex_position_, v) += t;
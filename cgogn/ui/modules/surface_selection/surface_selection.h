@@ -123,7 +123,7 @@ public:
 				selected_edges_position.reserve(selected_edges_set_->size() * 2);
 				selected_edges_set_->foreach_cell([&] (Edge e)
 				{
-					std::vector<Vertex> vertices = incident_vertices(*mesh_, e);
+					auto vertices = incident_vertices(*mesh_, e);
 					selected_edges_position.push_back(value<Vec3>(*mesh_, vertex_position_, vertices[0]));
 					selected_edges_position.push_back(value<Vec3>(*mesh_, vertex_position_, vertices[1]));
 				});
@@ -249,8 +249,8 @@ protected:
 			{
 				rendering::GLVec3d near = view->unproject(x, y, 0.0);
 				rendering::GLVec3d far = view->unproject(x, y, 1.0);
-				Vec3 A{ near.x(), near.y(), near.z() };
-				Vec3 B{ far.x(), far.y(), far.z() };
+				Vec3 A = near.cast<Scalar>();
+				Vec3 B = far.cast<Scalar>();
 				
 				if (p.selecting_cell_ == VertexSelect && p.selected_vertices_set_)
 				{	
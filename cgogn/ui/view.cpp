@@ -184,8 +184,8 @@ void View::update_scene_bb()
 		geometry::Vec3 min, max;
 		for (uint32 i = 0; i < 3; ++i)
 		{
-			min[i] = std::numeric_limits<float64>::max();
-			max[i] = std::numeric_limits<float64>::lowest();
+			min[i] = std::numeric_limits<geometry::Scalar>::max();
+			max[i] = std::numeric_limits<geometry::Scalar>::lowest();
 		}
 		for (ProviderModule* m : linked_provider_modules_)
 		{
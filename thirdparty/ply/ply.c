@@ -152,7 +152,9 @@ PlyFile *ply_write(
 	plyfile = (PlyFile *) myalloc (sizeof (PlyFile));
 	plyfile->file_type = file_type;
 	plyfile->num_comments = 0;
+	plyfile->comments = NULL;
 	plyfile->num_obj_info = 0;
+	plyfile->obj_info = NULL;
 	plyfile->num_elem_types = nelems;
 	plyfile->version = 1.0;
 	plyfile->fp = fp;
@@ -167,6 +169,8 @@ PlyFile *ply_write(
 		elem->name = strdup (elem_names[i]);
 		elem->num = 0;
 		elem->nprops = 0;
+		elem->props = NULL;
+		elem->store_prop = NULL;
 	}
 
 	/* return pointer to the file descriptor */
@@ -633,6 +637,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 
 	plyfile = (PlyFile *) myalloc (sizeof (PlyFile));
 	plyfile->num_elem_types = 0;
+	plyfile->elems = NULL;
 	plyfile->comments = NULL;
 	plyfile->num_comments = 0;
 	plyfile->obj_info = NULL;
@@ -645,7 +650,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 
 	words = get_words (plyfile->fp, &nwords, &orig_line);
 	if (!words || !equal_strings (words[0], "ply"))
-		return (NULL);
+		goto bad_header;
 
 	while (words) {
 
@@ -653,7 +658,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 
 		if (equal_strings (words[0], "format")) {
 			if (nwords != 3)
-				return (NULL);
+				goto bad_header;
 			if (equal_strings (words[1], "ascii"))
 				plyfile->file_type = PLY_ASCII;
 			else if (equal_strings (words[1], "binary_big_endian"))
@@ -661,14 +666,22 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 			else if (equal_strings (words[1], "binary_little_endian"))
 				plyfile->file_type = PLY_BINARY_LE;
 			else
-				return (NULL);
+				goto bad_header;
 			plyfile->version = (float) atof (words[2]);
 			//      found_format = 1;
 		}
-		else if (equal_strings (words[0], "element"))
+		else if (equal_strings (words[0], "element")) {
+			if (nwords < 3)
+				goto bad_header;
 			add_element (plyfile, words, nwords);
-		else if (equal_strings (words[0], "property"))
+		}
+		else if (equal_strings (words[0], "property")) {
+			/* a property belongs to the last described element */
+			if (plyfile->num_elem_types == 0 || nwords < 3 ||
+					(equal_strings (words[1], "list") && nwords < 5))
+				goto bad_header;
 			add_property (plyfile, words, nwords);
+		}
 		else if (equal_strings (words[0], "comment"))
 			add_comment (plyfile, orig_line);
 		else if (equal_strings (words[0], "obj_info"))
@@ -681,6 +694,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 
 		words = get_words (plyfile->fp, &nwords, &orig_line);
 	}
+	free (words);
 
 
 	/* create tags for each property of each element, to be used */
@@ -706,6 +720,11 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 	/* return a pointer to the file's information */
 
 	return (plyfile);
+
+bad_header:
+	free (words);
+	free_ply (plyfile);
+	return (NULL);
 }
 
 
@@ -1728,6 +1747,7 @@ char **get_words(FILE *fp, int *nwords, char **orig_line)
 	/* read in a line */
 	result = fgets (str, BIG_STRING, fp);
 	if (result == NULL) {
+		free (words);
 		*nwords = 0;
 		*orig_line = NULL;
 		return (NULL);
@@ -2377,6 +2397,8 @@ void add_element (PlyFile *plyfile, char **words, int nwords)
 	elem->name = strdup (words[1]);
 	elem->num = atoi (words[2]);
 	elem->nprops = 0;
+	elem->props = NULL;
+	elem->store_prop = NULL;
 
 	/* make room for new element in the object's list of elements */
 	if (plyfile->num_elem_types == 0)
@@ -2580,9 +2602,17 @@ PlyFile *read_ply(FILE *fp)
 	PlyFile *ply;
 	int num_elems;
 	char **elem_names;
+	int i;
 
 	ply = ply_read (fp, &num_elems, &elem_names);
 
+	/* the names stay available in the elements of the file */
+	if (ply != NULL) {
+		for (i = 0; i < num_elems; i++)
+			free (elem_names[i]);
+		free (elem_names);
+	}
+
 	return (ply);
 }
 
@@ -2745,7 +2775,32 @@ Entry:
 
 void free_ply(PlyFile *plyfile)
 {
+	int i,j;
+	PlyElement *elem;
+
 	/* free up memory associated with the PLY file */
+
+	for (i = 0; i < plyfile->num_elem_types; i++) {
+		elem = plyfile->elems[i];
+		for (j = 0; j < elem->nprops; j++) {
+			free (elem->props[j]->name);
+			free (elem->props[j]);
+		}
+		free (elem->props);
+		free (elem->store_prop);
+		free (elem->name);
+		free (elem);
+	}
+	free (plyfile->elems);
+
+	for (i = 0; i < plyfile->num_comments; i++)
+		free (plyfile->comments[i]);
+	free (plyfile->comments);
+
+	for (i = 0; i < plyfile->num_obj_info; i++)
+		free (plyfile->obj_info[i]);
+	free (plyfile->obj_info);
+
 	free (plyfile);
 }
 